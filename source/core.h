@@ -16,8 +16,10 @@
 
 #if defined(_MSC_VER)
     #define BOH_DEBUG_BREAK() __debugbreak()
+    #define BOH_THREAD_LOCAL  __declspec(thread)
 #elif defined(__clang__)
     #define BOH_DEBUG_BREAK() __builtin_trap()
+    #define BOH_THREAD_LOCAL  _Thread_local
 #else
     #error Currently, only MSVC and Clang are supported
 #endif
@@ -13,7 +13,7 @@ void bohErrorsStateInit(void)
         return;
     }
 
-    pBohState = (bohErrorsState*)malloc(sizeof(bohErrorsState));
+    pBohState = (bohErrorsState*)bohMemAlloc(sizeof(bohErrorsState));
     BOH_ASSERT(pBohState);
 
     memset(pBohState, 0, sizeof(bohErrorsState));
@@ -22,6 +22,7 @@ void bohErrorsStateInit(void)
 
     pBohState->lexerErrorsOccurred = false;
     pBohState->parserErrorsOccurred = false;
+    pBohState->resolverErrorsOccurred = false;
     pBohState->interpErrorsOccurred = false;
 }
 
@@ -36,9 +37,10 @@ void bohErrorsStateDestroy(void)
 
     pBohState->lexerErrorsOccurred = false;
     pBohState->parserErrorsOccurred = false;
+    pBohState->resolverErrorsOccurred = false;
     pBohState->interpErrorsOccurred = false;
 
-    free(pBohState);
+    bohMemFree(pBohState);
     pBohState = NULL;
 }
 
@@ -88,6 +90,12 @@ void bohErrorsStatePushParserErrorGlobal(void)
 }
 
 
+void bohErrorsStatePushResolverErrorGlobal(void)
+{
+    bohErrorsStateGet()->resolverErrorsOccurred = true;
+}
+
+
 void bohErrorsStatePushInterpreterErrorGlobal(void)
 {
     bohErrorsStateGet()->interpErrorsOccurred = true;
@@ -106,6 +114,12 @@ bool bohErrorsStateHasParserErrorGlobal(void)
 }
 
 
+bool bohErrorsStateHasResolverErrorGlobal(void)
+{
+    return bohErrorsStateGet()->resolverErrorsOccurred;
+}
+
+
 bool bohErrorsStateHasInterpreterErrorGlobal(void)
 {
     return bohErrorsStateGet()->interpErrorsOccurred;
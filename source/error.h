@@ -13,6 +13,7 @@ typedef struct ErrorsState
 
     bool lexerErrorsOccurred;
     bool parserErrorsOccurred;
+    bool resolverErrorsOccurred;
     bool interpErrorsOccurred;
 } bohErrorsState;
 
@@ -30,11 +31,13 @@ const bohStringView* bohErrorsStateGerCurrProcessingFileGlobal(void);
 
 void bohErrorsStatePushLexerErrorGlobal(void);
 void bohErrorsStatePushParserErrorGlobal(void);
+void bohErrorsStatePushResolverErrorGlobal(void);
 void bohErrorsStatePushInterpreterErrorGlobal(void);
 
 
 bool bohErrorsStateHasLexerErrorGlobal(void);
 bool bohErrorsStateHasParserErrorGlobal(void);
+bool bohErrorsStateHasResolverErrorGlobal(void);
 bool bohErrorsStateHasInterpreterErrorGlobal(void);
 
 
@@ -4,21 +4,48 @@
 
 #include "interpreter.h"
 #include "parser/parser.h"
+#include "state/state.h"
 
 #include "types.h"
 #include "error.h"
 
+#include "utils/fmt/fmt.h"
+#include "utils/sys/atomic.h"
 
-#define BOH_INTERP_PRINT_ERROR(LINE, COLUMN, FMT, ...) \
-    bohErrorsStatePrintError(stderr, bohErrorsStateGerCurrProcessingFileGlobal(), LINE, COLUMN, "INTERPRETER ERROR", FMT, __VA_ARGS__)
 
-#define BOH_INTERP_EXPECT(COND, LINE, COLUMN, FMT, ...)         \
-    if (!(COND)) {                                              \
-        BOH_INTERP_PRINT_ERROR(LINE, COLUMN, FMT, __VA_ARGS__); \
-        bohErrorsStatePushInterpreterErrorGlobal();             \
+// Buffered print output goes first, so the error follows everything printed before it in the combined log
+#define BOH_INTERP_PRINT_ERROR(INTERP_PTR, LINE, COLUMN, FMT, ...)                                                              \
+    (bohOutputSync((INTERP_PTR)->pOutput),                                                                                     \
+    bohErrorsStatePrintError(stderr, bohErrorsStateGerCurrProcessingFileGlobal(), LINE, COLUMN, "INTERPRETER ERROR", FMT, __VA_ARGS__))
+
+#define BOH_INTERP_EXPECT(INTERP_PTR, COND, LINE, COLUMN, FMT, ...)         \
+    if (!(COND)) {                                                          \
+        BOH_INTERP_PRINT_ERROR(INTERP_PTR, LINE, COLUMN, FMT, __VA_ARGS__); \
+        bohErrorsStatePushInterpreterErrorGlobal();                         \
+    }
+
+// Runtime error aborts evaluation of the current expression, the whole statement is skipped after that
+#define BOH_INTERP_EXPECT_OR_RETURN(INTERP_PTR, COND, RET, LINE, COLUMN, FMT, ...)  \
+    if (!(COND)) {                                                                  \
+        BOH_INTERP_PRINT_ERROR(INTERP_PTR, LINE, COLUMN, FMT, __VA_ARGS__);         \
+        bohErrorsStatePushInterpreterErrorGlobal();                                 \
+        return RET;                                                                 \
     }
 
 
+#define BOH_INTERP_CALL_STACK_SIZE  (1024 * 1024)
+#define BOH_INTERP_SCRATCH_SIZE     (64 * 1024)
+// Same as malloc one, bohMem* blocks headers rely on it
+#define BOH_INTERP_SCRATCH_ALIGNMENT 16
+// Blocks count of every value heap size class slab, the heap grows by one slab of a class at a time
+#define BOH_INTERP_VALUE_HEAP_SLAB_CAPACITY 1024
+// Non-tail calls recurse on the native stack as well, the limit keeps it far from overflow
+#define BOH_INTERP_MAX_CALL_DEPTH   1024
+
+// Must be a power of two
+#define BOH_INTERP_BACK_EDGE_POLL_PERIOD 4096
+
+
 const char* bohExprInterpResultTypeToStr(bohExprInterpResultType type)
 {
     switch (type) {
@@ -437,6 +464,24 @@ bohExprInterpResult* bohExprInterpResultAssing(bohExprInterpResult* pDst, const
 }
 
 
+bohExprInterpResult* bohExprInterpResultShare(bohExprInterpResult* pDst, bohExprInterpResult* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    if (!bohExprInterpResultIsString(pSrc)) {
+        return bohExprInterpResultAssing(pDst, pSrc);
+    }
+
+    bohExprInterpResultDestroy(pDst);
+
+    pDst->type = pSrc->type;
+    bohBoharesStringShare(&pDst->string, &pSrc->string);
+
+    return pDst;
+}
+
+
 bohPrintStmtInterpResult bohPrintStmtInterpResultCreate(void)
 {
     bohPrintStmtInterpResult result = {0};
@@ -507,6 +552,109 @@ bohIfStmtInterpResult *bohIfStmtInterpResultAssign(bohIfStmtInterpResult *pDst,
 }
 
 
+static bool interpIsScratchMemory(const bohInterpreter* pInterp, const void* pMemory)
+{
+    const uint8_t* pBegin = pInterp->scratchStack.pMemory;
+    return (const uint8_t*)pMemory >= pBegin && (const uint8_t*)pMemory < pBegin + bohStackAllocatorGetCapacity(&pInterp->scratchStack);
+}
+
+
+static void* interpScratchAlloc(void* pUserData, size_t size)
+{
+    bohInterpreter* pInterp = (bohInterpreter*)pUserData;
+
+    if (!bohStackAllocatorCanAlloc(&pInterp->scratchStack, size, BOH_INTERP_SCRATCH_ALIGNMENT)) {
+        return pInterp->pPersistentAllocator->pAllocFunc(pInterp->pPersistentAllocator->pUserData, size);
+    }
+
+    return bohStackAllocatorAlloc(&pInterp->scratchStack, size, BOH_INTERP_SCRATCH_ALIGNMENT);
+}
+
+
+// The top block grows in place, it is the common case of a temporary string being appended to
+static void* interpScratchRealloc(void* pUserData, void* pMemory, size_t oldSize, size_t newSize)
+{
+    bohInterpreter* pInterp = (bohInterpreter*)pUserData;
+    bohStackAllocator* pScratch = &pInterp->scratchStack;
+
+    if (!interpIsScratchMemory(pInterp, pMemory)) {
+        return pInterp->pPersistentAllocator->pReallocFunc(pInterp->pPersistentAllocator->pUserData, pMemory, oldSize, newSize);
+    }
+
+    const size_t offset = (size_t)((uint8_t*)pMemory - pScratch->pMemory);
+    
+    if (offset + oldSize == bohStackAllocatorGetMarker(pScratch) && newSize <= bohStackAllocatorGetCapacity(pScratch) - offset) {
+        bohStackAllocatorFreeToMarker(pScratch, offset);
+        return bohStackAllocatorAlloc(pScratch, newSize, BOH_INTERP_SCRATCH_ALIGNMENT);
+    }
+
+    void* pNewMemory = interpScratchAlloc(pUserData, newSize);
+
+    if (pNewMemory) {
+        memcpy(pNewMemory, pMemory, oldSize < newSize ? oldSize : newSize);
+    }
+
+    return pNewMemory;
+}
+
+
+// Scratch blocks are released by the scope rewind
+static void interpScratchFree(void* pUserData, void* pMemory, size_t size)
+{
+    bohInterpreter* pInterp = (bohInterpreter*)pUserData;
+
+    if (!interpIsScratchMemory(pInterp, pMemory)) {
+        pInterp->pPersistentAllocator->pFreeFunc(pInterp->pPersistentAllocator->pUserData, pMemory, size);
+    }
+}
+
+
+typedef struct InterpScratchScope
+{
+    const bohAllocator* pPrevAllocator;
+    size_t marker;
+} bohInterpScratchScope;
+
+
+// Values created inside the scope must be destroyed before it ends
+static bohInterpScratchScope interpBeginScratchScope(bohInterpreter* pInterp)
+{
+    bohInterpScratchScope scope;
+    
+    scope.pPrevAllocator = bohMemSetAllocator(&pInterp->scratchAllocator);
+    scope.marker = bohStackAllocatorGetMarker(&pInterp->scratchStack);
+
+    return scope;
+}
+
+
+static void interpEndScratchScope(bohInterpreter* pInterp, const bohInterpScratchScope* pScope)
+{
+    bohStackAllocatorFreeToMarker(&pInterp->scratchStack, pScope->marker);
+    bohMemSetAllocator(pScope->pPrevAllocator);
+}
+
+
+// Assigned and returned values outlive the scope of their statement, so the parts they keep in the scratch memory
+// are copied to the persistent allocator. Nothing is copied if the scope hasn't allocated anything yet
+static void interpPromoteScratchValue(bohInterpreter* pInterp, const bohInterpScratchScope* pScope, bohExprInterpResult* pValue)
+{
+    if (!bohExprInterpResultIsString(pValue) || bohStackAllocatorGetMarker(&pInterp->scratchStack) == pScope->marker) {
+        return;
+    }
+
+    const bohAllocator* pScratchAllocator = bohMemSetAllocator(pInterp->pPersistentAllocator);
+    bohBoharesStringPromote(&pValue->string, pInterp->scratchStack.pMemory, bohStackAllocatorGetCapacity(&pInterp->scratchStack));
+    bohMemSetAllocator(pScratchAllocator);
+}
+
+
+static bool interpIsComparisonOperator(bohExprOperator op)
+{
+    return op == BOH_OP_GREATER || op == BOH_OP_LESS || op == BOH_OP_NOT_EQUAL || op == BOH_OP_GEQUAL || op == BOH_OP_LEQUAL || op == BOH_OP_EQUAL;
+}
+
+
 static bohStmtInterpResult interpCreateDummyStmtInterpResult(void)
 {
     bohStmtInterpResult result = {0};
@@ -514,27 +662,204 @@ static bohStmtInterpResult interpCreateDummyStmtInterpResult(void)
 }
 
 
-static bohExprInterpResult interpInterpretBinaryExpr(const bohExpr* pExpr/*, bohStackFrame* pStackFrame*/);
-static bohExprInterpResult interpInterpretUnaryExpr(const bohExpr* pExpr/*, bohStackFrame* pStackFrame*/);
+// Slot is bound by the resolver, so a variable access is an indexed load. Locals skip the frames chain walk
+static bohExprInterpResult* interpGetVariable(bohStackFrame* pFrame, const bohIdentifierExpr* pIdentifierExpr)
+{
+    BOH_ASSERT(pFrame);
+    BOH_ASSERT(bohIdentifierExprIsResolved(pIdentifierExpr));
+
+    const uint32_t slot = pIdentifierExpr->slot;
+
+    if (pIdentifierExpr->depth == 0) {
+        BOH_ASSERT(slot < pFrame->slotsCount);
+        return pFrame->pSlots + slot;
+    }
+
+    return bohStackFrameGetSlot(pFrame, pIdentifierExpr->depth, slot);
+}
+
+
+static bohExprInterpResult interpInterpretBinaryExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame);
+static bohExprInterpResult interpInterpretUnaryExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame);
+static bohExprInterpResult interpInterpretCallExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame);
+static bohExprInterpResult interpInterpretIndexExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame);
+static bohExprInterpResult interpInterpretExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame);
+
+
+static bohStmtInterpResult bohAstInterpretStmt(bohInterpreter* pInterp, const bohStmt* pStmt, bohStackFrame* pFrame);
+
+
+// Slots are taken from the call stack, there is no heap allocation per call
+static bohExprInterpResult* interpPushFrameSlots(bohInterpreter* pInterp, size_t slotsCount)
+{
+    BOH_ASSERT(pInterp);
+
+    if (slotsCount == 0) {
+        return NULL;
+    }
+
+    bohExprInterpResult* pSlots = BOH_STACK_ALLOCATOR_ALLOC_ARRAY(&pInterp->callStack, bohExprInterpResult, slotsCount);
+
+    for (size_t i = 0; i < slotsCount; ++i) {
+        pSlots[i] = bohExprInterpResultCreate();
+    }
+
+    return pSlots;
+}
+
+
+static const bohFuncStmt* interpGetCallee(const bohExpr* pExpr)
+{
+    const bohStmt* pFuncStmt = bohCallExprGetFuncStmt(bohExprGetCallExpr(pExpr));
+    BOH_ASSERT_MSG(pFuncStmt, "Call is not bound to a function by the resolver");
+
+    return bohStmtGetFunc(pFuncStmt);
+}
+
+
+// Evaluates the call arguments in the caller frame straight into the first slots of the callee frame.
+// Returns false and releases everything it has pushed if evaluation fails
+static bool interpPushCallArgs(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame, bohExprInterpResult** ppSlots)
+{
+    BOH_ASSERT(pInterp);
+    BOH_ASSERT(ppSlots);
+
+    const bohCallExpr* pCallExpr = bohExprGetCallExpr(pExpr);
+    const bohFuncStmt* pFuncStmt = interpGetCallee(pExpr);
+
+    const size_t slotsCount = bohFuncStmtGetFrameSlotsCount(pFuncStmt);
+    const bohStringView* pName = bohFuncStmtGetName(pFuncStmt);
+
+    *ppSlots = NULL;
+
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, pInterp->callDepth < BOH_INTERP_MAX_CALL_DEPTH 
+        && BOH_STACK_ALLOCATOR_CAN_ALLOC_ARRAY(&pInterp->callStack, bohExprInterpResult, slotsCount), false, 
+        bohExprGetLine(pExpr), bohExprGetColumn(pExpr), "call stack overflow in call of: %.*s", (int)bohStringViewGetSize(pName), bohStringViewGetData(pName));
+
+    const size_t marker = bohStackAllocatorGetMarker(&pInterp->callStack);
+    bohExprInterpResult* pSlots = interpPushFrameSlots(pInterp, slotsCount);
+
+    const size_t argsCount = bohCallExprGetArgsCount(pCallExpr);
+    BOH_ASSERT(argsCount <= slotsCount);
+
+    for (size_t i = 0; i < argsCount && !bohErrorsStateHasInterpreterErrorGlobal(); ++i) {
+        pSlots[i] = interpInterpretExpr(pInterp, bohCallExprGetArgAt(pCallExpr, i), pFrame);
+    }
+
+    if (bohErrorsStateHasInterpreterErrorGlobal()) {
+        bohStackFrame argsFrame = bohStackFrameCreate(NULL, pSlots, slotsCount);
+        bohStackFrameDestroy(&argsFrame);
+
+        bohStackAllocatorFreeToMarker(&pInterp->callStack, marker);
+        return false;
+    }
+
+    *ppSlots = pSlots;
+    return true;
+}
+
+
+static bohExprInterpResult interpInterpretCallExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pInterp);
+    BOH_ASSERT(bohExprIsCallExpr(pExpr));
+
+    bohExprInterpResult result = bohExprInterpResultCreate();
+
+    if (bohErrorsStateHasInterpreterErrorGlobal()) {
+        return result;
+    }
+
+    const size_t marker = bohStackAllocatorGetMarker(&pInterp->callStack);
+
+    // Arguments and callee locals may live past the statement which made the call
+    const bohAllocator* pPrevAllocator = bohMemSetAllocator(pInterp->pPersistentAllocator);
+
+    const bohFuncStmt* pFuncStmt = interpGetCallee(pExpr);
+    bohExprInterpResult* pSlots = NULL;
+    
+    if (!interpPushCallArgs(pInterp, pExpr, pFrame, &pSlots)) {
+        bohMemSetAllocator(pPrevAllocator);
+        return result;
+    }
+
+    ++pInterp->callDepth;
+
+    while (true) {
+        bohStackFrame calleeFrame = bohStackFrameCreate(pInterp->pGlobalFrame, pSlots, bohFuncStmtGetFrameSlotsCount(pFuncStmt));
+        
+        const size_t stmtsCount = bohFuncStmtGetBodyStmtsCount(pFuncStmt);
+
+        for (size_t i = 0; i < stmtsCount && !pInterp->isReturning && !bohErrorsStateHasInterpreterErrorGlobal(); ++i) {
+            bohAstInterpretStmt(pInterp, bohFuncStmtGetBodyStmtAt(pFuncStmt, i), &calleeFrame);
+        }
+
+        bohStackFrameDestroy(&calleeFrame);
 
+        if (!pInterp->pTailCallFuncStmt) {
+            break;
+        }
 
-static bohExprInterpResult interpInterpretExpr(const bohExpr* pExpr/*, bohStackFrame* pStackFrame*/)
+        // Tail call: the callee arguments lie right above the finished frame, move them down to its base and run again
+        pFuncStmt = pInterp->pTailCallFuncStmt;
+        
+        const bohExprInterpResult* pTailCallSlots = pInterp->pTailCallSlots;
+        const size_t slotsCount = bohFuncStmtGetFrameSlotsCount(pFuncStmt);
+
+        pInterp->pTailCallFuncStmt = NULL;
+        pInterp->pTailCallSlots = NULL;
+        pInterp->isReturning = false;
+
+        bohStackAllocatorFreeToMarker(&pInterp->callStack, marker);
+        
+        pSlots = slotsCount > 0 ? BOH_STACK_ALLOCATOR_ALLOC_ARRAY(&pInterp->callStack, bohExprInterpResult, slotsCount) : NULL;
+        
+        if (pSlots) {
+            memmove(pSlots, pTailCallSlots, slotsCount * sizeof(bohExprInterpResult));
+        }
+    }
+
+    --pInterp->callDepth;
+    bohStackAllocatorFreeToMarker(&pInterp->callStack, marker);
+
+    bohMemSetAllocator(pPrevAllocator);
+
+    // Function without return statement returns 0
+    if (pInterp->isReturning) {
+        bohExprInterpResultMove(&result, &pInterp->returnValue);
+        pInterp->isReturning = false;
+    }
+
+    return result;
+}
+
+
+static bohExprInterpResult interpInterpretExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame)
 {
     BOH_ASSERT(pExpr);
 
     if (bohExprIsBinaryExpr(pExpr)) {
-        return interpInterpretBinaryExpr(pExpr/*, pStackFrame*/);
+        return interpInterpretBinaryExpr(pInterp, pExpr, pFrame);
     } else if (bohExprIsUnaryExpr(pExpr)) {
-        return interpInterpretUnaryExpr(pExpr/*, pStackFrame*/);
+        return interpInterpretUnaryExpr(pInterp, pExpr, pFrame);
+    } else if (bohExprIsIdentifierExpr(pExpr)) {
+        bohExprInterpResult result = bohExprInterpResultCreate();
+        bohExprInterpResultShare(&result, interpGetVariable(pFrame, bohExprGetIdentifierExpr(pExpr)));
+
+        return result;
+    } else if (bohExprIsCallExpr(pExpr)) {
+        return interpInterpretCallExpr(pInterp, pExpr, pFrame);
+    } else if (bohExprIsIndexExpr(pExpr)) {
+        return interpInterpretIndexExpr(pInterp, pExpr, pFrame);
     }
 
     if (bohExprIsValueExpr(pExpr)) {
-        const bohValueExpr* pValueExpr = bohExprGetValueExpr(pExpr);
+        const bohConstant* pConstant = bohAstGetConstant(pInterp->pAst, bohExprGetValueExpr(pExpr));
 
-        if (bohValueExprIsNumber(pValueExpr)) {
-            return bohExprInterpResultCreateNumberPtr(bohValueExprGetNumber(pValueExpr));
-        } else if (bohValueExprIsString(pValueExpr)) {
-            return bohExprInterpResultCreateStringBoharesStringPtr(bohValueExprGetString(pValueExpr));
+        if (bohConstantIsNumber(pConstant)) {
+            return bohExprInterpResultCreateNumberPtr(bohConstantGetNumber(pConstant));
+        } else if (bohConstantIsString(pConstant)) {
+            return bohExprInterpResultCreateStringBoharesStringPtr(bohConstantGetString(pConstant));
         }
     }
 
@@ -543,17 +868,107 @@ static bohExprInterpResult interpInterpretExpr(const bohExpr* pExpr/*, bohStackF
 }
 
 
-static bohExprInterpResult interpInterpretUnaryExpr(const bohExpr* pExpr/*, bohStackFrame* pStackFrame*/)
+static bool interpEvalIndex(bohInterpreter* pInterp, const bohExpr* pIndexExpr, bohStackFrame* pFrame, int64_t* pValue)
+{
+    BOH_ASSERT(pValue);
+
+    bohExprInterpResult index = interpInterpretExpr(pInterp, pIndexExpr, pFrame);
+
+    if (bohErrorsStateHasInterpreterErrorGlobal()) {
+        bohExprInterpResultDestroy(&index);
+        return false;
+    }
+
+    const bool isInteger = bohExprInterpResultIsNumberI64(&index);
+    *pValue = isInteger ? index.number.i64 : 0;
+
+    bohExprInterpResultDestroy(&index);
+
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, isInteger, false, bohExprGetLine(pIndexExpr), bohExprGetColumn(pIndexExpr), 
+        "index must be an integer");
+
+    return true;
+}
+
+
+// Slice shares the indexed string buffer, so neither indexing nor slicing copies long strings
+static bohExprInterpResult interpInterpretIndexExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(bohExprIsIndexExpr(pExpr));
+
+    const bohIndexExpr* pIndexExpr = bohExprGetIndexExpr(pExpr);
+
+    const bohExpr* pBeginExpr = bohIndexExprGetBeginExpr(pIndexExpr);
+    const bohExpr* pEndExpr = bohIndexExprGetEndExpr(pIndexExpr);
+    const bool isSlice = bohIndexExprIsSlice(pIndexExpr);
+
+    const bohExprInterpResult errorResult = bohExprInterpResultCreateNumberI64(0);
+
+    bohExprInterpResult object = interpInterpretExpr(pInterp, bohIndexExprGetObjectExpr(pIndexExpr), pFrame);
+
+    if (bohErrorsStateHasInterpreterErrorGlobal()) {
+        bohExprInterpResultDestroy(&object);
+        return errorResult;
+    }
+
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, bohExprInterpResultIsString(&object), errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+        "can't index %s", bohExprInterpResultTypeToStr(object.type));
+
+    const int64_t size = (int64_t)bohBoharesStringGetSize(&object.string);
+
+    int64_t begin = 0;
+    int64_t end = size;
+
+    if ((pBeginExpr && !interpEvalIndex(pInterp, pBeginExpr, pFrame, &begin)) || (pEndExpr && !interpEvalIndex(pInterp, pEndExpr, pFrame, &end))) {
+        bohExprInterpResultDestroy(&object);
+        return errorResult;
+    }
+
+    if (!isSlice) {
+        const bool isInRange = begin >= 0 && begin < size;
+
+        if (!isInRange) {
+            bohExprInterpResultDestroy(&object);
+        }
+
+        BOH_INTERP_EXPECT_OR_RETURN(pInterp, isInRange, errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+            "index out of range: %lld with size %lld", (long long)begin, (long long)size);
+
+        end = begin + 1;
+    } else {
+        const bool isInRange = begin >= 0 && begin <= end && end <= size;
+
+        if (!isInRange) {
+            bohExprInterpResultDestroy(&object);
+        }
+
+        BOH_INTERP_EXPECT_OR_RETURN(pInterp, isInRange, errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+            "slice bounds out of range: [%lld..%lld] with size %lld", (long long)begin, (long long)end, (long long)size);
+    }
+
+    bohBoharesString slice = bohBoharesStringSlice(&object.string, (size_t)begin, (size_t)end);
+    bohExprInterpResultDestroy(&object);
+
+    return bohExprInterpResultCreateStringBoharesStringRValPtr(&slice);
+}
+
+
+static bohExprInterpResult interpInterpretUnaryExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame)
 {
     BOH_ASSERT(bohExprIsUnaryExpr(pExpr));
 
     const bohUnaryExpr* pUnaryExpr = bohExprGetUnaryExpr(pExpr);
 
     const bohExpr* pOperandExpr = bohUnaryExprGetExpr(pUnaryExpr);
-    const bohExprInterpResult result = interpInterpretExpr(pOperandExpr/*, pStackFrame*/);
+    bohExprInterpResult result = interpInterpretExpr(pInterp, pOperandExpr, pFrame);
     
+    const bool isResultNumber = bohExprInterpResultIsNumber(&result);
+    if (!isResultNumber) {
+        bohExprInterpResultDestroy(&result);
+    }
+
     const char* pOperatorStr = bohParsExprOperatorToStr(pUnaryExpr->op);
-    BOH_INTERP_EXPECT(bohExprInterpResultIsNumber(&result), bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, isResultNumber, result, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
         "can't use unary %s operator with non numbers types", pOperatorStr);
 
     const bohNumber* pResultNumber = bohExprInterpResultGetNumber(&result);
@@ -563,7 +978,7 @@ static bohExprInterpResult interpInterpretUnaryExpr(const bohExpr* pExpr/*, bohS
         case BOH_OP_MINUS:          return bohExprInterpResultCreateNumber(bohNumberGetOpposite(pResultNumber));
         case BOH_OP_NOT:            return bohExprInterpResultCreateNumber(bohNumberGetNegation(pResultNumber));
         case BOH_OP_BITWISE_NOT:
-            BOH_INTERP_EXPECT(bohNumberIsI64(pResultNumber), bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+            BOH_INTERP_EXPECT_OR_RETURN(pInterp, bohNumberIsI64(pResultNumber), result, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
                 "can't use ~ operator with non integral type");
             return bohExprInterpResultCreateNumber(bohNumberGetBitwiseNegation(pResultNumber));
     
@@ -574,13 +989,13 @@ static bohExprInterpResult interpInterpretUnaryExpr(const bohExpr* pExpr/*, bohS
 }
 
 
-static bohExprInterpResult interpInterpretLogicalAnd(const bohExpr* pExpr/*, bohStackFrame* pStackFrame*/)
+static bohExprInterpResult interpInterpretLogicalAnd(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame)
 {
     BOH_ASSERT(bohExprIsBinaryExpr(pExpr));
     
     const bohBinaryExpr* pBinaryExpr = bohExprGetBinaryExpr(pExpr);
 
-    const bohExprInterpResult leftInterpResult = interpInterpretExpr(bohBinaryExprGetLeftExpr(pBinaryExpr)/*, pStackFrame*/);
+    bohExprInterpResult leftInterpResult = interpInterpretExpr(pInterp, bohBinaryExprGetLeftExpr(pBinaryExpr), pFrame);
 
     BOH_ASSERT_MSG((bohExprInterpResultIsNumber(&leftInterpResult) || bohExprInterpResultIsString(&leftInterpResult)),
         "Invalid left bohExprInterpResult type");
@@ -592,7 +1007,9 @@ static bohExprInterpResult interpInterpretLogicalAnd(const bohExpr* pExpr/*, boh
         return bohExprInterpResultCreateNumberI64(false);
     }
 
-    const bohExprInterpResult rightInterpResult = interpInterpretExpr(bohBinaryExprGetRightExpr(pBinaryExpr)/*, pStackFrame*/);
+    bohExprInterpResultDestroy(&leftInterpResult);
+
+    bohExprInterpResult rightInterpResult = interpInterpretExpr(pInterp, bohBinaryExprGetRightExpr(pBinaryExpr), pFrame);
 
     BOH_ASSERT_MSG((bohExprInterpResultIsNumber(&rightInterpResult) || bohExprInterpResultIsString(&rightInterpResult)),
         "Invalid right bohExprInterpResult type");
@@ -604,17 +1021,18 @@ static bohExprInterpResult interpInterpretLogicalAnd(const bohExpr* pExpr/*, boh
         return bohExprInterpResultCreateNumberI64(!bohNumberIsZero(pRightNumber));
     }
 
+    bohExprInterpResultDestroy(&rightInterpResult);
     return bohExprInterpResultCreateNumberI64(true);
 }
 
 
-static bohExprInterpResult interpInterpretLogicalOr(const bohExpr* pExpr/*, bohStackFrame* pStackFrame*/)
+static bohExprInterpResult interpInterpretLogicalOr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame)
 {
     BOH_ASSERT(bohExprIsBinaryExpr(pExpr));
     
     const bohBinaryExpr* pBinaryExpr = bohExprGetBinaryExpr(pExpr);
 
-    const bohExprInterpResult leftInterpResult = interpInterpretExpr(bohBinaryExprGetLeftExpr(pBinaryExpr)/*, pStackFrame*/);
+    bohExprInterpResult leftInterpResult = interpInterpretExpr(pInterp, bohBinaryExprGetLeftExpr(pBinaryExpr), pFrame);
 
     BOH_ASSERT_MSG((bohExprInterpResultIsNumber(&leftInterpResult) || bohExprInterpResultIsString(&leftInterpResult)),
         "Invalid left bohExprInterpResult type");
@@ -626,7 +1044,9 @@ static bohExprInterpResult interpInterpretLogicalOr(const bohExpr* pExpr/*, bohS
         return bohExprInterpResultCreateNumberI64(true);
     }
 
-    const bohExprInterpResult rightInterpResult = interpInterpretExpr(bohBinaryExprGetRightExpr(pBinaryExpr)/*, pStackFrame*/);
+    bohExprInterpResultDestroy(&leftInterpResult);
+
+    bohExprInterpResult rightInterpResult = interpInterpretExpr(pInterp, bohBinaryExprGetRightExpr(pBinaryExpr), pFrame);
     
     BOH_ASSERT_MSG((bohExprInterpResultIsNumber(&rightInterpResult) || bohExprInterpResultIsString(&rightInterpResult)),
         "Invalid right bohExprInterpResult type");
@@ -638,24 +1058,24 @@ static bohExprInterpResult interpInterpretLogicalOr(const bohExpr* pExpr/*, bohS
         return bohExprInterpResultCreateNumberI64(!bohNumberIsZero(pRightNumber));
     }
 
+    bohExprInterpResultDestroy(&rightInterpResult);
     return bohExprInterpResultCreateNumberI64(true);
 }
 
 
-static bohExprInterpResult interpInterpretBinaryExpr(const bohExpr* pExpr/*, bohStackFrame* pStackFrame*/)
+// Operands are owned by the caller
+static bohExprInterpResult interpInterpretBinaryOperation(bohInterpreter* pInterp, const bohExpr* pExpr, const bohExprInterpResult* pLeft, const bohExprInterpResult* pRight)
 {
     BOH_ASSERT(bohExprIsBinaryExpr(pExpr));
+    BOH_ASSERT(pLeft);
+    BOH_ASSERT(pRight);
     
     const bohBinaryExpr* pBinaryExpr = bohExprGetBinaryExpr(pExpr);
 
-    if (pBinaryExpr->op == BOH_OP_AND) {
-        return interpInterpretLogicalAnd(pExpr/*, pStackFrame*/);
-    } else if (pBinaryExpr->op == BOH_OP_OR) {
-        return interpInterpretLogicalOr(pExpr/*, pStackFrame*/);
-    }
-
-    const bohExprInterpResult left = interpInterpretExpr(bohBinaryExprGetLeftExpr(pBinaryExpr)/*, pStackFrame*/);
-    const bohExprInterpResult right = interpInterpretExpr(bohBinaryExprGetRightExpr(pBinaryExpr)/*, pStackFrame*/);
+    const bohExprInterpResult left = *pLeft;
+    const bohExprInterpResult right = *pRight;
+    
+    const bohExprInterpResult errorResult = bohExprInterpResultCreateNumberI64(0);
 
     BOH_ASSERT_MSG((bohExprInterpResultIsNumber(&left) || bohExprInterpResultIsString(&left)),
         "Invalid left bohExprInterpResult type");
@@ -670,7 +1090,7 @@ static bohExprInterpResult interpInterpretBinaryExpr(const bohExpr* pExpr/*, boh
 
     const char* pOperatorStr = bohParsExprOperatorToStr(pBinaryExpr->op);
 
-    BOH_INTERP_EXPECT(left.type == right.type, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, left.type == right.type, errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
         "invalid operation: %s %s %s", 
         bohExprInterpResultTypeToStr(left.type), 
         pOperatorStr, 
@@ -681,8 +1101,8 @@ static bohExprInterpResult interpInterpretBinaryExpr(const bohExpr* pExpr/*, boh
             if (pLeftNumber) {
                 return bohExprInterpResultCreateNumber(bohNumberAdd(pLeftNumber, pRightNumber));
             } else if (pLeftStr) {
-                const bohBoharesString finalString = bohBoharesStringAdd(pLeftStr, pRightStr);
-                return bohExprInterpResultCreateStringBoharesStringPtr(&finalString);
+                bohBoharesString finalString = bohBoharesStringAdd(pLeftStr, pRightStr);
+                return bohExprInterpResultCreateStringBoharesStringRValPtr(&finalString);
             }
             break;
         case BOH_OP_GREATER:
@@ -731,13 +1151,13 @@ static bohExprInterpResult interpInterpretBinaryExpr(const bohExpr* pExpr/*, boh
             break;
     }
 
-    BOH_INTERP_EXPECT(bohExprInterpResultIsNumber(&left), bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, bohExprInterpResultIsNumber(&left), errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
         "can't use binary %s operator with non numbers types", pOperatorStr);
-    BOH_INTERP_EXPECT(bohExprInterpResultIsNumber(&right), bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, bohExprInterpResultIsNumber(&right), errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
         "can't use binary %s operator with non numbers types", pOperatorStr);
 
     if (bohParsIsBitwiseExprOperator(pBinaryExpr->op)) {
-        BOH_INTERP_EXPECT(bohNumberIsI64(pLeftNumber) && bohNumberIsI64(pRightNumber), bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+        BOH_INTERP_EXPECT_OR_RETURN(pInterp, bohNumberIsI64(pLeftNumber) && bohNumberIsI64(pRightNumber), errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
             "can't use %s bitwise operator with non integral types", pOperatorStr);
     }
 
@@ -747,10 +1167,10 @@ static bohExprInterpResult interpInterpretBinaryExpr(const bohExpr* pExpr/*, boh
         case BOH_OP_MULT:
             return bohExprInterpResultCreateNumber(bohNumberMult(pLeftNumber, pRightNumber));
         case BOH_OP_DIV:
-            BOH_INTERP_EXPECT(!bohNumberIsZero(pRightNumber), bohExprGetLine(pExpr), bohExprGetColumn(pExpr), "right operand of / is zero");
+            BOH_INTERP_EXPECT_OR_RETURN(pInterp, !bohNumberIsZero(pRightNumber), errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), "right operand of / is zero");
             return bohExprInterpResultCreateNumber(bohNumberDiv(pLeftNumber, pRightNumber));
         case BOH_OP_MOD:
-            BOH_INTERP_EXPECT(!bohNumberIsZero(pRightNumber), bohExprGetLine(pExpr), bohExprGetColumn(pExpr), "right operand of % is zero");
+            BOH_INTERP_EXPECT_OR_RETURN(pInterp, !bohNumberIsZero(pRightNumber), errorResult, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), "right operand of %% is zero");
             return bohExprInterpResultCreateNumber(bohNumberMod(pLeftNumber, pRightNumber));
         case BOH_OP_BITWISE_AND:
             return bohExprInterpResultCreateNumber(bohNumberBitwiseAnd(pLeftNumber, pRightNumber));
@@ -769,84 +1189,613 @@ static bohExprInterpResult interpInterpretBinaryExpr(const bohExpr* pExpr/*, boh
 }
 
 
-static bohStmtInterpResult bohAstInterpretStmt(const bohStmt* pStmt/*, bohStackFrame* pStackFrame*/);
+static bohExprInterpResult interpInterpretBinaryExpr(bohInterpreter* pInterp, const bohExpr* pExpr, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(bohExprIsBinaryExpr(pExpr));
+    
+    const bohBinaryExpr* pBinaryExpr = bohExprGetBinaryExpr(pExpr);
+
+    if (pBinaryExpr->op == BOH_OP_AND) {
+        return interpInterpretLogicalAnd(pInterp, pExpr, pFrame);
+    } else if (pBinaryExpr->op == BOH_OP_OR) {
+        return interpInterpretLogicalOr(pInterp, pExpr, pFrame);
+    }
+
+    // Comparison result is a number, so its operands are consumed right here
+    if (interpIsComparisonOperator(pBinaryExpr->op)) {
+        const bohInterpScratchScope scratchScope = interpBeginScratchScope(pInterp);
+
+        bohExprInterpResult left = interpInterpretExpr(pInterp, bohBinaryExprGetLeftExpr(pBinaryExpr), pFrame);
+        bohExprInterpResult right = interpInterpretExpr(pInterp, bohBinaryExprGetRightExpr(pBinaryExpr), pFrame);
+
+        const bohExprInterpResult result = interpInterpretBinaryOperation(pInterp, pExpr, &left, &right);
+
+        bohExprInterpResultDestroy(&left);
+        bohExprInterpResultDestroy(&right);
+
+        interpEndScratchScope(pInterp, &scratchScope);
+
+        return result;
+    }
+
+    bohExprInterpResult left = interpInterpretExpr(pInterp, bohBinaryExprGetLeftExpr(pBinaryExpr), pFrame);
+    bohExprInterpResult right = interpInterpretExpr(pInterp, bohBinaryExprGetRightExpr(pBinaryExpr), pFrame);
+
+    // Operands are temporaries, so they are moved into the concatenation result instead of being copied
+    if (pBinaryExpr->op == BOH_OP_PLUS && bohExprInterpResultIsString(&left) && bohExprInterpResultIsString(&right)) {
+        bohBoharesString finalString = bohBoharesStringAddRValPtr(&left.string, &right.string);
+        return bohExprInterpResultCreateStringBoharesStringRValPtr(&finalString);
+    }
+
+    const bohExprInterpResult result = interpInterpretBinaryOperation(pInterp, pExpr, &left, &right);
+
+    bohExprInterpResultDestroy(&left);
+    bohExprInterpResultDestroy(&right);
+
+    return result;
+}
 
 
-static bohStmtInterpResult bohAstInterpretPrintStmt(const bohPrintStmt* pPrintStmt/*, bohStackFrame* pStackFrame*/)
+static bohStmtInterpResult bohAstInterpretPrintStmt(bohInterpreter* pInterp, const bohPrintStmt* pPrintStmt, bohStackFrame* pFrame)
 {
+    BOH_ASSERT(pInterp);
     BOH_ASSERT(pPrintStmt);
 
-    bohExprInterpResult argInterpResult = interpInterpretExpr(pPrintStmt->pArgExpr/*, pStackFrame*/);
+    const bohInterpScratchScope scratchScope = interpBeginScratchScope(pInterp);
+
+    bohExprInterpResult argInterpResult = interpInterpretExpr(pInterp, pPrintStmt->pArgExpr, pFrame);
     bohExprInterpResult* pArgInterpResult = &argInterpResult;
 
-    if (bohExprInterpResultIsNumber(pArgInterpResult)) {
+    if (bohErrorsStateHasInterpreterErrorGlobal()) {
+        // Argument evaluation failed, nothing to print
+    } else if (bohExprInterpResultIsNumber(pArgInterpResult)) {
         const bohNumber* pNumber = bohExprInterpResultGetNumber(pArgInterpResult);
 
-        if (bohNumberIsI64(pNumber)) {
-            fprintf_s(stdout, "%d", bohNumberGetI64(pNumber));
-        } else {
-            fprintf_s(stdout, "%f", bohNumberGetF64(pNumber));
-        }
+        char* pNumberStr = bohOutputReserve(pInterp->pOutput, BOH_FMT_NUMBER_MAX_SIZE);
+        const size_t numberStrSize = bohNumberIsI64(pNumber) ? 
+            bohFmtI64(pNumberStr, bohNumberGetI64(pNumber)) : bohFmtF64(pNumberStr, bohNumberGetF64(pNumber));
+        
+        bohOutputCommit(pInterp->pOutput, numberStrSize);
     } else if (bohExprInterpResultIsString(pArgInterpResult)) {
         const bohBoharesString* pBohString = bohExprInterpResultGetString(pArgInterpResult);
-
-        if (bohBoharesStringIsString(pBohString)) {
-            const bohString* pString = bohBoharesStringGetString(pBohString);
-            fprintf_s(stdout, "%s", bohStringGetCStr(pString));
-        } else {
-            const bohStringView* pStrView = bohBoharesStringGetStringView(pBohString);
-            fprintf_s(stdout, "%.*s", bohStringViewGetSize(pStrView), bohStringViewGetData(pStrView));
-        }
+        bohOutputWrite(pInterp->pOutput, bohBoharesStringGetData(pBohString), bohBoharesStringGetSize(pBohString));
     } else {
         BOH_ASSERT_FAIL("Invalid raw expr stmt interp result value type");
     }
 
     bohExprInterpResultDestroy(pArgInterpResult);
 
+    interpEndScratchScope(pInterp, &scratchScope);
+
     bohPrintStmtInterpResult interpResult = bohPrintStmtInterpResultCreate();
     return bohStmtInterpResultCreatePrintStmtMove(&interpResult);
 }
 
 
-static bohStmtInterpResult bohAstInterpretIfStmt(const bohIfStmt* pIfStmt/*, bohStackFrame* pStackFrame*/)
+// Condition value is consumed right away, so all of its temporaries live in the scratch memory
+static bool interpEvalCondition(bohInterpreter* pInterp, const bohExpr* pCondExpr, bohStackFrame* pFrame)
+{
+    const bohInterpScratchScope scratchScope = interpBeginScratchScope(pInterp);
+
+    bohExprInterpResult condInterpResult = interpInterpretExpr(pInterp, pCondExpr, pFrame);
+    
+    const bool isTrue = !bohErrorsStateHasInterpreterErrorGlobal() && bohExprInterpResultToBool(&condInterpResult);
+    bohExprInterpResultDestroy(&condInterpResult);
+
+    interpEndScratchScope(pInterp, &scratchScope);
+
+    return isTrue;
+}
+
+
+static bohStmtInterpResult bohAstInterpretIfStmt(bohInterpreter* pInterp, const bohIfStmt* pIfStmt, bohStackFrame* pFrame)
 {
     BOH_ASSERT(pIfStmt);
 
-    bohExprInterpResult argInterpResult = interpInterpretExpr(pIfStmt->pCondExpr/*, pStackFrame*/);
-    bohExprInterpResult* pArgInterpResult = &argInterpResult;
+    const bool isTrue = interpEvalCondition(pInterp, pIfStmt->pCondExpr, pFrame);
 
-    if (bohExprInterpResultToBool(pArgInterpResult)) {
+    if (bohErrorsStateHasInterpreterErrorGlobal()) {
+        // Condition evaluation failed, no branch is executed
+    } else if (isTrue) {
         const size_t thenStmtCount = bohIfStmtGetThenStmtsCount(pIfStmt);
 
-        for (size_t i = 0; i < thenStmtCount; ++i) {
+        for (size_t i = 0; i < thenStmtCount && !pInterp->isReturning && !bohErrorsStateHasInterpreterErrorGlobal(); ++i) {
             const bohStmt* pThenStmt = bohIfStmtGetThenStmtAt(pIfStmt, i);
-            bohAstInterpretStmt(pThenStmt/*, pStackFrame*/);
+            bohAstInterpretStmt(pInterp, pThenStmt, pFrame);
         }
     } else {
         const size_t elseStmtCount = bohIfStmtGetElseStmtsCount(pIfStmt);
 
-        for (size_t i = 0; i < elseStmtCount; ++i) {
+        for (size_t i = 0; i < elseStmtCount && !pInterp->isReturning && !bohErrorsStateHasInterpreterErrorGlobal(); ++i) {
             const bohStmt* pElseStmt = bohIfStmtGetElseStmtAt(pIfStmt, i);
-            bohAstInterpretStmt(pElseStmt/*, pStackFrame*/);
+            bohAstInterpretStmt(pInterp, pElseStmt, pFrame);
         }
     }
-    
-    bohExprInterpResultDestroy(pArgInterpResult);
 
     bohIfStmtInterpResult interpResult = bohIfStmtInterpResultCreate();
     return bohStmtInterpResultCreateIfStmtMove(&interpResult);
 }
 
 
-static bohStmtInterpResult bohAstInterpretStmt(const bohStmt* pStmt/*, bohStackFrame* pStackFrame*/)
+// Variable is updated in place, no temporary result is created. String "+=" appends into the spare capacity
+// of the variable string, so building a string in a loop takes linear time. Returns false on runtime error
+static bool interpInterpretCompoundAssignment(bohInterpreter* pInterp, const bohAssignmentStmt* pAssignStmt, bohExprInterpResult* pTarget, const bohExprInterpResult* pValue)
+{
+    BOH_ASSERT(pAssignStmt);
+    BOH_ASSERT(pTarget);
+    BOH_ASSERT(pValue);
+
+    const bohExpr* pLeftExpr = bohAssignmentStmtGetLeftExpr(pAssignStmt);
+    const bohLineNmb line = bohExprGetLine(pLeftExpr);
+    const bohColumnNmb column = bohExprGetColumn(pLeftExpr);
+
+    const bohExprOperator op = bohAssignmentStmtGetOperator(pAssignStmt);
+    const char* pOperatorStr = bohParsExprOperatorToStr(op);
+
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, pTarget->type == pValue->type, false, line, column, 
+        "invalid operation: %s %s %s", 
+        bohExprInterpResultTypeToStr(pTarget->type), 
+        pOperatorStr, 
+        bohExprInterpResultTypeToStr(pValue->type));
+
+    if (bohExprInterpResultIsString(pTarget)) {
+        BOH_INTERP_EXPECT_OR_RETURN(pInterp, op == BOH_OP_PLUS_ASSIGN, false, line, column, "can't use %s operator with strings", pOperatorStr);
+
+        bohBoharesStringAppend(&pTarget->string, &pValue->string);
+        return true;
+    }
+
+    bohNumber* pTargetNumber = &pTarget->number;
+    const bohNumber* pValueNumber = &pValue->number;
+
+    if (bohParsIsBitwiseExprOperator(op)) {
+        BOH_INTERP_EXPECT_OR_RETURN(pInterp, bohNumberIsI64(pTargetNumber) && bohNumberIsI64(pValueNumber), false, line, column, 
+            "can't use %s bitwise operator with non integral types", pOperatorStr);
+    }
+
+    switch (op) {
+        case BOH_OP_PLUS_ASSIGN:
+            bohNumberAddAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_MINUS_ASSIGN:
+            bohNumberSubAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_MULT_ASSIGN:
+            bohNumberMultAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_DIV_ASSIGN:
+            BOH_INTERP_EXPECT_OR_RETURN(pInterp, !bohNumberIsZero(pValueNumber), false, line, column, "right operand of /= is zero");
+            bohNumberDivAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_MOD_ASSIGN:
+            BOH_INTERP_EXPECT_OR_RETURN(pInterp, !bohNumberIsZero(pValueNumber), false, line, column, "right operand of %%= is zero");
+            bohNumberModAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_BITWISE_AND_ASSIGN:
+            bohNumberBitwiseAndAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_BITWISE_OR_ASSIGN:
+            bohNumberBitwiseOrAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_BITWISE_XOR_ASSIGN:
+            bohNumberBitwiseXorAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_BITWISE_RSHIFT_ASSIGN:
+            bohNumberBitwiseRShiftAssign(pTargetNumber, pValueNumber);
+            break;
+        case BOH_OP_BITWISE_LSHIFT_ASSIGN:
+            bohNumberBitwiseLShiftAssign(pTargetNumber, pValueNumber);
+            break;
+        default:
+            BOH_ASSERT_FAIL("Invalid compound assignment operator");
+            return false;
+    }
+
+    return true;
+}
+
+
+static bohStmtInterpResult bohAstInterpretAssignmentStmt(bohInterpreter* pInterp, const bohAssignmentStmt* pAssignStmt, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pInterp);
+    BOH_ASSERT(pAssignStmt);
+
+    const bohInterpScratchScope scratchScope = interpBeginScratchScope(pInterp);
+
+    bohExprInterpResult value = interpInterpretExpr(pInterp, bohAssignmentStmtGetRightExpr(pAssignStmt), pFrame);
+
+    if (!bohErrorsStateHasInterpreterErrorGlobal()) {
+        const bohExpr* pLeftExpr = bohAssignmentStmtGetLeftExpr(pAssignStmt);
+        bohExprInterpResult* pVariable = interpGetVariable(pFrame, bohExprGetIdentifierExpr(pLeftExpr));
+
+        if (bohAssignmentStmtIsCompound(pAssignStmt)) {
+            // Value is consumed, but the variable may allocate to take it in (example: a view turned into an owned string)
+            const bohAllocator* pScratchAllocator = bohMemSetAllocator(pInterp->pPersistentAllocator);
+            interpInterpretCompoundAssignment(pInterp, pAssignStmt, pVariable, &value);
+            bohMemSetAllocator(pScratchAllocator);
+        } else {
+            interpPromoteScratchValue(pInterp, &scratchScope, &value);
+            bohExprInterpResultMove(pVariable, &value);
+        }
+    }
+
+    bohExprInterpResultDestroy(&value);
+
+    interpEndScratchScope(pInterp, &scratchScope);
+
+    return interpCreateDummyStmtInterpResult();
+}
+
+
+static bool interpOnLoopBackEdgeSlow(bohInterpreter* pInterp, const bohStmt* pLoopStmt)
+{
+    BOH_ASSERT(pInterp);
+    BOH_ASSERT(pLoopStmt);
+
+    const uint64_t count = pInterp->backEdgesCount;
+    const uint64_t limit = pInterp->backEdgesLimit;
+
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, !BOH_ATOMIC_LOAD_ACQUIRE_U64(&pInterp->isInterruptRequested), false, 
+        bohStmtGetLine(pLoopStmt), bohStmtGetColumn(pLoopStmt), "execution interrupted");
+
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, limit == 0 || count <= limit, false, bohStmtGetLine(pLoopStmt), bohStmtGetColumn(pLoopStmt), 
+        "loop iterations limit exceeded: %llu", (unsigned long long)limit);
+
+    const uint64_t nextPollCount = count + BOH_INTERP_BACK_EDGE_POLL_PERIOD;
+    pInterp->backEdgesCheckpoint = limit != 0 && limit < nextPollCount ? limit + 1 : nextPollCount;
+
+    return true;
+}
+
+
+// Called on every jump back to the loop head, so the fast path is a single compare
+static inline bool interpOnLoopBackEdge(bohInterpreter* pInterp, const bohStmt* pLoopStmt)
+{
+    if (++pInterp->backEdgesCount < pInterp->backEdgesCheckpoint) {
+        return true;
+    }
+
+    return interpOnLoopBackEdgeSlow(pInterp, pLoopStmt);
+}
+
+
+// Condition in the "<variable> <comparison> <integer constant>" form is checked without the generic expression
+// evaluation while the variable holds an integer. Slot address is stable for the whole loop
+typedef struct LoopCond
+{
+    const bohExpr* pExpr; // NULL means the condition is always true
+    const bohExprInterpResult* pVariable; // NULL if the condition isn't fused
+    bohExprOperator op;
+    int64_t constant;
+} bohLoopCond;
+
+
+static bohExprOperator interpGetMirroredComparison(bohExprOperator op)
+{
+    switch (op) {
+        case BOH_OP_LESS:       return BOH_OP_GREATER;
+        case BOH_OP_GREATER:    return BOH_OP_LESS;
+        case BOH_OP_LEQUAL:     return BOH_OP_GEQUAL;
+        case BOH_OP_GEQUAL:     return BOH_OP_LEQUAL;
+        case BOH_OP_EQUAL:      return BOH_OP_EQUAL;
+        case BOH_OP_NOT_EQUAL:  return BOH_OP_NOT_EQUAL;
+        default:                return BOH_OP_UNKNOWN;
+    }
+}
+
+
+static bool interpIsI64ValueExpr(const bohAST* pAst, const bohExpr* pExpr)
+{
+    return bohExprIsValueExpr(pExpr) && bohConstantIsNumberI64(bohAstGetConstant(pAst, bohExprGetValueExpr(pExpr)));
+}
+
+
+static bohLoopCond interpCreateLoopCond(const bohAST* pAst, bohStackFrame* pFrame, const bohExpr* pCondExpr)
+{
+    bohLoopCond cond;
+    
+    cond.pExpr = pCondExpr;
+    cond.pVariable = NULL;
+    cond.op = BOH_OP_UNKNOWN;
+    cond.constant = 0;
+
+    if (!pCondExpr || !bohExprIsBinaryExpr(pCondExpr)) {
+        return cond;
+    }
+
+    const bohBinaryExpr* pBinaryExpr = bohExprGetBinaryExpr(pCondExpr);
+
+    const bohExpr* pLeftExpr = bohBinaryExprGetLeftExpr(pBinaryExpr);
+    const bohExpr* pRightExpr = bohBinaryExprGetRightExpr(pBinaryExpr);
+    
+    bohExprOperator op = bohBinaryExprGetOperator(pBinaryExpr);
+
+    // "<constant> < i" is the same as "i > <constant>"
+    if (interpIsI64ValueExpr(pAst, pLeftExpr) && bohExprIsIdentifierExpr(pRightExpr)) {
+        const bohExpr* pTempExpr = pLeftExpr;
+        pLeftExpr = pRightExpr;
+        pRightExpr = pTempExpr;
+
+        op = interpGetMirroredComparison(op);
+    }
+
+    if (interpGetMirroredComparison(op) == BOH_OP_UNKNOWN || !bohExprIsIdentifierExpr(pLeftExpr) || !interpIsI64ValueExpr(pAst, pRightExpr)) {
+        return cond;
+    }
+
+    cond.pVariable = interpGetVariable(pFrame, bohExprGetIdentifierExpr(pLeftExpr));
+    cond.op = op;
+    cond.constant = bohNumberGetI64(bohConstantGetNumber(bohAstGetConstant(pAst, bohExprGetValueExpr(pRightExpr))));
+
+    return cond;
+}
+
+
+// Returns false if the condition is false or its evaluation has failed
+static bool interpEvalLoopCond(bohInterpreter* pInterp, const bohLoopCond* pCond, bohStackFrame* pFrame)
+{
+    if (!pCond->pExpr) {
+        return true;
+    }
+
+    const bohExprInterpResult* pVariable = pCond->pVariable;
+
+    if (pVariable && pVariable->type == BOH_EXPR_INTERP_RES_TYPE_NUMBER && bohNumberIsI64(&pVariable->number)) {
+        const int64_t value = pVariable->number.i64;
+
+        switch (pCond->op) {
+            case BOH_OP_LESS:       return value < pCond->constant;
+            case BOH_OP_GREATER:    return value > pCond->constant;
+            case BOH_OP_LEQUAL:     return value <= pCond->constant;
+            case BOH_OP_GEQUAL:     return value >= pCond->constant;
+            case BOH_OP_EQUAL:      return value == pCond->constant;
+            case BOH_OP_NOT_EQUAL:  return value != pCond->constant;
+            default:
+                BOH_ASSERT_FAIL("Invalid fused loop condition operator");
+                return false;
+        }
+    }
+
+    return interpEvalCondition(pInterp, pCond->pExpr, pFrame);
+}
+
+
+// Body is walked as a plain array fetched once, so an iteration costs the body statements, the condition
+// and the back-edge compare only
+static void interpRunLoop(bohInterpreter* pInterp, const bohStmt* pLoopStmt, const bohExpr* pCondExpr, const bohStmt* pStepStmt,
+    const bohStmtSpan* pBodyStmts, bool isCondCheckedFirst, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pInterp);
+    BOH_ASSERT(pLoopStmt);
+    BOH_ASSERT(pBodyStmts);
+
+    const bohStmt* const* ppBodyStmts = bohStmtSpanGetData(pBodyStmts);
+    const size_t bodyStmtsCount = bohStmtSpanGetSize(pBodyStmts);
+
+    const bohLoopCond cond = interpCreateLoopCond(pInterp->pAst, pFrame, pCondExpr);
+
+    if (isCondCheckedFirst && !interpEvalLoopCond(pInterp, &cond, pFrame)) {
+        return;
+    }
+
+    while (true) {
+        for (size_t i = 0; i < bodyStmtsCount; ++i) {
+            bohAstInterpretStmt(pInterp, ppBodyStmts[i], pFrame);
+
+            if (pInterp->isReturning || bohErrorsStateHasInterpreterErrorGlobal()) {
+                return;
+            }
+        }
+
+        if (pStepStmt) {
+            bohAstInterpretStmt(pInterp, pStepStmt, pFrame);
+
+            if (bohErrorsStateHasInterpreterErrorGlobal()) {
+                return;
+            }
+        }
+
+        if (!interpOnLoopBackEdge(pInterp, pLoopStmt) || !interpEvalLoopCond(pInterp, &cond, pFrame)) {
+            return;
+        }
+    }
+}
+
+
+static bohStmtInterpResult bohAstInterpretWhileStmt(bohInterpreter* pInterp, const bohStmt* pStmt, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pInterp);
+
+    const bohWhileStmt* pWhileStmt = bohStmtGetWhile(pStmt);
+
+    interpRunLoop(pInterp, pStmt, bohWhileStmtGetCondExpr(pWhileStmt), NULL, bohWhileStmtGetBodyStmts(pWhileStmt), 
+        !bohWhileStmtIsDoWhile(pWhileStmt), pFrame);
+
+    return interpCreateDummyStmtInterpResult();
+}
+
+
+static bohStmtInterpResult bohAstInterpretForStmt(bohInterpreter* pInterp, const bohStmt* pStmt, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pInterp);
+
+    const bohForStmt* pForStmt = bohStmtGetFor(pStmt);
+
+    if (bohForStmtGetInitStmt(pForStmt)) {
+        bohAstInterpretStmt(pInterp, bohForStmtGetInitStmt(pForStmt), pFrame);
+
+        if (bohErrorsStateHasInterpreterErrorGlobal()) {
+            return interpCreateDummyStmtInterpResult();
+        }
+    }
+
+    interpRunLoop(pInterp, pStmt, bohForStmtGetCondExpr(pForStmt), bohForStmtGetStepStmt(pForStmt), bohForStmtGetBodyStmts(pForStmt), 
+        true, pFrame);
+
+    return interpCreateDummyStmtInterpResult();
+}
+
+
+static bool interpEvalRangeBound(bohInterpreter* pInterp, const bohExpr* pBoundExpr, bohStackFrame* pFrame, int64_t* pValue)
+{
+    BOH_ASSERT(pValue);
+
+    const bohInterpScratchScope scratchScope = interpBeginScratchScope(pInterp);
+
+    bohExprInterpResult bound = interpInterpretExpr(pInterp, pBoundExpr, pFrame);
+
+    const bool isFailed = bohErrorsStateHasInterpreterErrorGlobal();
+    const bool isInteger = bohExprInterpResultIsNumberI64(&bound);
+    *pValue = isInteger ? bound.number.i64 : 0;
+
+    bohExprInterpResultDestroy(&bound);
+
+    interpEndScratchScope(pInterp, &scratchScope);
+
+    if (isFailed) {
+        return false;
+    }
+
+    BOH_INTERP_EXPECT_OR_RETURN(pInterp, isInteger, false, bohExprGetLine(pBoundExpr), bohExprGetColumn(pBoundExpr), 
+        "range bound must be an integer");
+
+    return true;
+}
+
+
+// Iterator is a raw C integer, its slot only mirrors the value for reads from the body. The resolver forbids
+// assignments to it, so the slot type is set once and the iterations don't check any types
+static bohStmtInterpResult bohAstInterpretRangeForStmt(bohInterpreter* pInterp, const bohStmt* pStmt, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pInterp);
+
+    const bohRangeForStmt* pRangeForStmt = bohStmtGetRangeFor(pStmt);
+
+    int64_t begin = 0;
+    int64_t end = 0;
+
+    if (!interpEvalRangeBound(pInterp, bohRangeForStmtGetBeginExpr(pRangeForStmt), pFrame, &begin) || 
+        !interpEvalRangeBound(pInterp, bohRangeForStmtGetEndExpr(pRangeForStmt), pFrame, &end)) {
+        return interpCreateDummyStmtInterpResult();
+    }
+
+    const int64_t step = bohRangeForStmtGetStep(pRangeForStmt);
+    BOH_ASSERT(step != 0);
+
+    // Iterations count is known before the first one, so the iterator can't overflow near the int64 limits
+    const uint64_t stepAbs = step > 0 ? (uint64_t)step : 0 - (uint64_t)step;
+    const uint64_t span = step > 0 ? (begin < end ? (uint64_t)end - (uint64_t)begin : 0) : (begin > end ? (uint64_t)begin - (uint64_t)end : 0);
+    const uint64_t iterationsCount = span == 0 ? 0 : (span - 1) / stepAbs + 1;
+
+    const bohStmt* const* ppBodyStmts = bohStmtSpanGetData(bohRangeForStmtGetBodyStmts(pRangeForStmt));
+    const size_t bodyStmtsCount = bohStmtSpanGetSize(bohRangeForStmtGetBodyStmts(pRangeForStmt));
+
+    bohExprInterpResult* pIterator = interpGetVariable(pFrame, bohExprGetIdentifierExpr(bohRangeForStmtGetIteratorExpr(pRangeForStmt)));
+    bohExprInterpResultSetNumberI64(pIterator, begin);
+
+    int64_t value = begin;
+
+    for (uint64_t iteration = 0; iteration < iterationsCount; ++iteration) {
+        BOH_ASSERT(bohExprInterpResultIsNumberI64(pIterator));
+        pIterator->number.i64 = value;
+
+        for (size_t i = 0; i < bodyStmtsCount; ++i) {
+            bohAstInterpretStmt(pInterp, ppBodyStmts[i], pFrame);
+
+            if (pInterp->isReturning || bohErrorsStateHasInterpreterErrorGlobal()) {
+                return interpCreateDummyStmtInterpResult();
+            }
+        }
+
+        if (!interpOnLoopBackEdge(pInterp, pStmt)) {
+            break;
+        }
+
+        value = (int64_t)((uint64_t)value + (uint64_t)step);
+    }
+
+    return interpCreateDummyStmtInterpResult();
+}
+
+
+static bohStmtInterpResult bohAstInterpretReturnStmt(bohInterpreter* pInterp, const bohReturnStmt* pReturnStmt, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pInterp);
+    BOH_ASSERT(pReturnStmt);
+
+    const bohExpr* pValueExpr = bohReturnStmtGetValueExpr(pReturnStmt);
+
+    if (bohReturnStmtIsTailCall(pReturnStmt)) {
+        bohExprInterpResult* pSlots = NULL;
+
+        // Arguments still need the current frame, so they are evaluated before it is released by the calling loop
+        if (interpPushCallArgs(pInterp, pValueExpr, pFrame, &pSlots)) {
+            pInterp->pTailCallFuncStmt = interpGetCallee(pValueExpr);
+            pInterp->pTailCallSlots = pSlots;
+        }
+    } else if (pValueExpr) {
+        const bohInterpScratchScope scratchScope = interpBeginScratchScope(pInterp);
+
+        bohExprInterpResult value = interpInterpretExpr(pInterp, pValueExpr, pFrame);
+
+        if (!bohErrorsStateHasInterpreterErrorGlobal()) {
+            interpPromoteScratchValue(pInterp, &scratchScope, &value);
+            bohExprInterpResultMove(&pInterp->returnValue, &value);
+        }
+
+        bohExprInterpResultDestroy(&value);
+
+        interpEndScratchScope(pInterp, &scratchScope);
+    } else {
+        bohExprInterpResultSetNumberI64(&pInterp->returnValue, 0);
+    }
+
+    pInterp->isReturning = true;
+
+    return interpCreateDummyStmtInterpResult();
+}
+
+
+static bohStmtInterpResult bohAstInterpretExprStmt(bohInterpreter* pInterp, const bohExprStmt* pExprStmt, bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pInterp);
+    BOH_ASSERT(pExprStmt);
+
+    const bohInterpScratchScope scratchScope = interpBeginScratchScope(pInterp);
+
+    bohExprInterpResult value = interpInterpretExpr(pInterp, bohExprStmtGetExpr(pExprStmt), pFrame);
+    bohExprInterpResultDestroy(&value);
+
+    interpEndScratchScope(pInterp, &scratchScope);
+
+    return interpCreateDummyStmtInterpResult();
+}
+
+
+static bohStmtInterpResult bohAstInterpretStmt(bohInterpreter* pInterp, const bohStmt* pStmt, bohStackFrame* pFrame)
 {
     BOH_ASSERT(pStmt);
 
     switch(pStmt->type) {
         case BOH_STMT_TYPE_PRINT:
-            return bohAstInterpretPrintStmt(bohStmtGetPrint(pStmt)/*, pStackFrame*/);
+            return bohAstInterpretPrintStmt(pInterp, bohStmtGetPrint(pStmt), pFrame);
         case BOH_STMT_TYPE_IF:
-            return bohAstInterpretIfStmt(bohStmtGetIf(pStmt)/*, bohStackFrameCreateChild(pStackFrame)*/);
+            return bohAstInterpretIfStmt(pInterp, bohStmtGetIf(pStmt), pFrame);
+        case BOH_STMT_TYPE_ASSIGNMENT:
+            return bohAstInterpretAssignmentStmt(pInterp, bohStmtGetAssignment(pStmt), pFrame);
+        case BOH_STMT_TYPE_FUNC:
+            // Declaration only, the resolver has bound the calls to it
+            return interpCreateDummyStmtInterpResult();
+        case BOH_STMT_TYPE_RETURN:
+            return bohAstInterpretReturnStmt(pInterp, bohStmtGetReturn(pStmt), pFrame);
+        case BOH_STMT_TYPE_EXPR:
+            return bohAstInterpretExprStmt(pInterp, bohStmtGetExpr(pStmt), pFrame);
+        case BOH_STMT_TYPE_WHILE:
+            return bohAstInterpretWhileStmt(pInterp, pStmt, pFrame);
+        case BOH_STMT_TYPE_FOR:
+            return bohAstInterpretForStmt(pInterp, pStmt, pFrame);
+        case BOH_STMT_TYPE_RANGE_FOR:
+            return bohAstInterpretRangeForStmt(pInterp, pStmt, pFrame);
         default:
             BOH_ASSERT_FAIL("Invalid statement type");
             return interpCreateDummyStmtInterpResult();
@@ -854,18 +1803,31 @@ static bohStmtInterpResult bohAstInterpretStmt(const bohStmt* pStmt/*, bohStackF
 }
 
 
-static void bohAstInterpretStmts(const bohAST* pAst)
+static void bohAstInterpretStmts(bohInterpreter* pInterp)
 {
-    BOH_ASSERT(pAst);
+    BOH_ASSERT(pInterp);
+
+    const bohAST* pAst = pInterp->pAst;
     
     const size_t stmtCount = bohAstGetStmtCount(pAst);
 
-    // bohStackFrame baseStackFrame = ...
+    const size_t globalSlotsCount = bohAstGetGlobalFrameSlotsCount(pAst);
+    BOH_ASSERT_MSG(BOH_STACK_ALLOCATOR_CAN_ALLOC_ARRAY(&pInterp->callStack, bohExprInterpResult, globalSlotsCount), "Global frame exceeds call stack");
 
-    for (size_t i = 0; i < stmtCount; ++i) {
+    // Nested blocks don't create frames, the resolver has placed their variables into the enclosing frame slots
+    bohStackFrame globalFrame = bohStackFrameCreate(NULL, interpPushFrameSlots(pInterp, globalSlotsCount), globalSlotsCount);
+    pInterp->pGlobalFrame = &globalFrame;
+
+    // Execution stops on the first runtime error
+    for (size_t i = 0; i < stmtCount && !bohErrorsStateHasInterpreterErrorGlobal(); ++i) {
         const bohStmt* pStmt = bohAstGetStmtByIdx(pAst, i);
-        bohAstInterpretStmt(pStmt/*, &baseStackFrame*/);
+        bohAstInterpretStmt(pInterp, pStmt, &globalFrame);
     }
+
+    bohStackFrameDestroy(&globalFrame);
+    bohStackAllocatorFreeToMarker(&pInterp->callStack, 0);
+
+    pInterp->pGlobalFrame = NULL;
 }
 
 
@@ -973,12 +1935,41 @@ const bohIfStmtInterpResult* bohStmtInterpResultGetIfStmtResult(const bohStmtInt
 }
 
 
-bohInterpreter bohInterpCreate(const bohAST* pAst)
+bohInterpreter bohInterpCreate(const bohAST* pAst, bohOutput* pOutput)
 {
     BOH_ASSERT(pAst);
+    BOH_ASSERT(pOutput);
 
     bohInterpreter interp;
     interp.pAst = pAst;
+    interp.pOutput = pOutput;
+
+    interp.callStack = bohStackAllocatorCreate(BOH_INTERP_CALL_STACK_SIZE, BOH_STACK_ALLOCATOR_TYPE_FORWARD);
+    interp.pGlobalFrame = NULL;
+    interp.callDepth = 0;
+
+    interp.scratchStack = bohStackAllocatorCreate(BOH_INTERP_SCRATCH_SIZE, BOH_STACK_ALLOCATOR_TYPE_FORWARD);
+    interp.pPersistentAllocator = bohMemGetAllocator();
+
+    interp.valueHeap = bohSizeClassAllocatorCreate(BOH_INTERP_VALUE_HEAP_SLAB_CAPACITY);
+    memset(&interp.valueHeapAllocator, 0, sizeof(bohAllocator));
+
+    // Allocators are bound on interpretation, the interpreter is returned by value and moves until then
+    interp.scratchAllocator.pAllocFunc = interpScratchAlloc;
+    interp.scratchAllocator.pReallocFunc = interpScratchRealloc;
+    interp.scratchAllocator.pFreeFunc = interpScratchFree;
+    interp.scratchAllocator.pUserData = NULL;
+
+    interp.returnValue = bohExprInterpResultCreate();
+    interp.isReturning = false;
+
+    interp.pTailCallFuncStmt = NULL;
+    interp.pTailCallSlots = NULL;
+
+    interp.backEdgesCount = 0;
+    interp.backEdgesCheckpoint = BOH_INTERP_BACK_EDGE_POLL_PERIOD;
+    interp.backEdgesLimit = 0;
+    interp.isInterruptRequested = 0;
 
     return interp;
 }
@@ -988,11 +1979,57 @@ void bohInterpDestroy(bohInterpreter* pInterp)
 {
     BOH_ASSERT(pInterp);
     pInterp->pAst = NULL;
+    pInterp->pOutput = NULL;
+
+    bohStackAllocatorDestroy(&pInterp->callStack);
+    bohStackAllocatorDestroy(&pInterp->scratchStack);
+    bohExprInterpResultDestroy(&pInterp->returnValue);
+
+    BOH_ASSERT_MSG(bohSizeClassAllocatorGetAllocatedCount(&pInterp->valueHeap) == 0, "Runtime values leak");
+    bohSizeClassAllocatorDestroy(&pInterp->valueHeap);
 }
 
 
 void bohInterpInterpret(bohInterpreter* pInterp)
 {
     BOH_ASSERT(pInterp);
-    bohAstInterpretStmts(pInterp->pAst);
+
+    pInterp->scratchAllocator.pUserData = pInterp;
+
+    pInterp->valueHeapAllocator = bohSizeClassAllocatorGetInterface(&pInterp->valueHeap);
+    pInterp->pPersistentAllocator = &pInterp->valueHeapAllocator;
+
+    const bohAllocator* pPrevAllocator = bohMemSetAllocator(pInterp->pPersistentAllocator);
+
+    bohAstInterpretStmts(pInterp);
+
+    bohMemSetAllocator(pPrevAllocator);
+    
+    // Everything printed before a runtime error must reach the output as well
+    bohOutputFlush(pInterp->pOutput);
+}
+
+
+void bohInterpSetLoopIterationsLimit(bohInterpreter* pInterp, uint64_t limit)
+{
+    BOH_ASSERT(pInterp);
+
+    pInterp->backEdgesLimit = limit;
+
+    // Next back-edge takes the slow path and recomputes the checkpoint with the new limit
+    pInterp->backEdgesCheckpoint = pInterp->backEdgesCount + 1;
+}
+
+
+uint64_t bohInterpGetLoopIterationsCount(const bohInterpreter* pInterp)
+{
+    BOH_ASSERT(pInterp);
+    return pInterp->backEdgesCount;
+}
+
+
+void bohInterpRequestInterrupt(bohInterpreter* pInterp)
+{
+    BOH_ASSERT(pInterp);
+    BOH_ATOMIC_STORE_RELEASE_U64(&pInterp->isInterruptRequested, 1);
 }
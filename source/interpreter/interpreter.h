@@ -4,6 +4,11 @@
 
 #include "parser/parser.h"
 
+#include "utils/io/output.h"
+#include "utils/memory/stack_allocator.h"
+#include "utils/memory/memory.h"
+#include "utils/memory/size_class_allocator.h"
+
 
 typedef enum ExprStmtInterpResultType
 {
@@ -74,6 +79,8 @@ const bohStringView* bohExprInterpResultGetStringStringView(const bohExprInterpR
 
 bohExprInterpResult* bohExprInterpResultMove(bohExprInterpResult* pDst, bohExprInterpResult* pSrc);
 bohExprInterpResult* bohExprInterpResultAssing(bohExprInterpResult* pDst, const bohExprInterpResult* pSrc);
+// Same as assign, but the source string becomes shared, so the copy is O(1)
+bohExprInterpResult* bohExprInterpResultShare(bohExprInterpResult* pDst, bohExprInterpResult* pSrc);
 
 
 typedef struct PrintStmtInterpResult
@@ -135,14 +142,55 @@ const bohIfStmtInterpResult* bohStmtInterpResultGetIfStmtResult(const bohStmtInt
 
 
 typedef struct AST bohAST;
+typedef struct StackFrame bohStackFrame;
 
 typedef struct Interpreter
 {
     const bohAST* pAst;
+    bohOutput* pOutput; // print statements destination, not owned
+
+    // Frames slots of the global scope and of the active calls, released in LIFO order on return
+    bohStackAllocator callStack;
+    bohStackFrame* pGlobalFrame;
+    uint32_t callDepth;
+
+    // Temporaries of a statement are allocated from the scratch stack, which is rewound once the statement is done.
+    // Assigned and returned values are copied out of it first, calls switch back to the persistent allocator,
+    // so nothing that outlives the statement stays in the scratch memory
+    bohStackAllocator scratchStack;
+    bohAllocator scratchAllocator;
+    const bohAllocator* pPersistentAllocator; // Value heap during interpretation, also takes scratch overflows
+
+    // Runtime values are acyclic and refcounted, so they are freed as soon as the last reference is gone and need
+    // no tracing. Their small blocks are recycled through the size class free lists instead of the general heap
+    bohSizeClassAllocator valueHeap;
+    bohAllocator valueHeapAllocator;
+
+    bohExprInterpResult returnValue;
+    bool isReturning;
+
+    // Call in the return position, its arguments are already on the call stack. The caller loop moves them
+    // down into the current frame place instead of pushing a new frame
+    const bohFuncStmt* pTailCallFuncStmt;
+    bohExprInterpResult* pTailCallSlots;
+
+    // Loop back-edges state. The limit and the interrupt request are checked on the slow path only,
+    // which is taken once per BOH_INTERP_BACK_EDGE_POLL_PERIOD back-edges or when the limit is reached
+    uint64_t backEdgesCount;
+    uint64_t backEdgesCheckpoint;
+    uint64_t backEdgesLimit; // 0 means unlimited
+    uint64_t isInterruptRequested; // Set by other threads or signal handlers, accessed atomically
 } bohInterpreter;
 
 
-bohInterpreter bohInterpCreate(const bohAST* pAst);
+bohInterpreter bohInterpCreate(const bohAST* pAst, bohOutput* pOutput);
 void bohInterpDestroy(bohInterpreter* pInterp);
 
 void bohInterpInterpret(bohInterpreter* pInterp);
+
+// Execution stops with a runtime error once loops have made more than limit iterations in total, 0 disables the limit
+void bohInterpSetLoopIterationsLimit(bohInterpreter* pInterp, uint64_t limit);
+uint64_t bohInterpGetLoopIterationsCount(const bohInterpreter* pInterp);
+
+// Safe to call from another thread or a signal handler, running loop stops with a runtime error
+void bohInterpRequestInterrupt(bohInterpreter* pInterp);
@@ -6,11 +6,16 @@
 #include "error.h"
 
 
+// Unused chunk tail shorter than 1/BOH_LEXER_CHUNK_MIN_TAIL_FRACTION of the chunk size isn't worth a read, new chunk is allocated
+#define BOH_LEXER_CHUNK_MIN_TAIL_FRACTION 8
+
+
 #define BOH_LEXER_PRINT_ERROR(LINE, COLUMN, FMT, ...) \
     bohErrorsStatePrintError(stderr, bohErrorsStateGerCurrProcessingFileGlobal(), LINE, COLUMN, "LEXER ERROR", FMT, __VA_ARGS__)
 
+// Errors are deferred if the token may continue in the next stream chunk
 #define BOH_LEXER_EXPECT(COND, LINE, COLUMN, FMT, ...)          \
-    if (!(COND)) {                                              \
+    if (!(COND) && !pLexer->isChunkEndReached) {                \
         BOH_LEXER_PRINT_ERROR(LINE, COLUMN, FMT, __VA_ARGS__);  \
         bohErrorsStatePushLexerErrorGlobal();                   \
     }
@@ -33,6 +38,7 @@ static const bohKeyWordToken BOH_KEY_WORDS[] = {
     { "while",  BOH_TOKEN_TYPE_WHILE },
     { "do",     BOH_TOKEN_TYPE_DO },
     { "for",    BOH_TOKEN_TYPE_FOR },
+    { "in",     BOH_TOKEN_TYPE_IN },
     { "func",   BOH_TOKEN_TYPE_FUNC },
     { "null",   BOH_TOKEN_TYPE_NULL },
     { "print",  BOH_TOKEN_TYPE_PRINT },
@@ -56,6 +62,7 @@ const char* bohLexerConvertTokenTypeToStr(bohTokenType type)
         case BOH_TOKEN_TYPE_RSQUAR: return "BOH_TOKEN_TYPE_RSQUAR";
         case BOH_TOKEN_TYPE_COMMA: return "BOH_TOKEN_TYPE_COMMA";
         case BOH_TOKEN_TYPE_DOT: return "BOH_TOKEN_TYPE_DOT";
+        case BOH_TOKEN_TYPE_RANGE: return "BOH_TOKEN_TYPE_RANGE";
         case BOH_TOKEN_TYPE_PLUS: return "BOH_TOKEN_TYPE_PLUS";
         case BOH_TOKEN_TYPE_PLUS_ASSIGN: return "BOH_TOKEN_TYPE_PLUS_ASSIGN";
         case BOH_TOKEN_TYPE_MINUS: return "BOH_TOKEN_TYPE_MINUS";
@@ -101,6 +108,7 @@ const char* bohLexerConvertTokenTypeToStr(bohTokenType type)
         case BOH_TOKEN_TYPE_WHILE: return "BOH_TOKEN_TYPE_WHILE";
         case BOH_TOKEN_TYPE_DO: return "BOH_TOKEN_TYPE_DO";
         case BOH_TOKEN_TYPE_FOR: return "BOH_TOKEN_TYPE_FOR";
+        case BOH_TOKEN_TYPE_IN: return "BOH_TOKEN_TYPE_IN";
         case BOH_TOKEN_TYPE_FUNC: return "BOH_TOKEN_TYPE_FUNC";
         case BOH_TOKEN_TYPE_NULL: return "BOH_TOKEN_TYPE_NULL";
         case BOH_TOKEN_TYPE_PRINT: return "BOH_TOKEN_TYPE_PRINT";
@@ -171,25 +179,10 @@ static void lexProcessNewLine(bohLexer* pLexer)
 }
 
 
-static void lexTokenDefConstructor(void* pToken)
-{
-    BOH_ASSERT(pToken);
-    *((bohToken*)pToken) = bohTokenCreate();
-}
-
-
-static void lexTokenDestructor(void* pToken)
-{
-    BOH_ASSERT(pToken);
-    bohTokenDestroy((bohToken*)pToken);
-}
-
-
-static void lexTokenCopy(void* pDstToken, const void* pSrcToken)
+static char lexOnDataEndReached(bohLexer* pLexer)
 {
-    BOH_ASSERT(pDstToken);
-    BOH_ASSERT(pSrcToken);
-    bohTokenAssign((bohToken*)pDstToken, (const bohToken*)pSrcToken);
+    pLexer->isChunkEndReached = !pLexer->isLastChunk;
+    return '\0';
 }
 
 
@@ -197,7 +190,7 @@ static char lexPickCurrPosChar(bohLexer* pLexer)
 {
     const size_t dataSize = bohStringViewGetSize(&pLexer->data);
 
-    return pLexer->currPos >= dataSize ? '\0' : bohStringViewAt(&pLexer->data, pLexer->currPos);
+    return pLexer->currPos >= dataSize ? lexOnDataEndReached(pLexer) : bohStringViewAt(&pLexer->data, pLexer->currPos);
 }
 
 
@@ -206,7 +199,7 @@ static char lexPickNextNStepChar(bohLexer* pLexer, size_t n)
     const size_t nextNCharIdx = pLexer->currPos + n;
     const size_t dataSize = bohStringViewGetSize(&pLexer->data);
 
-    return nextNCharIdx >= dataSize ? '\0' : bohStringViewAt(&pLexer->data, nextNCharIdx);
+    return nextNCharIdx >= dataSize ? lexOnDataEndReached(pLexer) : bohStringViewAt(&pLexer->data, nextNCharIdx);
 }
 
 
@@ -217,7 +210,7 @@ static char lexAdvanceCurrPos(bohLexer* pLexer)
 
     pLexer->column = nextCharIdx > dataSize ? pLexer->column : pLexer->column + 1;
 
-    return nextCharIdx > dataSize ? '\0' : bohStringViewAt(&pLexer->data, pLexer->currPos++);
+    return nextCharIdx > dataSize ? lexOnDataEndReached(pLexer) : bohStringViewAt(&pLexer->data, pLexer->currPos++);
 }
 
 
@@ -317,7 +310,17 @@ static bohToken lexGetNextToken(bohLexer* pLexer)
         case '[': type = BOH_TOKEN_TYPE_LSQUAR; break;
         case ']': type = BOH_TOKEN_TYPE_RSQUAR; break;
         case ',': type = BOH_TOKEN_TYPE_COMMA; break;
-        case '.': type = BOH_TOKEN_TYPE_DOT; break;
+        case '.':
+            switch (lexPickCurrPosChar(pLexer)) {
+                case '.':
+                    lexAdvanceCurrPos(pLexer);
+                    type = BOH_TOKEN_TYPE_RANGE;
+                    break;
+                default: 
+                    type = BOH_TOKEN_TYPE_DOT;
+                    break;
+            }
+            break;
         case ':': type = BOH_TOKEN_TYPE_COLON; break;
         case ';': type = BOH_TOKEN_TYPE_SEMICOLON; break;
         case '?': type = BOH_TOKEN_TYPE_QUESTION; break;
@@ -537,7 +540,8 @@ static bohToken lexGetNextToken(bohLexer* pLexer)
 
         type = BOH_TOKEN_TYPE_INTEGER;
 
-        if (lexPickCurrPosChar(pLexer) == '.') {
+        // "0..10" is an integer followed by the range operator
+        if (lexPickCurrPosChar(pLexer) == '.' && lexPickNextNStepChar(pLexer, 1) != '.') {
             const char nextCh = lexPickNextNStepChar(pLexer, 1);
             BOH_LEXER_EXPECT(lexIsDigitChar(nextCh), pLexer->line, pLexer->column, "invalid floating point number grammar");
             
@@ -655,7 +659,29 @@ bohLexer bohLexerCreate(const char* pCodeData, size_t codeDataSize)
     lexer.line = 1;
     lexer.column = 0;
 
-    lexer.tokens = BOH_DYN_ARRAY_CREATE(bohToken, lexTokenDefConstructor, lexTokenDestructor, lexTokenCopy);
+    lexer.tokens = bohTokenStorageCreate();
+
+    lexer.chunks = BOH_DYN_ARRAY_CREATE(char*, NULL, NULL, NULL);
+    lexer.chunkSize = 0;
+    lexer.chunkCapacity = 0;
+    lexer.carriedSize = 0;
+    lexer.tokensCountBeforeChunk = 0;
+
+    lexer.isLastChunk = true;
+    lexer.isChunkEndReached = false;
+    
+    return lexer;
+}
+
+
+bohLexer bohLexerCreateStreamed(size_t chunkSize)
+{
+    BOH_ASSERT(chunkSize > 0);
+
+    bohLexer lexer = bohLexerCreate("", 0);
+
+    lexer.chunkSize = chunkSize;
+    lexer.isLastChunk = false;
     
     return lexer;
 }
@@ -673,7 +699,21 @@ void bohLexerDestroy(bohLexer* pLexer)
     pLexer->line = 1;
     pLexer->column = 0;
 
-    bohDynArrayDestroy(&pLexer->tokens);
+    bohTokenStorageDestroy(&pLexer->tokens);
+
+    const size_t chunksCount = bohDynArrayGetSize(&pLexer->chunks);
+    for (size_t i = 0; i < chunksCount; ++i) {
+        bohMemFree(*BOH_DYN_ARRAY_AT(char*, &pLexer->chunks, i));
+    }
+    bohDynArrayDestroy(&pLexer->chunks);
+
+    pLexer->chunkSize = 0;
+    pLexer->chunkCapacity = 0;
+    pLexer->carriedSize = 0;
+    pLexer->tokensCountBeforeChunk = 0;
+
+    pLexer->isLastChunk = true;
+    pLexer->isChunkEndReached = false;
 }
 
 
@@ -693,19 +733,116 @@ void bohLexerTokenize(bohLexer* pLexer)
     bohTokenStorage* pTokens = &pLexer->tokens;
 
     while (pLexer->currPos < dataSize) {
+        const size_t tokenStartPos = pLexer->currPos;
+        const bohLineNmb tokenLine = pLexer->line;
+        const bohColumnNmb tokenColumn = pLexer->column;
+
         const bohToken token = lexGetNextToken(pLexer);
+
+        if (pLexer->isChunkEndReached) {
+            // Token is incomplete, roll back, it will be lexed again when the next chunk arrives
+            pLexer->currPos = tokenStartPos;
+            pLexer->line = tokenLine;
+            pLexer->column = tokenColumn;
+            break;
+        }
+
         BOH_LEXER_EXPECT(token.type != BOH_TOKEN_TYPE_UNKNOWN, token.line, token.column, "unknown token: %.*s", 
             bohStringViewGetSize(&token.lexeme), bohStringViewGetData(&token.lexeme));
 
         if (token.type != BOH_TOKEN_TYPE_DUMMY) {
-            bohDynArrayPushBack(pTokens, &token);
+            bohTokenStoragePushBack(pTokens, token);
+        }
+    }
+}
+
+
+char* bohLexerGetNextChunkBuffer(bohLexer* pLexer, size_t* pBufferSize)
+{
+    BOH_ASSERT(pLexer);
+    BOH_ASSERT(pBufferSize);
+    BOH_ASSERT_MSG(pLexer->chunkSize > 0, "lexer is not in streaming mode");
+    BOH_ASSERT_MSG(!pLexer->isLastChunk, "last chunk has been already tokenized");
+
+    const size_t carriedSize = pLexer->carriedSize;
+    const size_t chunksCount = bohDynArrayGetSize(&pLexer->chunks);
+
+    if (chunksCount > 0) {
+        char* pLastChunk = *BOH_DYN_ARRAY_AT(char*, &pLexer->chunks, chunksCount - 1);
+        char* pDataEnd = (char*)bohStringViewGetData(&pLexer->data) + bohStringViewGetSize(&pLexer->data);
+
+        const size_t tailSize = pLexer->chunkCapacity - (size_t)(pDataEnd - pLastChunk);
+        const size_t minTailSize = pLexer->chunkSize / BOH_LEXER_CHUNK_MIN_TAIL_FRACTION;
+
+        // Slow pipes return a line or so per read, they fill the same chunk instead of pinning a new one per read.
+        // The tail must also fit the carried token, so re-lexing of a huge partial token stays amortized
+        if (tailSize >= minTailSize && tailSize >= carriedSize) {
+            pLexer->data = bohStringViewCreateConstCStrSized(pDataEnd - carriedSize, carriedSize);
+            pLexer->startPos = 0;
+            pLexer->currPos = 0;
+
+            *pBufferSize = tailSize;
+            return pDataEnd;
         }
     }
+    
+    // Huge partial tokens (long strings or comments) grow the chunk to keep reading amortized
+    const size_t chunkCapacity = carriedSize * 2 > pLexer->chunkSize ? carriedSize * 2 : pLexer->chunkSize;
+
+    char* pChunk = (char*)bohMemAlloc(chunkCapacity);
+    BOH_ASSERT(pChunk);
+
+    if (carriedSize > 0) {
+        const char* pCarriedData = bohStringViewGetData(&pLexer->data) + pLexer->currPos;
+        memcpy_s(pChunk, chunkCapacity, pCarriedData, carriedSize);
+    }
+
+    const bool isPrevChunkUnused = chunksCount > 0 && bohTokenStorageGetSize(&pLexer->tokens) == pLexer->tokensCountBeforeChunk;
+
+    // No token points into previous chunk, so there is no need to keep it alive
+    if (isPrevChunkUnused) {
+        char** ppPrevChunk = BOH_DYN_ARRAY_AT(char*, &pLexer->chunks, chunksCount - 1);
+        bohMemFree(*ppPrevChunk);
+        *ppPrevChunk = pChunk;
+    } else {
+        char** ppNewChunk = (char**)bohDynArrayPushBackDummy(&pLexer->chunks);
+        *ppNewChunk = pChunk;
+    }
+
+    pLexer->chunkCapacity = chunkCapacity;
+
+    pLexer->data = bohStringViewCreateConstCStrSized(pChunk, carriedSize);
+    pLexer->startPos = 0;
+    pLexer->currPos = 0;
+
+    pLexer->tokensCountBeforeChunk = bohTokenStorageGetSize(&pLexer->tokens);
+
+    *pBufferSize = chunkCapacity - carriedSize;
+    return pChunk + carriedSize;
+}
+
+
+void bohLexerTokenizeChunk(bohLexer* pLexer, size_t writtenSize, bool isLastChunk)
+{
+    BOH_ASSERT(pLexer);
+    BOH_ASSERT_MSG(pLexer->chunkSize > 0, "lexer is not in streaming mode");
+    BOH_ASSERT_MSG(bohDynArrayGetSize(&pLexer->chunks) > 0, "bohLexerGetNextChunkBuffer must be called before");
+
+    const size_t chunkDataSize = pLexer->carriedSize + writtenSize;
+    pLexer->data = bohStringViewCreateConstCStrSized(bohStringViewGetData(&pLexer->data), chunkDataSize);
+
+    pLexer->isLastChunk = isLastChunk;
+    pLexer->isChunkEndReached = false;
+
+    bohLexerTokenize(pLexer);
+
+    pLexer->carriedSize = chunkDataSize - pLexer->currPos;
+    pLexer->isChunkEndReached = false;
 }
 
 
 size_t bohLexerGetTokenStorageMemorySize(const bohLexer* pLexer)
 {
     BOH_ASSERT(pLexer);
-    return bohDynArrayGetMemorySize(&pLexer->tokens);
+    return bohTokenStorageGetMemorySize(&pLexer->tokens);
 }
@@ -3,6 +3,7 @@
 #include "utils/ds/string.h"
 #include "utils/ds/string_view.h"
 #include "utils/ds/dyn_array.h"
+#include "utils/ds/typed_dyn_array.h"
 
 #include "types.h"
 
@@ -20,6 +21,7 @@ typedef enum TokenType
     BOH_TOKEN_TYPE_RSQUAR,                  // ]
     BOH_TOKEN_TYPE_COMMA,                   // ,
     BOH_TOKEN_TYPE_DOT,                     // .
+    BOH_TOKEN_TYPE_RANGE,                   // ..
     BOH_TOKEN_TYPE_PLUS,                    // +
     BOH_TOKEN_TYPE_PLUS_ASSIGN,             // +=
     BOH_TOKEN_TYPE_MINUS,                   // -
@@ -69,6 +71,7 @@ typedef enum TokenType
     BOH_TOKEN_TYPE_WHILE,
     BOH_TOKEN_TYPE_DO,
     BOH_TOKEN_TYPE_FOR,
+    BOH_TOKEN_TYPE_IN,
     BOH_TOKEN_TYPE_FUNC,
     BOH_TOKEN_TYPE_NULL,
     BOH_TOKEN_TYPE_PRINT,
@@ -104,7 +107,10 @@ bohTokenType bohTokenGetType(const bohToken* pToken);
 const char* bohTokenGetTypeStr(const bohToken* pToken);
 
 
-typedef bohDynArray bohTokenStorage;
+BOH_DEFINE_DYN_ARRAY(bohToken, bohTokenStorage)
+
+#define BOH_LEXER_DEFAULT_CHUNK_SIZE (64 * 1024)
+
 
 typedef struct Lexer
 {
@@ -117,14 +123,32 @@ typedef struct Lexer
     bohColumnNmb column;   // Lexeme column
 
     bohTokenStorage tokens;
+
+    // Streaming mode only. Chunks are kept alive until the lexer is destroyed since token lexemes point into them
+    bohDynArray chunks;
+    size_t chunkSize;
+    size_t chunkCapacity; // Capacity of the last chunk, the next reads go to its unused tail while it is large enough
+    size_t carriedSize; // Size of partial token at the end of the last chunk which will be moved to the next one
+    size_t tokensCountBeforeChunk;
+
+    bool isLastChunk;
+    bool isChunkEndReached; // Current token may continue in the next chunk
 } bohLexer;
 
 
 bohLexer bohLexerCreate(const char* pCodeData, size_t codeDataSize);
+
+// Streaming mode. Source is fed by chunks: fill the buffer returned by bohLexerGetNextChunkBuffer and pass the number 
+// of written bytes to bohLexerTokenizeChunk. The partial token at the end of a chunk is carried over to the next one
+bohLexer bohLexerCreateStreamed(size_t chunkSize);
+
 void bohLexerDestroy(bohLexer* pLexer);
 
 const bohTokenStorage* bohLexerGetTokens(const bohLexer* pLexer);
 
 void bohLexerTokenize(bohLexer* pLexer);
 
+char* bohLexerGetNextChunkBuffer(bohLexer* pLexer, size_t* pBufferSize);
+void bohLexerTokenizeChunk(bohLexer* pLexer, size_t writtenSize, bool isLastChunk);
+
 size_t bohLexerGetTokenStorageMemorySize(const bohLexer* pLexer);
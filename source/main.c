@@ -1,11 +1,19 @@
 #include "pch.h"
 
+#include <signal.h>
+
 #include "error.h"
 
 #include "lexer/lexer.h"
 #include "parser/parser.h"
+#include "resolver/resolver.h"
 #include "interpreter/interpreter.h"
 
+#include "utils/time/timer.h"
+#include "utils/fmt/fmt.h"
+#include "utils/io/async_writer.h"
+#include "utils/memory/counting_allocator.h"
+
 #include "core.h"
 
 
@@ -17,6 +25,10 @@
 #define BOH_OUTPUT_COLOR_ERROR          BOH_OUTPUT_COLOR_RED
 
 
+// Value expressions refer to the constant pool of the AST being printed
+static const bohAST* pPrintedAst = NULL;
+
+
 static void PrintExpr(const bohExpr* pExpr, uint64_t offsetLen);
 
 // Returns last printed stmt
@@ -28,10 +40,6 @@ static void PrintOffset(FILE* pStream, uint64_t offsetLen)
     for (uint64_t i = 0; i < offsetLen; ++i) {
         fputc(' ', pStream);
     }
-
-    if (offsetLen > 0) {
-        fflush(pStream);
-    }
 }
 
 
@@ -60,10 +68,6 @@ static void PrintEscapedCString(FILE* pStream, const char* pString, size_t strLe
             fputc(pString[i], pStream);
         }
     }
-
-    if (strLen > 0) {
-        fflush(pStream);
-    }
 }
 
 
@@ -97,33 +101,43 @@ static void PrintTokens(const bohTokenStorage* pTokens)
 {
     BOH_ASSERT(pTokens);
 
-    const size_t tokensCount = bohDynArrayGetSize(pTokens);
+    const size_t tokensCount = bohTokenStorageGetSize(pTokens);
     for (size_t i = 0; i < tokensCount; ++i) {
-        PrintToken(BOH_DYN_ARRAY_AT_CONST(bohToken, pTokens, i));
+        PrintToken(bohTokenStorageAtConst(pTokens, i));
     }
 }
 
 
-static void PrintValueExpr(const bohValueExpr* pExpr)
+static bool IsNumberValueExpr(const bohExpr* pExpr)
 {
-    BOH_ASSERT(pExpr);
+    return bohExprIsValueExpr(pExpr) && bohConstantIsNumber(bohAstGetConstant(pPrintedAst, bohExprGetValueExpr(pExpr)));
+}
 
-    switch (pExpr->type) {
-        case BOH_VALUE_EXPR_TYPE_NUMBER:
-            if (bohNumberIsI64(&pExpr->number)) {
-                fprintf_s(stdout, "%sI64[%d]%s", BOH_OUTPUT_COLOR_VALUE, bohNumberGetI64(&pExpr->number), BOH_OUTPUT_COLOR_RESET);
-            } else {
-                fprintf_s(stdout, "%sF64[%f]%s", BOH_OUTPUT_COLOR_VALUE, bohNumberGetF64(&pExpr->number), BOH_OUTPUT_COLOR_RESET);
-            }
+
+static void PrintValueExpr(const bohValueExpr* pValueExpr)
+{
+    BOH_ASSERT(pValueExpr);
+
+    const bohConstant* pConstant = bohAstGetConstant(pPrintedAst, pValueExpr);
+
+    switch (pConstant->type) {
+        case BOH_CONSTANT_TYPE_NUMBER:
+        {
+            char numberStr[BOH_FMT_NUMBER_MAX_SIZE];
+            const bool isI64 = bohNumberIsI64(&pConstant->number);
+            const size_t numberStrSize = isI64 ? 
+                bohFmtI64(numberStr, bohNumberGetI64(&pConstant->number)) : bohFmtF64(numberStr, bohNumberGetF64(&pConstant->number));
+
+            fprintf_s(stdout, "%s%s[%.*s]%s", BOH_OUTPUT_COLOR_VALUE, isI64 ? "I64" : "F64", (int)numberStrSize, numberStr, BOH_OUTPUT_COLOR_RESET);
             break;
-        case BOH_VALUE_EXPR_TYPE_STRING:
-            if (bohBoharesStringIsString(&pExpr->string)) {
-                const bohString* pString = bohBoharesStringGetString(&pExpr->string);
+        }
+        case BOH_CONSTANT_TYPE_STRING:
+            if (!bohBoharesStringIsStringView(&pConstant->string)) {
                 fprintf_s(stdout, "%sStr[\"", BOH_OUTPUT_COLOR_VALUE);
-                PrintEscapedCString(stdout, bohStringGetCStr(pString), bohStringGetSize(pString));
+                PrintEscapedCString(stdout, bohBoharesStringGetData(&pConstant->string), bohBoharesStringGetSize(&pConstant->string));
                 fprintf_s(stdout, "\"]%s", BOH_OUTPUT_COLOR_RESET);
             } else {
-                const bohStringView* pStrView = bohBoharesStringGetStringView(&pExpr->string);
+                const bohStringView* pStrView = bohBoharesStringGetStringView(&pConstant->string);
 
                 fprintf_s(stdout, "%sStrView[\"", BOH_OUTPUT_COLOR_VALUE);
                 PrintEscapedCString(stdout, bohStringViewGetData(pStrView), bohStringViewGetSize(pStrView));
@@ -144,8 +158,7 @@ static void PrintUnaryExpr(const bohUnaryExpr* pUnaryExpr, uint64_t offsetLen)
     const uint64_t nextlevelOffsetLen = offsetLen + 4;
     const bohExpr* pOperandExpr = pUnaryExpr->pExpr;
 
-    const bool isOperandValueExpr = bohExprIsValueExpr(pOperandExpr);
-    const bool isOperandNumber = isOperandValueExpr && bohValueExprIsNumber(bohExprGetValueExpr(pOperandExpr));
+    const bool isOperandNumber = IsNumberValueExpr(pOperandExpr);
 
     fprintf_s(stdout, "%sUnOp%s(", BOH_OUTPUT_COLOR_EXPR, BOH_OUTPUT_COLOR_RESET);
     fprintf_s(stdout, "%s%s%s", BOH_OUTPUT_COLOR_OPERATOR, bohParsExprOperatorToStr(pUnaryExpr->op), BOH_OUTPUT_COLOR_RESET);
@@ -172,12 +185,10 @@ static void PrintBinaryExpr(const bohBinaryExpr* pBinaryExpr, uint64_t offsetLen
     const uint64_t nextlevelOffsetLen = offsetLen + 4;
 
     const bohExpr* pLeftExpr = pBinaryExpr->pLeftExpr;
-    const bool isLeftOperandValueExpr = bohExprIsValueExpr(pLeftExpr);
-    const bool isLeftOperandNumber = isLeftOperandValueExpr && bohValueExprIsNumber(bohExprGetValueExpr(pLeftExpr));
+    const bool isLeftOperandNumber = IsNumberValueExpr(pLeftExpr);
 
     const bohExpr* pRightExpr = pBinaryExpr->pRightExpr;
-    const bool isRightOperandValueExpr = bohExprIsValueExpr(pRightExpr);
-    const bool isRightOperandNumber = isRightOperandValueExpr && bohValueExprIsNumber(bohExprGetValueExpr(pRightExpr));
+    const bool isRightOperandNumber = IsNumberValueExpr(pRightExpr);
 
     const bool areLeftAndRightNodesNumbers = isLeftOperandNumber && isRightOperandNumber;
     
@@ -216,6 +227,66 @@ static void PrintIdentifierExpr(const bohIdentifierExpr* pIdentifierExpr)
 }
 
 
+static void PrintCallExpr(const bohCallExpr* pCallExpr, uint64_t offsetLen)
+{
+    BOH_ASSERT(pCallExpr);
+
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+    const size_t argsCount = bohCallExprGetArgsCount(pCallExpr);
+
+    fprintf_s(stdout, "%sCall%s[%s%.*s%s](", BOH_OUTPUT_COLOR_EXPR, BOH_OUTPUT_COLOR_RESET, 
+        BOH_OUTPUT_COLOR_VALUE, (int)bohStringViewGetSize(&pCallExpr->name), bohStringViewGetData(&pCallExpr->name), BOH_OUTPUT_COLOR_RESET);
+
+    for (size_t i = 0; i < argsCount; ++i) {
+        fputc('\n', stdout);
+        PrintOffset(stdout, nextlevelOffsetLen);
+        PrintExpr(bohCallExprGetArgAt(pCallExpr, i), nextlevelOffsetLen);
+
+        if (i + 1 < argsCount) {
+            fputc(',', stdout);
+        }
+    }
+
+    if (argsCount > 0) {
+        fputc('\n', stdout);
+        PrintOffset(stdout, offsetLen);
+    }
+    fputc(')', stdout);
+}
+
+
+static void PrintIndexExpr(const bohIndexExpr* pIndexExpr, uint64_t offsetLen)
+{
+    BOH_ASSERT(pIndexExpr);
+
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+    const bool isSlice = bohIndexExprIsSlice(pIndexExpr);
+
+    fprintf_s(stdout, "%s%s%s(\n", BOH_OUTPUT_COLOR_EXPR, isSlice ? "Slice" : "Index", BOH_OUTPUT_COLOR_RESET);
+
+    PrintOffset(stdout, nextlevelOffsetLen);
+    PrintExpr(bohIndexExprGetObjectExpr(pIndexExpr), nextlevelOffsetLen);
+
+    const bohExpr* boundExprs[] = { bohIndexExprGetBeginExpr(pIndexExpr), bohIndexExprGetEndExpr(pIndexExpr) };
+    const size_t boundsCount = isSlice ? 2 : 1;
+
+    for (size_t i = 0; i < boundsCount; ++i) {
+        fputs(",\n", stdout);
+        PrintOffset(stdout, nextlevelOffsetLen);
+
+        if (boundExprs[i]) {
+            PrintExpr(boundExprs[i], nextlevelOffsetLen);
+        } else {
+            fputs("-", stdout);
+        }
+    }
+
+    fputc('\n', stdout);
+    PrintOffset(stdout, offsetLen);
+    fputc(')', stdout);
+}
+
+
 static void PrintExpr(const bohExpr* pExpr, uint64_t offsetLen)
 {
     BOH_ASSERT(pExpr);
@@ -233,6 +304,12 @@ static void PrintExpr(const bohExpr* pExpr, uint64_t offsetLen)
         case BOH_EXPR_TYPE_IDENTIFIER:
             PrintIdentifierExpr(bohExprGetIdentifierExpr(pExpr));
             break;
+        case BOH_EXPR_TYPE_CALL:
+            PrintCallExpr(bohExprGetCallExpr(pExpr), offsetLen);
+            break;
+        case BOH_EXPR_TYPE_INDEX:
+            PrintIndexExpr(bohExprGetIndexExpr(pExpr), offsetLen);
+            break;
         default:
             BOH_ASSERT_FAIL("Invalid AST node type");
             break;
@@ -257,14 +334,14 @@ static void PrintPrintStmt(const bohPrintStmt* pPrintStmt, uint64_t offsetLen)
 }
 
 
-static void PrintStmtList(const bohDynArray* pStmtPtrs, size_t offsetLen)
+static void PrintStmtList(const bohStmtSpan* pStmts, size_t offsetLen)
 {
-    BOH_ASSERT(bohDynArrayIsValid(pStmtPtrs));
+    BOH_ASSERT(pStmts);
 
-    const size_t thenStmtCount = bohDynArrayGetSize(pStmtPtrs);
+    const size_t thenStmtCount = bohStmtSpanGetSize(pStmts);
 
     for (size_t i = 0; i < thenStmtCount; ++i) {
-        const bohStmt* pStmt = *BOH_DYN_ARRAY_AT_CONST(bohStmt*, pStmtPtrs, i);
+        const bohStmt* pStmt = bohStmtSpanAt(pStmts, i);
         PrintAstStmt(pStmt, offsetLen);
 
         if (i + 1 < thenStmtCount) {
@@ -337,7 +414,13 @@ static void PrintAssignmentStmt(const bohAssignmentStmt* pStmt, uint64_t offsetL
 
     const uint64_t nextlevelOffsetLen = offsetLen + 4;
 
-    fprintf_s(stdout, "%sAssignmentStmt%s(\n", BOH_OUTPUT_COLOR_STMT, BOH_OUTPUT_COLOR_RESET);
+    fprintf_s(stdout, "%sAssignmentStmt%s(", BOH_OUTPUT_COLOR_STMT, BOH_OUTPUT_COLOR_RESET);
+
+    if (bohAssignmentStmtIsCompound(pStmt)) {
+        fprintf_s(stdout, "%s%s%s,", BOH_OUTPUT_COLOR_OPERATOR, bohParsExprOperatorToStr(pStmt->op), BOH_OUTPUT_COLOR_RESET);
+    }
+
+    fputc('\n', stdout);
     PrintOffset(stdout, nextlevelOffsetLen);
     
     PrintExpr(pStmt->pLeft, nextlevelOffsetLen);
@@ -353,6 +436,187 @@ static void PrintAssignmentStmt(const bohAssignmentStmt* pStmt, uint64_t offsetL
 }
 
 
+static void PrintFuncStmt(const bohFuncStmt* pStmt, uint64_t offsetLen)
+{
+    BOH_ASSERT(pStmt);
+
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+    const uint64_t nextlevelOffsetLen2 = nextlevelOffsetLen + 4;
+
+    fprintf_s(stdout, "%sFuncStmt%s[%s%.*s%s](\n", BOH_OUTPUT_COLOR_STMT, BOH_OUTPUT_COLOR_RESET, 
+        BOH_OUTPUT_COLOR_VALUE, (int)bohStringViewGetSize(&pStmt->name), bohStringViewGetData(&pStmt->name), BOH_OUTPUT_COLOR_RESET);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    fprintf_s(stdout, "%sParams%s [", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+
+    const size_t paramsCount = bohFuncStmtGetParamsCount(pStmt);
+
+    for (size_t i = 0; i < paramsCount; ++i) {
+        const bohStringView* pParamName = bohFuncStmtGetParamNameAt(pStmt, i);
+        fprintf_s(stdout, "%s%.*s", i > 0 ? ", " : "", (int)bohStringViewGetSize(pParamName), bohStringViewGetData(pParamName));
+    }
+
+    fprintf_s(stdout, "] %sBody%s [\n", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+    PrintOffset(stdout, nextlevelOffsetLen2);
+
+    PrintStmtList(bohFuncStmtGetBodyStmts(pStmt), nextlevelOffsetLen2);
+
+    fputc('\n', stdout);
+    PrintOffset(stdout, nextlevelOffsetLen);
+    fputs("]\n", stdout);
+    PrintOffset(stdout, offsetLen);
+    fputc(')', stdout);
+}
+
+
+static void PrintReturnStmt(const bohReturnStmt* pStmt, uint64_t offsetLen)
+{
+    BOH_ASSERT(pStmt);
+
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+
+    fprintf_s(stdout, "%sReturnStmt%s(", BOH_OUTPUT_COLOR_STMT, BOH_OUTPUT_COLOR_RESET);
+
+    if (pStmt->pValueExpr) {
+        fputc('\n', stdout);
+        PrintOffset(stdout, nextlevelOffsetLen);
+
+        PrintExpr(pStmt->pValueExpr, nextlevelOffsetLen);
+
+        fputc('\n', stdout);
+        PrintOffset(stdout, offsetLen);
+    }
+    fputc(')', stdout);
+}
+
+
+static void PrintExprStmt(const bohExprStmt* pStmt, uint64_t offsetLen)
+{
+    BOH_ASSERT(pStmt);
+
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+
+    fprintf_s(stdout, "%sExprStmt%s(\n", BOH_OUTPUT_COLOR_STMT, BOH_OUTPUT_COLOR_RESET);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    PrintExpr(pStmt->pExpr, nextlevelOffsetLen);
+
+    fputc('\n', stdout);
+    PrintOffset(stdout, offsetLen);
+    fputc(')', stdout);
+}
+
+
+static void PrintLoopBody(const bohStmtSpan* pBodyStmts, uint64_t offsetLen)
+{
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+
+    fprintf_s(stdout, "%sBody%s [\n", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    PrintStmtList(pBodyStmts, nextlevelOffsetLen);
+
+    fputc('\n', stdout);
+    PrintOffset(stdout, offsetLen);
+    fputc(']', stdout);
+}
+
+
+static void PrintWhileStmt(const bohWhileStmt* pStmt, uint64_t offsetLen)
+{
+    BOH_ASSERT(pStmt);
+
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+
+    fprintf_s(stdout, "%s%s%s(\n", BOH_OUTPUT_COLOR_STMT, pStmt->isDoWhile ? "DoWhileStmt" : "WhileStmt", BOH_OUTPUT_COLOR_RESET);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    fprintf_s(stdout, "%sCondition%s [", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+    PrintExpr(pStmt->pCondExpr, nextlevelOffsetLen);
+    fputs("]\n", stdout);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    PrintLoopBody(&pStmt->bodyStmts, nextlevelOffsetLen);
+
+    fputc('\n', stdout);
+    PrintOffset(stdout, offsetLen);
+    fputc(')', stdout);
+}
+
+
+static void PrintForStmt(const bohForStmt* pStmt, uint64_t offsetLen)
+{
+    BOH_ASSERT(pStmt);
+
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+
+    fprintf_s(stdout, "%sForStmt%s(\n", BOH_OUTPUT_COLOR_STMT, BOH_OUTPUT_COLOR_RESET);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    if (pStmt->pInitStmt) {
+        fprintf_s(stdout, "%sInit%s [", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+        PrintAstStmt(pStmt->pInitStmt, nextlevelOffsetLen);
+        fputs("]\n", stdout);
+        PrintOffset(stdout, nextlevelOffsetLen);
+    }
+
+    if (pStmt->pCondExpr) {
+        fprintf_s(stdout, "%sCondition%s [", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+        PrintExpr(pStmt->pCondExpr, nextlevelOffsetLen);
+        fputs("]\n", stdout);
+        PrintOffset(stdout, nextlevelOffsetLen);
+    }
+
+    if (pStmt->pStepStmt) {
+        fprintf_s(stdout, "%sStep%s [", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+        PrintAstStmt(pStmt->pStepStmt, nextlevelOffsetLen);
+        fputs("]\n", stdout);
+        PrintOffset(stdout, nextlevelOffsetLen);
+    }
+
+    PrintLoopBody(&pStmt->bodyStmts, nextlevelOffsetLen);
+
+    fputc('\n', stdout);
+    PrintOffset(stdout, offsetLen);
+    fputc(')', stdout);
+}
+
+
+static void PrintRangeForStmt(const bohRangeForStmt* pStmt, uint64_t offsetLen)
+{
+    BOH_ASSERT(pStmt);
+
+    const uint64_t nextlevelOffsetLen = offsetLen + 4;
+
+    fprintf_s(stdout, "%sRangeForStmt%s(\n", BOH_OUTPUT_COLOR_STMT, BOH_OUTPUT_COLOR_RESET);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    fprintf_s(stdout, "%sIterator%s [", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+    PrintExpr(bohRangeForStmtGetIteratorExpr(pStmt), nextlevelOffsetLen);
+    fputs("]\n", stdout);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    fprintf_s(stdout, "%sBegin%s [", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+    PrintExpr(bohRangeForStmtGetBeginExpr(pStmt), nextlevelOffsetLen);
+    fputs("]\n", stdout);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    fprintf_s(stdout, "%sEnd%s [", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+    PrintExpr(bohRangeForStmtGetEndExpr(pStmt), nextlevelOffsetLen);
+    fputs("]\n", stdout);
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    fprintf_s(stdout, "%sStep%s [%lld]\n", BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET, (long long)bohRangeForStmtGetStep(pStmt));
+    PrintOffset(stdout, nextlevelOffsetLen);
+
+    PrintLoopBody(bohRangeForStmtGetBodyStmts(pStmt), nextlevelOffsetLen);
+
+    fputc('\n', stdout);
+    PrintOffset(stdout, offsetLen);
+    fputc(')', stdout);
+}
+
+
 static void PrintAstStmt(const bohStmt* pStmt, uint64_t offsetLen)
 {
     BOH_ASSERT(pStmt);
@@ -367,6 +631,24 @@ static void PrintAstStmt(const bohStmt* pStmt, uint64_t offsetLen)
         case BOH_STMT_TYPE_ASSIGNMENT:
             PrintAssignmentStmt(bohStmtGetAssignment(pStmt), offsetLen);
             break;
+        case BOH_STMT_TYPE_FUNC:
+            PrintFuncStmt(bohStmtGetFunc(pStmt), offsetLen);
+            break;
+        case BOH_STMT_TYPE_RETURN:
+            PrintReturnStmt(bohStmtGetReturn(pStmt), offsetLen);
+            break;
+        case BOH_STMT_TYPE_EXPR:
+            PrintExprStmt(bohStmtGetExpr(pStmt), offsetLen);
+            break;
+        case BOH_STMT_TYPE_WHILE:
+            PrintWhileStmt(bohStmtGetWhile(pStmt), offsetLen);
+            break;
+        case BOH_STMT_TYPE_FOR:
+            PrintForStmt(bohStmtGetFor(pStmt), offsetLen);
+            break;
+        case BOH_STMT_TYPE_RANGE_FOR:
+            PrintRangeForStmt(bohStmtGetRangeFor(pStmt), offsetLen);
+            break;
         default:
             BOH_ASSERT_FAIL("Invalid statement type");
             break;
@@ -381,6 +663,8 @@ static void PrintAst(const bohAST* pAst)
     const size_t stmtCount = bohAstGetStmtCount(pAst);
     uint64_t offsetLen = 0;
 
+    pPrintedAst = pAst;
+
     for (size_t i = 0; i < stmtCount; ++i) {
         const bohStmt* pStmt = bohAstGetStmtByIdx(pAst, i);
         PrintAstStmt(pStmt, offsetLen);
@@ -389,88 +673,638 @@ static void PrintAst(const bohAST* pAst)
 }
 
 
-int main(int argc, char* argv[])
+typedef enum DriverPhase
+{
+    BOH_DRIVER_PHASE_LOAD,
+    BOH_DRIVER_PHASE_LEX,
+    BOH_DRIVER_PHASE_PARSE,
+    BOH_DRIVER_PHASE_RESOLVE,
+    BOH_DRIVER_PHASE_OPTIMIZE,
+    BOH_DRIVER_PHASE_EXECUTE,
+    BOH_DRIVER_PHASE_COUNT,
+} bohDriverPhase;
+
+
+static const char* DriverPhaseToStr(bohDriverPhase phase)
+{
+    switch (phase) {
+        case BOH_DRIVER_PHASE_LOAD:     return "load";
+        case BOH_DRIVER_PHASE_LEX:      return "lex";
+        case BOH_DRIVER_PHASE_PARSE:    return "parse";
+        case BOH_DRIVER_PHASE_RESOLVE:  return "resolve";
+        case BOH_DRIVER_PHASE_OPTIMIZE: return "optimize";
+        case BOH_DRIVER_PHASE_EXECUTE:  return "execute";
+        default:
+            BOH_ASSERT_FAIL("Invalid driver phase");
+            return "unknown";
+    }
+}
+
+
+// Phases are accumulated since load and lex interleave when the source is streamed
+typedef struct PhaseStats
+{
+    uint64_t wallNs;
+    uint64_t cpuNs;
+    uint64_t allocationsCount;
+    size_t peakSize;
+
+    uint64_t beginWallNs;
+    uint64_t beginCpuNs;
+    uint64_t beginAllocationsCount;
+
+    bool isUsed;
+} bohPhaseStats;
+
+
+typedef struct DriverOptions
+{
+    const char* pFilePath;
+
+    bohDriverPhase stopAfterPhase; // BOH_DRIVER_PHASE_COUNT means run everything
+    bohOutputFlushMode outputFlushMode;
+    uint64_t maxLoopIterations; // 0 means unlimited
+    uint64_t maxExecAllocations; // Valid if isMaxExecAllocationsSet
+
+    bool isDumpSourceEnabled;
+    bool isDumpTokensEnabled;
+    bool isDumpAstEnabled;
+    bool isStatsEnabled;
+    bool isAsyncOutputEnabled;
+    bool isMaxExecAllocationsSet;
+    bool isHelpRequested;
+} bohDriverOptions;
+
+
+typedef struct Driver
+{
+    bohDriverOptions options;
+    bohPhaseStats phases[BOH_DRIVER_PHASE_COUNT];
+
+    // Installed before anything else, so it sees every heap allocation including the ones of pools slabs
+    bohCountingAllocator heapAllocator;
+    bohAllocator heapAllocatorInterface;
+
+    bohFileContent fileContent;
+    bohLexer lexer;
+    bohParser parser;
+    bohOutput output;
+    bohAsyncWriter asyncWriter;
+
+    bool isLexerCreated;
+    bool isParserCreated;
+    bool isOutputCreated;
+    bool isAsyncWriterCreated;
+} bohDriver;
+
+
+static void PhaseBegin(bohDriver* pDriver, bohDriverPhase phase)
+{
+    BOH_ASSERT(pDriver);
+    BOH_ASSERT(phase < BOH_DRIVER_PHASE_COUNT);
+
+    if (!pDriver->options.isStatsEnabled) {
+        return;
+    }
+
+    bohPhaseStats* pStats = &pDriver->phases[phase];
+
+    bohMemResetPeakSize();
+    pStats->beginAllocationsCount = bohMemGetStats().allocationsCount;
+    pStats->beginCpuNs = bohTimeGetCpuNs();
+    pStats->beginWallNs = bohTimeGetWallNs();
+}
+
+
+static void PhaseEnd(bohDriver* pDriver, bohDriverPhase phase)
+{
+    BOH_ASSERT(pDriver);
+    BOH_ASSERT(phase < BOH_DRIVER_PHASE_COUNT);
+
+    if (!pDriver->options.isStatsEnabled) {
+        return;
+    }
+
+    const uint64_t endWallNs = bohTimeGetWallNs();
+    const uint64_t endCpuNs = bohTimeGetCpuNs();
+    const bohMemoryStats memStats = bohMemGetStats();
+
+    bohPhaseStats* pStats = &pDriver->phases[phase];
+
+    pStats->wallNs += endWallNs - pStats->beginWallNs;
+    pStats->cpuNs += endCpuNs - pStats->beginCpuNs;
+    pStats->allocationsCount += memStats.allocationsCount - pStats->beginAllocationsCount;
+    pStats->peakSize = memStats.peakSize > pStats->peakSize ? memStats.peakSize : pStats->peakSize;
+    pStats->isUsed = true;
+}
+
+
+static void PrintStats(const bohDriver* pDriver)
+{
+    BOH_ASSERT(pDriver);
+
+    fprintf_s(stderr, "%-10s %12s %12s %12s %14s\n", "phase", "wall ms", "cpu ms", "allocs", "peak KB");
+
+    for (size_t i = 0; i < BOH_DRIVER_PHASE_COUNT; ++i) {
+        const bohPhaseStats* pStats = &pDriver->phases[i];
+        const char* pPhaseName = DriverPhaseToStr((bohDriverPhase)i);
+
+        if (!pStats->isUsed) {
+            fprintf_s(stderr, "%-10s %12s %12s %12s %14s\n", pPhaseName, "-", "-", "-", "-");
+            continue;
+        }
+
+        fprintf_s(stderr, "%-10s %12.3f %12.3f %12llu %14.2f\n", pPhaseName, pStats->wallNs / 1e6, pStats->cpuNs / 1e6, 
+            (unsigned long long)pStats->allocationsCount, pStats->peakSize / 1024.0);
+    }
+
+    const bohMemoryStats memStats = bohMemGetStats();
+    fprintf_s(stderr, "total: %llu allocs, %llu frees, %zu bytes not freed\n", 
+        (unsigned long long)memStats.allocationsCount, (unsigned long long)memStats.freesCount, memStats.currentSize);
+}
+
+
+static void PrintUsage(FILE* pStream)
+{
+    fputs(
+        "Usage: bohares [options] [file | -]\n"
+        "Script is read from stdin if there is no file or file is \"-\"\n"
+        "\n"
+        "Options:\n"
+        "  --dump-source              print source code (regular files only)\n"
+        "  --dump-tokens              print lexer tokens\n"
+        "  --dump-ast                 print AST\n"
+        "  --stats                    print per phase wall time, CPU time, allocations and peak memory to stderr\n"
+        "  --stop-after=<phase>       stop after phase: load, lex, parse or resolve\n"
+        "  --output-buffering=<mode>  print statements buffering: full, line or explicit (flush at exit only),\n"
+        "                             line for terminals and full otherwise by default\n"
+        "  --async-output             write print statements output from a background thread\n"
+        "  --max-loop-iterations=<n>  stop with an error after n loop iterations in total\n"
+        "  --max-exec-allocs=<n>      fail if statements execution makes more than n heap allocations,\n"
+        "                             interpreter and output setup is not counted\n"
+        "  -h, --help                 print this message\n",
+        pStream);
+}
+
+
+// Returns false if arguments are invalid
+static bool ParseOptions(bohDriverOptions* pOptions, int argc, char* argv[])
+{
+    BOH_ASSERT(pOptions);
+
+    memset(pOptions, 0, sizeof(bohDriverOptions));
+    pOptions->pFilePath = BOH_FILE_STREAM_STDIN_PATH;
+    pOptions->stopAfterPhase = BOH_DRIVER_PHASE_COUNT;
+    pOptions->outputFlushMode = bohOutputGetDefaultFlushMode(BOH_OUTPUT_STDOUT_DESCRIPTOR);
+
+    bool isFilePathSet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* pArg = argv[i];
+        const char* pStopAfterPrefix = "--stop-after=";
+        const size_t stopAfterPrefixLen = strlen(pStopAfterPrefix);
+        const char* pOutputBufferingPrefix = "--output-buffering=";
+        const size_t outputBufferingPrefixLen = strlen(pOutputBufferingPrefix);
+        const char* pMaxLoopIterationsPrefix = "--max-loop-iterations=";
+        const size_t maxLoopIterationsPrefixLen = strlen(pMaxLoopIterationsPrefix);
+        const char* pMaxExecAllocationsPrefix = "--max-exec-allocs=";
+        const size_t maxExecAllocationsPrefixLen = strlen(pMaxExecAllocationsPrefix);
+
+        if (strcmp(pArg, "-h") == 0 || strcmp(pArg, "--help") == 0) {
+            pOptions->isHelpRequested = true;
+        } else if (strcmp(pArg, "--dump-source") == 0) {
+            pOptions->isDumpSourceEnabled = true;
+        } else if (strcmp(pArg, "--dump-tokens") == 0) {
+            pOptions->isDumpTokensEnabled = true;
+        } else if (strcmp(pArg, "--dump-ast") == 0) {
+            pOptions->isDumpAstEnabled = true;
+        } else if (strcmp(pArg, "--stats") == 0) {
+            pOptions->isStatsEnabled = true;
+        } else if (strcmp(pArg, "--async-output") == 0) {
+            pOptions->isAsyncOutputEnabled = true;
+        } else if (strncmp(pArg, pStopAfterPrefix, stopAfterPrefixLen) == 0) {
+            const char* pPhase = pArg + stopAfterPrefixLen;
+            
+            if (strcmp(pPhase, "load") == 0) {
+                pOptions->stopAfterPhase = BOH_DRIVER_PHASE_LOAD;
+            } else if (strcmp(pPhase, "lex") == 0) {
+                pOptions->stopAfterPhase = BOH_DRIVER_PHASE_LEX;
+            } else if (strcmp(pPhase, "parse") == 0) {
+                pOptions->stopAfterPhase = BOH_DRIVER_PHASE_PARSE;
+            } else if (strcmp(pPhase, "resolve") == 0) {
+                pOptions->stopAfterPhase = BOH_DRIVER_PHASE_RESOLVE;
+            } else {
+                fprintf_s(stderr, "%sInvalid phase: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pPhase, BOH_OUTPUT_COLOR_RESET);
+                return false;
+            }
+        } else if (strncmp(pArg, pOutputBufferingPrefix, outputBufferingPrefixLen) == 0) {
+            const char* pMode = pArg + outputBufferingPrefixLen;
+            
+            if (strcmp(pMode, "full") == 0) {
+                pOptions->outputFlushMode = BOH_OUTPUT_FLUSH_MODE_FULL;
+            } else if (strcmp(pMode, "line") == 0) {
+                pOptions->outputFlushMode = BOH_OUTPUT_FLUSH_MODE_LINE;
+            } else if (strcmp(pMode, "explicit") == 0) {
+                pOptions->outputFlushMode = BOH_OUTPUT_FLUSH_MODE_EXPLICIT;
+            } else {
+                fprintf_s(stderr, "%sInvalid output buffering mode: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pMode, BOH_OUTPUT_COLOR_RESET);
+                return false;
+            }
+        } else if (strncmp(pArg, pMaxLoopIterationsPrefix, maxLoopIterationsPrefixLen) == 0) {
+            const char* pValue = pArg + maxLoopIterationsPrefixLen;
+            char* pValueEnd = NULL;
+
+            pOptions->maxLoopIterations = strtoull(pValue, &pValueEnd, 10);
+
+            if (pValue[0] < '0' || pValue[0] > '9' || *pValueEnd != '\0') {
+                fprintf_s(stderr, "%sInvalid loop iterations count: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pValue, BOH_OUTPUT_COLOR_RESET);
+                return false;
+            }
+        } else if (strncmp(pArg, pMaxExecAllocationsPrefix, maxExecAllocationsPrefixLen) == 0) {
+            const char* pValue = pArg + maxExecAllocationsPrefixLen;
+            char* pValueEnd = NULL;
+
+            pOptions->maxExecAllocations = strtoull(pValue, &pValueEnd, 10);
+            pOptions->isMaxExecAllocationsSet = true;
+
+            if (pValue[0] < '0' || pValue[0] > '9' || *pValueEnd != '\0') {
+                fprintf_s(stderr, "%sInvalid allocations count: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pValue, BOH_OUTPUT_COLOR_RESET);
+                return false;
+            }
+        } else if (strcmp(pArg, BOH_FILE_STREAM_STDIN_PATH) != 0 && pArg[0] == '-') {
+            fprintf_s(stderr, "%sUnknown option: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pArg, BOH_OUTPUT_COLOR_RESET);
+            return false;
+        } else if (isFilePathSet) {
+            fprintf_s(stderr, "%sOnly one script file is allowed: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pArg, BOH_OUTPUT_COLOR_RESET);
+            return false;
+        } else {
+            pOptions->pFilePath = pArg;
+            isFilePathSet = true;
+        }
+    }
+
+    return true;
+}
+
+
+static bool IsStopAfter(const bohDriver* pDriver, bohDriverPhase phase)
+{
+    BOH_ASSERT(pDriver);
+    return pDriver->options.stopAfterPhase == phase;
+}
+
+
+// Returns false if the stream failed
+static bool TokenizeStream(bohDriver* pDriver, bohFileStream* pStream)
+{
+    BOH_ASSERT(pDriver);
+    BOH_ASSERT(pStream);
+
+    bohLexer* pLexer = &pDriver->lexer;
+
+    while (!bohFileStreamIsEnd(pStream)) {
+        size_t bufferSize = 0;
+        char* pBuffer = bohLexerGetNextChunkBuffer(pLexer, &bufferSize);
+
+        PhaseBegin(pDriver, BOH_DRIVER_PHASE_LOAD);
+        const size_t readSize = bohFileStreamRead(pStream, pBuffer, bufferSize);
+        PhaseEnd(pDriver, BOH_DRIVER_PHASE_LOAD);
+
+        PhaseBegin(pDriver, BOH_DRIVER_PHASE_LEX);
+        bohLexerTokenizeChunk(pLexer, readSize, bohFileStreamIsEnd(pStream));
+        PhaseEnd(pDriver, BOH_DRIVER_PHASE_LEX);
+    }
+
+    return bohFileStreamGetErrorCode(pStream) != BOH_FILE_CONTENT_ERROR_READ_FAILED;
+}
+
+
+// Stream is only drained, since --stop-after=load must not run the lexer
+static bool DrainStream(bohDriver* pDriver, bohFileStream* pStream)
+{
+    BOH_ASSERT(pDriver);
+    BOH_ASSERT(pStream);
+
+    char buffer[4096];
+
+    PhaseBegin(pDriver, BOH_DRIVER_PHASE_LOAD);
+    while (!bohFileStreamIsEnd(pStream)) {
+        bohFileStreamRead(pStream, buffer, sizeof(buffer));
+    }
+    PhaseEnd(pDriver, BOH_DRIVER_PHASE_LOAD);
+
+    return bohFileStreamGetErrorCode(pStream) != BOH_FILE_CONTENT_ERROR_READ_FAILED;
+}
+
+
+// Pipes and FIFOs are lexed chunk by chunk while they are being read
+static int LoadAndTokenizeStream(bohDriver* pDriver)
 {
-#define DEBUG_NO_ARGS
-#ifndef DEBUG_NO_ARGS
-    if (argc != 2) {
-        fprintf_s(stderr, BOH_OUTPUT_COLOR_RED, "Invalid command line arguments count: %d\n", argc);
+    BOH_ASSERT(pDriver);
+
+    const char* pFilePath = pDriver->options.pFilePath;
+
+    bohFileStream stream = bohFileStreamOpen(pFilePath);
+    if (bohFileStreamGetErrorCode(&stream) == BOH_FILE_CONTENT_ERROR_OPEN_FAILED) {
+        fprintf_s(stderr, "%sFailed to open file: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pFilePath, BOH_OUTPUT_COLOR_RESET);
         return EXIT_FAILURE;
     }
 
-    const char* pFilePath = argv[1];
-#else
-    (void)argc;
-    (void)argv;
+    bool isReadSucceeded = false;
 
-    const char* pFilePath = "../test/test.boh";
-#endif
+    if (IsStopAfter(pDriver, BOH_DRIVER_PHASE_LOAD)) {
+        isReadSucceeded = DrainStream(pDriver, &stream);
+    } else {
+        pDriver->lexer = bohLexerCreateStreamed(BOH_LEXER_DEFAULT_CHUNK_SIZE);
+        pDriver->isLexerCreated = true;
 
-    bohStrIDEngineInit();
-    fprintf_s(stdout, "%sSTRID Memory: %f KB\n\n", BOH_OUTPUT_COLOR_GREEN, bohStrIDEngineGetOccupiedMemorySize() / 1024.f, BOH_OUTPUT_COLOR_RESET);
+        isReadSucceeded = TokenizeStream(pDriver, &stream);
+    }
 
-    bohErrorsStateInit();
-    bohErrorsStateSetCurrProcessingFile(bohErrorsStateGet(), bohStringViewCreateConstCStr(pFilePath));
+    bohFileStreamClose(&stream);
+    
+    if (!isReadSucceeded) {
+        fprintf_s(stderr, "%sFailed to read file: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pFilePath, BOH_OUTPUT_COLOR_RESET);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+static int LoadAndTokenizeFile(bohDriver* pDriver)
+{
+    BOH_ASSERT(pDriver);
 
-    bohFileContent fileContent = bohReadTextFile(pFilePath);
-    switch (bohFileContentGetErrorCode(&fileContent)) {
+    const char* pFilePath = pDriver->options.pFilePath;
+
+    PhaseBegin(pDriver, BOH_DRIVER_PHASE_LOAD);
+    pDriver->fileContent = bohReadTextFile(pFilePath);
+    PhaseEnd(pDriver, BOH_DRIVER_PHASE_LOAD);
+
+    switch (bohFileContentGetErrorCode(&pDriver->fileContent)) {
         case BOH_FILE_CONTENT_ERROR_NULL_FILEPATH:
-            fprintf_s(stderr, "%sFilepath is NULL%s\n", BOH_OUTPUT_COLOR_RED, BOH_OUTPUT_COLOR_RESET);
+            fprintf_s(stderr, "%sFilepath is NULL%s\n", BOH_OUTPUT_COLOR_ERROR, BOH_OUTPUT_COLOR_RESET);
             return EXIT_FAILURE;
         case BOH_FILE_CONTENT_ERROR_OPEN_FAILED:
-            fprintf_s(stderr, "%sFailed to open file: %s%s\n", BOH_OUTPUT_COLOR_RED, pFilePath, BOH_OUTPUT_COLOR_RESET);
+        case BOH_FILE_CONTENT_ERROR_NOT_SEEKABLE:
+            fprintf_s(stderr, "%sFailed to open file: %s%s\n", BOH_OUTPUT_COLOR_ERROR, pFilePath, BOH_OUTPUT_COLOR_RESET);
             return EXIT_FAILURE;
         default:
             break;
     }
 
-    const char* pSourceCode = (const char*)fileContent.pData;
-    const size_t sourceCodeSize = fileContent.dataSize;
+    const char* pSourceCode = (const char*)pDriver->fileContent.pData;
+    const size_t sourceCodeSize = pDriver->fileContent.dataSize;
+
+    if (pDriver->options.isDumpSourceEnabled) {
+        fprintf_s(stdout, "%sSOURCE:%s\n", BOH_OUTPUT_COLOR_GREEN, BOH_OUTPUT_COLOR_RESET);
+        fprintf_s(stdout, "%.*s\n", (int)sourceCodeSize, pSourceCode);
+    }
+
+    if (IsStopAfter(pDriver, BOH_DRIVER_PHASE_LOAD)) {
+        return EXIT_SUCCESS;
+    }
+
+    PhaseBegin(pDriver, BOH_DRIVER_PHASE_LEX);
+    pDriver->lexer = bohLexerCreate(pSourceCode, sourceCodeSize);
+    pDriver->isLexerCreated = true;
+    bohLexerTokenize(&pDriver->lexer);
+    PhaseEnd(pDriver, BOH_DRIVER_PHASE_LEX);
+
+    return EXIT_SUCCESS;
+}
+
+
+static void CreateOutput(bohDriver* pDriver)
+{
+    BOH_ASSERT(pDriver);
+
+    const bohOutputFlushMode flushMode = pDriver->options.outputFlushMode;
+
+    if (pDriver->options.isAsyncOutputEnabled) {
+        pDriver->isAsyncWriterCreated = bohAsyncWriterCreateInPlace(&pDriver->asyncWriter, 
+            BOH_OUTPUT_STDOUT_DESCRIPTOR, BOH_ASYNC_WRITER_DEFAULT_CAPACITY);
+
+        if (!pDriver->isAsyncWriterCreated) {
+            fprintf_s(stderr, "%sFailed to start output thread, output is written synchronously%s\n", 
+                BOH_OUTPUT_COLOR_YELLOW, BOH_OUTPUT_COLOR_RESET);
+        }
+    }
+
+    pDriver->output = pDriver->isAsyncWriterCreated ? 
+        bohOutputCreateAsync(&pDriver->asyncWriter, BOH_OUTPUT_DEFAULT_BUFFER_SIZE, flushMode) :
+        bohOutputCreate(BOH_OUTPUT_STDOUT_DESCRIPTOR, BOH_OUTPUT_DEFAULT_BUFFER_SIZE, flushMode);
+    
+    pDriver->isOutputCreated = true;
+}
+
+
+// Returns false if any output data could not be written
+static bool DestroyOutput(bohDriver* pDriver)
+{
+    BOH_ASSERT(pDriver);
+
+    bool isFailed = false;
+
+    // Output passes the rest data to the writer, which drains it before the thread is stopped
+    if (pDriver->isOutputCreated) {
+        bohOutputDestroy(&pDriver->output);
+        isFailed = bohOutputIsFailed(&pDriver->output);
+        pDriver->isOutputCreated = false;
+    }
+
+    if (pDriver->isAsyncWriterCreated) {
+        bohAsyncWriterDestroy(&pDriver->asyncWriter);
+        isFailed = isFailed || bohAsyncWriterIsFailed(&pDriver->asyncWriter);
+        pDriver->isAsyncWriterCreated = false;
+    }
+
+    return !isFailed;
+}
+
+
+// Interpreter which Ctrl+C stops at the next loop back-edge, so the output printed so far is still flushed
+static bohInterpreter* pRunningInterp = NULL;
+
+
+static void OnInterruptSignal(int signalNmb)
+{
+    // Second Ctrl+C kills the process as usual
+    signal(signalNmb, SIG_DFL);
 
-    fprintf_s(stdout, "%sSOURCE:%s\n", BOH_OUTPUT_COLOR_GREEN, BOH_OUTPUT_COLOR_RESET);
-    if (sourceCodeSize > 0) {
-        fprintf_s(stdout, "%.*s\n", sourceCodeSize, pSourceCode);
+    if (pRunningInterp) {
+        bohInterpRequestInterrupt(pRunningInterp);
     }
+}
 
-    bohLexer lexer = bohLexerCreate(pSourceCode, sourceCodeSize);
-    bohLexerTokenize(&lexer);
 
-    const bohTokenStorage* pTokens = bohLexerGetTokens(&lexer);
+// Returns process exit code. Everything created here is destroyed by DriverDestroy, so early returns don't leak
+static int DriverRun(bohDriver* pDriver)
+{
+    BOH_ASSERT(pDriver);
+
+    const char* pFilePath = pDriver->options.pFilePath;
+    const bool isStdin = strcmp(pFilePath, BOH_FILE_STREAM_STDIN_PATH) == 0;
 
-    fprintf_s(stdout, "\n%sLEXER TOKENS (Memory: %f KB):%s\n", BOH_OUTPUT_COLOR_GREEN, bohLexerGetTokenStorageMemorySize(&lexer) / 1024.f, BOH_OUTPUT_COLOR_RESET);
-    PrintTokens(pTokens);
+    bohErrorsStateSetCurrProcessingFile(bohErrorsStateGet(), bohStringViewCreateConstCStr(isStdin ? "<stdin>" : pFilePath));
+
+    const int loadResult = isStdin || !bohFileIsRegular(pFilePath) ? 
+        LoadAndTokenizeStream(pDriver) : LoadAndTokenizeFile(pDriver);
+    
+    if (loadResult != EXIT_SUCCESS || IsStopAfter(pDriver, BOH_DRIVER_PHASE_LOAD)) {
+        return loadResult;
+    }
+
+    const bohTokenStorage* pTokens = bohLexerGetTokens(&pDriver->lexer);
+
+    if (pDriver->options.isDumpTokensEnabled) {
+        fprintf_s(stdout, "%sLEXER TOKENS (Memory: %f KB):%s\n", BOH_OUTPUT_COLOR_GREEN, 
+            bohLexerGetTokenStorageMemorySize(&pDriver->lexer) / 1024.f, BOH_OUTPUT_COLOR_RESET);
+        PrintTokens(pTokens);
+    }
 
     if (bohErrorsStateHasLexerErrorGlobal()) {
-        exit(-1);
+        return -1;
     }
 
-    bohParser parser = bohParserCreate(pTokens);
-    bohParserParse(&parser);
+    if (IsStopAfter(pDriver, BOH_DRIVER_PHASE_LEX)) {
+        return EXIT_SUCCESS;
+    }
 
-    const bohAST* pAst = bohParserGetAST(&parser);
-    fprintf_s(stdout, "%s\nAST (Memory: %f KB):%s\n", BOH_OUTPUT_COLOR_GREEN, bohAstGetMemorySize(pAst) / 1024.f, BOH_OUTPUT_COLOR_RESET);
-    PrintAst(pAst);
+    PhaseBegin(pDriver, BOH_DRIVER_PHASE_PARSE);
+    pDriver->parser = bohParserCreate(pTokens);
+    pDriver->isParserCreated = true;
+    bohParserParse(&pDriver->parser);
+    PhaseEnd(pDriver, BOH_DRIVER_PHASE_PARSE);
 
     if (bohErrorsStateHasParserErrorGlobal()) {
-        exit(-2);
+        return -2;
     }
 
-    bohInterpreter interp = bohInterpCreate(pAst);
+    const bohAST* pAst = bohParserGetAST(&pDriver->parser);
 
-    fprintf_s(stdout, "\n\n%sINTERPRETER:%s\n", BOH_OUTPUT_COLOR_GREEN, BOH_OUTPUT_COLOR_RESET);
-    bohInterpInterpret(&interp);
+    if (pDriver->options.isDumpAstEnabled) {
+        fprintf_s(stdout, "%sAST (Memory: %f KB):%s\n", BOH_OUTPUT_COLOR_GREEN, bohAstGetMemorySize(pAst) / 1024.f, BOH_OUTPUT_COLOR_RESET);
+        PrintAst(pAst);
+    }
 
-    if (bohErrorsStateHasInterpreterErrorGlobal()) {   
-        exit(-3);
+    if (IsStopAfter(pDriver, BOH_DRIVER_PHASE_PARSE)) {
+        return EXIT_SUCCESS;
     }
 
+    PhaseBegin(pDriver, BOH_DRIVER_PHASE_RESOLVE);
+    bohResolver resolver = bohResolverCreate(bohParserGetMutableAST(&pDriver->parser));
+    bohResolverResolve(&resolver);
+    bohResolverDestroy(&resolver);
+    PhaseEnd(pDriver, BOH_DRIVER_PHASE_RESOLVE);
+
+    if (bohErrorsStateHasResolverErrorGlobal()) {
+        return -4;
+    }
+
+    if (IsStopAfter(pDriver, BOH_DRIVER_PHASE_RESOLVE)) {
+        return EXIT_SUCCESS;
+    }
+
+    // Interpreter output bypasses stdio, so the dumps must reach stdout first
+    fflush(stdout);
+
+    PhaseBegin(pDriver, BOH_DRIVER_PHASE_EXECUTE);
+    CreateOutput(pDriver);
+
+    bohInterpreter interp = bohInterpCreate(pAst, &pDriver->output);
+    bohInterpSetLoopIterationsLimit(&interp, pDriver->options.maxLoopIterations);
+
+    pRunningInterp = &interp;
+    signal(SIGINT, OnInterruptSignal);
+
+    const uint64_t beginExecAllocationsCount = bohCountingAllocatorGetAllocationsCount(&pDriver->heapAllocator);
+    bohInterpInterpret(&interp);
+    const uint64_t execAllocationsCount = bohCountingAllocatorGetAllocationsCount(&pDriver->heapAllocator) - beginExecAllocationsCount;
+    
+    signal(SIGINT, SIG_DFL);
+    pRunningInterp = NULL;
+
     bohInterpDestroy(&interp);
-    bohParserDestroy(&parser);
-    bohLexerDestroy(&lexer);
 
-    bohErrorsStateDestroy();
+    const bool isOutputWritten = DestroyOutput(pDriver);
+    PhaseEnd(pDriver, BOH_DRIVER_PHASE_EXECUTE);
 
-    bohStrIDEngineTerminate();
+    if (bohErrorsStateHasInterpreterErrorGlobal()) {
+        return -3;
+    }
+
+    if (pDriver->options.isMaxExecAllocationsSet && execAllocationsCount > pDriver->options.maxExecAllocations) {
+        fprintf_s(stderr, "%sStatements execution made %llu heap allocations, the limit is %llu%s\n", BOH_OUTPUT_COLOR_ERROR, 
+            (unsigned long long)execAllocationsCount, (unsigned long long)pDriver->options.maxExecAllocations, BOH_OUTPUT_COLOR_RESET);
+        return -5;
+    }
+
+    if (!isOutputWritten) {
+        fprintf_s(stderr, "%sFailed to write output%s\n", BOH_OUTPUT_COLOR_ERROR, BOH_OUTPUT_COLOR_RESET);
+        return EXIT_FAILURE;
+    }
 
     return EXIT_SUCCESS;
 }
+
+
+static void DriverDestroy(bohDriver* pDriver)
+{
+    BOH_ASSERT(pDriver);
+
+    DestroyOutput(pDriver);
+
+    if (pDriver->isParserCreated) {
+        bohParserDestroy(&pDriver->parser);
+        pDriver->isParserCreated = false;
+    }
+
+    if (pDriver->isLexerCreated) {
+        bohLexerDestroy(&pDriver->lexer);
+        pDriver->isLexerCreated = false;
+    }
+
+    bohFileContentFree(&pDriver->fileContent);
+}
+
+
+int main(int argc, char* argv[])
+{
+    bohDriver driver;
+    memset(&driver, 0, sizeof(bohDriver));
+
+    if (!ParseOptions(&driver.options, argc, argv)) {
+        PrintUsage(stderr);
+        return EXIT_FAILURE;
+    }
+
+    if (driver.options.isHelpRequested) {
+        PrintUsage(stdout);
+        return EXIT_SUCCESS;
+    }
+
+    driver.heapAllocator = bohCountingAllocatorCreate();
+    driver.heapAllocatorInterface = bohCountingAllocatorGetInterface(&driver.heapAllocator);
+    bohMemSetAllocator(&driver.heapAllocatorInterface);
+
+    bohStrIDEngineInit();
+    bohBoharesStringEngineInit();
+    bohErrorsStateInit();
+
+    const int exitCode = DriverRun(&driver);
+
+    DriverDestroy(&driver);
+    bohErrorsStateDestroy();
+    bohBoharesStringEngineTerminate();
+    bohStrIDEngineTerminate();
+
+    bohMemSetAllocator(NULL);
+
+    if (driver.options.isStatsEnabled) {
+        PrintStats(&driver);
+    }
+
+    return exitCode;
+}
@@ -7,6 +7,8 @@
 
 #include "error.h"
 
+#include "utils/ds/hash.h"
+
 
 #define BOH_PARSER_PRINT_ERROR(LINE, COLUMN, FMT, ...) \
     bohErrorsStatePrintError(stderr, bohErrorsStateGerCurrProcessingFileGlobal(), LINE, COLUMN, "PARSER ERROR", FMT, __VA_ARGS__)
@@ -18,56 +20,50 @@
     }
 
 
-static bohBoharesString parsGetUnescapedString(const bohBoharesString* pString)
+#define BOH_CONSTANT_POOL_MIN_SLOTS_COUNT 64
+#define BOH_CONSTANT_POOL_EMPTY_SLOT      UINT32_MAX
+#define BOH_AST_POOL_SLAB_CAPACITY        4096
+
+
+// Char which replaces the backslash and the char following it, 0 if the pair isn't an escape sequence
+static const char BOH_ESCAPE_SEQUENCES[256] = {
+    ['t'] = '\t', ['r'] = '\r', ['n'] = '\n', ['\"'] = '\"', ['\''] = '\'', ['\\'] = '\\',
+};
+
+
+// Literal without escape sequences is returned as is, others are unescaped into the AST string arena
+static bohStringView parsGetUnescapedString(bohAST* pAst, const bohStringView* pLexeme)
 {
-    BOH_ASSERT(pString);
+    BOH_ASSERT(pAst);
+    BOH_ASSERT(pLexeme);
+
+    const char* pData = bohStringViewGetData(pLexeme);
+    const size_t size = bohStringViewGetSize(pLexeme);
 
-    const size_t strSize = bohBoharesStringGetSize(pString);
+    const char* pFirstEscape = size > 0 ? (const char*)memchr(pData, '\\', size) : NULL;
 
-    bohBoharesString str = bohBoharesStringCreateString();
-    if (strSize == 0) {
-        return str;
+    if (!pFirstEscape) {
+        return *pLexeme;
     }
 
-    bohBoharesStringResize(&str, strSize);
-
-    size_t j = 0;
-
-    for (size_t i = 0; i < strSize; ++i, ++j) {
-        const char currSymb = bohBoharesStringAt(pString, i);
-
-        if (currSymb == '\\') {
-            const char nextSymb = bohBoharesStringAt(pString, i + 1);
-
-            if (nextSymb == 't') {
-                bohBoharesStringSetAt(&str, '\t', j);
-                ++i;
-            } else if (nextSymb == '\"') {
-                bohBoharesStringSetAt(&str, '\"', j);
-                ++i;
-            } else if (nextSymb == '\'') {
-                bohBoharesStringSetAt(&str, '\'', j);
-                ++i;
-            } else if (nextSymb == 'r') {
-                bohBoharesStringSetAt(&str, '\r', j);
-                ++i;
-            } else if (nextSymb == 'n') {
-                bohBoharesStringSetAt(&str, '\n', j);
-                ++i;
-            } else if (nextSymb == '\\') {
-                bohBoharesStringSetAt(&str, '\\', j);
-                ++i;
-            } else {
-                bohBoharesStringSetAt(&str, currSymb, j);
-            }
+    // Unescaped string is never longer than the lexeme
+    char* pUnescaped = (char*)bohArenaAllocatorAlloc(&pAst->stringMemArena, size, 1);
+
+    size_t j = (size_t)(pFirstEscape - pData);
+    memcpy(pUnescaped, pData, j);
+
+    for (size_t i = j; i < size; ++i, ++j) {
+        const char escaped = pData[i] == '\\' && i + 1 < size ? BOH_ESCAPE_SEQUENCES[(uint8_t)pData[i + 1]] : '\0';
+
+        if (escaped != '\0') {
+            pUnescaped[j] = escaped;
+            ++i;
         } else {
-            bohBoharesStringSetAt(&str, currSymb, j);
+            pUnescaped[j] = pData[i];
         }
     }
 
-    bohBoharesStringResize(&str, j);
-
-    return str;
+    return bohStringViewCreateConstCStrSized(pUnescaped, j);
 }
 
 
@@ -112,138 +108,140 @@ const char* bohParsExprOperatorToStr(bohExprOperator op)
 }
 
 
-void bohValueExprDestroy(bohValueExpr* pExpr)
+void bohConstantDestroy(bohConstant* pConstant)
 {
-    BOH_ASSERT(pExpr);
+    BOH_ASSERT(pConstant);
 
-    switch (pExpr->type) {
-        case BOH_VALUE_EXPR_TYPE_NUMBER:
-            bohNumberSetI64(&pExpr->number, 0);
+    switch (pConstant->type) {
+        case BOH_CONSTANT_TYPE_NUMBER:
+            bohNumberSetI64(&pConstant->number, 0);
             break;
-        case BOH_VALUE_EXPR_TYPE_STRING:
-            bohBoharesStringDestroy(&pExpr->string);
+        case BOH_CONSTANT_TYPE_STRING:
+            bohBoharesStringDestroy(&pConstant->string);
             break;
         default:
-            BOH_ASSERT_FAIL("Invalid value expression type");
+            BOH_ASSERT_FAIL("Invalid constant type");
             break;
     }
 
-    pExpr->type = BOH_VALUE_EXPR_TYPE_NUMBER;
+    pConstant->type = BOH_CONSTANT_TYPE_NUMBER;
 }
 
 
-void bohValueExprCreateInPlace(bohValueExpr* pExpr)
+void bohConstantCreateInPlace(bohConstant* pConstant)
 {
-    BOH_ASSERT(pExpr);
+    BOH_ASSERT(pConstant);
 
-    pExpr->type = BOH_VALUE_EXPR_TYPE_NUMBER;
-    pExpr->number = bohNumberCreateI64(0);
+    pConstant->type = BOH_CONSTANT_TYPE_NUMBER;
+    pConstant->number = bohNumberCreateI64(0);
 }
 
 
-void bohValueExprCreateNumberInPlace(bohValueExpr* pExpr, bohNumber number)
+void bohConstantCreateNumberInPlace(bohConstant* pConstant, bohNumber number)
 {
-    bohValueExprCreateNumberNumberPtrInPlace(pExpr, &number);
+    bohConstantCreateNumberNumberPtrInPlace(pConstant, &number);
 }
 
 
-void bohValueExprCreateNumberNumberPtrInPlace(bohValueExpr* pExpr, const bohNumber* pNumber)
+void bohConstantCreateNumberNumberPtrInPlace(bohConstant* pConstant, const bohNumber* pNumber)
 {
-    BOH_ASSERT(pExpr);
+    BOH_ASSERT(pConstant);
     BOH_ASSERT(pNumber);
 
-    pExpr->type = BOH_VALUE_EXPR_TYPE_NUMBER;
-    bohNumberAssign(&pExpr->number, pNumber);
+    pConstant->type = BOH_CONSTANT_TYPE_NUMBER;
+    bohNumberAssign(&pConstant->number, pNumber);
 }
 
 
-void bohValueExprCreateStringStringPtrInPlace(bohValueExpr* pExpr, const bohBoharesString* pString)
+void bohConstantCreateStringStringPtrInPlace(bohConstant* pConstant, const bohBoharesString* pString)
 {
-    BOH_ASSERT(pExpr);
+    BOH_ASSERT(pConstant);
     BOH_ASSERT(pString);
 
-    pExpr->type = BOH_VALUE_EXPR_TYPE_STRING;
-    bohBoharesStringAssign(&pExpr->string, pString);
+    pConstant->type = BOH_CONSTANT_TYPE_STRING;
+    pConstant->string = bohBoharesStringCreateStringView();
+    bohBoharesStringAssign(&pConstant->string, pString);
 }
 
 
-void bohValueExprCreateStringStringMoveInPlace(bohValueExpr* pExpr, bohBoharesString* pString)
+void bohConstantCreateStringStringMoveInPlace(bohConstant* pConstant, bohBoharesString* pString)
 {
-    BOH_ASSERT(pExpr);
+    BOH_ASSERT(pConstant);
     BOH_ASSERT(pString);
 
-    pExpr->type = BOH_VALUE_EXPR_TYPE_STRING;
-    bohBoharesStringMove(&pExpr->string, pString);
+    pConstant->type = BOH_CONSTANT_TYPE_STRING;
+    pConstant->string = bohBoharesStringCreateStringView();
+    bohBoharesStringMove(&pConstant->string, pString);
 }
 
 
-bool bohValueExprIsNumber(const bohValueExpr* pExpr)
+bool bohConstantIsNumber(const bohConstant* pConstant)
 {
-    BOH_ASSERT(pExpr);
-    return pExpr->type == BOH_VALUE_EXPR_TYPE_NUMBER;
+    BOH_ASSERT(pConstant);
+    return pConstant->type == BOH_CONSTANT_TYPE_NUMBER;
 }
 
 
-bool bohValueExprIsNumberI64(const bohValueExpr* pExpr)
+bool bohConstantIsNumberI64(const bohConstant* pConstant)
 {
-    BOH_ASSERT(pExpr);
-    return bohValueExprIsNumber(pExpr) && bohNumberIsI64(&pExpr->number);
+    BOH_ASSERT(pConstant);
+    return bohConstantIsNumber(pConstant) && bohNumberIsI64(&pConstant->number);
 }
 
 
-bool bohValueExprIsNumberF64(const bohValueExpr *pExpr)
+bool bohConstantIsNumberF64(const bohConstant *pConstant)
 {
-    BOH_ASSERT(pExpr);
-    return bohValueExprIsNumber(pExpr) && bohNumberIsF64(&pExpr->number);
+    BOH_ASSERT(pConstant);
+    return bohConstantIsNumber(pConstant) && bohNumberIsF64(&pConstant->number);
 }
 
 
-bool bohValueExprIsString(const bohValueExpr *pExpr)
+bool bohConstantIsString(const bohConstant *pConstant)
 {
-    BOH_ASSERT(pExpr);
-    return pExpr->type == BOH_VALUE_EXPR_TYPE_STRING;
+    BOH_ASSERT(pConstant);
+    return pConstant->type == BOH_CONSTANT_TYPE_STRING;
 }
 
 
-bohValueExprType bohValueExprGetType(const bohValueExpr* pExpr)
+bohConstantType bohConstantGetType(const bohConstant* pConstant)
 {
-    BOH_ASSERT(pExpr);
-    return pExpr->type;
+    BOH_ASSERT(pConstant);
+    return pConstant->type;
 }
 
 
-const bohNumber *bohValueExprGetNumber(const bohValueExpr *pExpr)
+const bohNumber *bohConstantGetNumber(const bohConstant *pConstant)
 {
-    BOH_ASSERT(bohValueExprIsNumber(pExpr));
-    return &pExpr->number;
+    BOH_ASSERT(bohConstantIsNumber(pConstant));
+    return &pConstant->number;
 }
 
 
-const bohBoharesString* bohValueExprGetString(const bohValueExpr *pExpr)
+const bohBoharesString* bohConstantGetString(const bohConstant *pConstant)
 {
-    BOH_ASSERT(bohValueExprIsString(pExpr));
-    return &pExpr->string;
+    BOH_ASSERT(bohConstantIsString(pConstant));
+    return &pConstant->string;
 }
 
 
-bohValueExpr* bohValueExprAssign(bohValueExpr* pDst, const bohValueExpr* pSrc)
+bohConstant* bohConstantAssign(bohConstant* pDst, const bohConstant* pSrc)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
-    bohValueExprDestroy(pDst);
+    bohConstantDestroy(pDst);
 
     pDst->type = pSrc->type;
 
     switch (pSrc->type) {
-        case BOH_VALUE_EXPR_TYPE_NUMBER:
+        case BOH_CONSTANT_TYPE_NUMBER:
             bohNumberAssign(&pDst->number, &pSrc->number);
             break;
-        case BOH_VALUE_EXPR_TYPE_STRING:
+        case BOH_CONSTANT_TYPE_STRING:
             bohBoharesStringAssign(&pDst->string, &pSrc->string);
             break;
         default:
-            BOH_ASSERT_FAIL("Invalid value expr type");
+            BOH_ASSERT_FAIL("Invalid constant type");
             break;
     }
 
@@ -251,28 +249,246 @@ bohValueExpr* bohValueExprAssign(bohValueExpr* pDst, const bohValueExpr* pSrc)
 }
 
 
-bohValueExpr* bohValueExprMove(bohValueExpr* pDst, bohValueExpr* pSrc)
+bohConstant* bohConstantMove(bohConstant* pDst, bohConstant* pSrc)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
-    bohValueExprDestroy(pDst);
+    bohConstantDestroy(pDst);
 
     pDst->type = pSrc->type;
 
     switch (pSrc->type) {
-        case BOH_VALUE_EXPR_TYPE_NUMBER:
+        case BOH_CONSTANT_TYPE_NUMBER:
             bohNumberMove(&pDst->number, &pSrc->number);
             break;
-        case BOH_VALUE_EXPR_TYPE_STRING:
+        case BOH_CONSTANT_TYPE_STRING:
             bohBoharesStringMove(&pDst->string, &pSrc->string);
             break;
         default:
-            BOH_ASSERT_FAIL("Invalid value expr type");
+            BOH_ASSERT_FAIL("Invalid constant type");
             break;
     }
 
-    pSrc->type = BOH_VALUE_EXPR_TYPE_NUMBER;
+    pSrc->type = BOH_CONSTANT_TYPE_NUMBER;
+
+    return pDst;
+}
+
+
+static void ConstantDefConstr(void* pElement)
+{
+    bohConstantCreateInPlace((bohConstant*)pElement);
+}
+
+
+static void ConstantDestr(void* pElement)
+{
+    bohConstantDestroy((bohConstant*)pElement);
+}
+
+
+static void ConstantCopy(void* pDst, const void* pSrc)
+{
+    bohConstantCreateInPlace((bohConstant*)pDst);
+    bohConstantAssign((bohConstant*)pDst, (const bohConstant*)pSrc);
+}
+
+
+static uint64_t parsGetConstantHash(const bohConstant* pConstant)
+{
+    if (bohConstantIsString(pConstant)) {
+        return bohStrIDGetHash(&pConstant->string.internID);
+    }
+
+    const bohNumber* pNumber = &pConstant->number;
+
+    // Integer and float with the same bits are different constants
+    return bohNumberIsI64(pNumber) ? bohHashMem(&pNumber->i64, sizeof(pNumber->i64)) : ~bohHashMem(&pNumber->f64, sizeof(pNumber->f64));
+}
+
+
+static bool parsIsConstantsEqual(const bohConstant* pLeft, const bohConstant* pRight)
+{
+    if (pLeft->type != pRight->type) {
+        return false;
+    }
+
+    if (bohConstantIsString(pLeft)) {
+        return bohStrIDEqual(&pLeft->string.internID, &pRight->string.internID);
+    }
+
+    // Bitwise, so -0.0 and 0.0 stay different constants
+    return pLeft->number.type == pRight->number.type && memcmp(&pLeft->number.i64, &pRight->number.i64, sizeof(pLeft->number.i64)) == 0;
+}
+
+
+static void parsConstantPoolRehash(bohConstantPool* pPool, size_t slotsCount)
+{
+    BOH_ASSERT((slotsCount & (slotsCount - 1)) == 0);
+
+    bohConstantSlotArrayResize(&pPool->slots, slotsCount);
+
+    bohConstantIdx* pSlots = bohConstantSlotArrayGetData(&pPool->slots);
+    const size_t mask = slotsCount - 1;
+
+    for (size_t i = 0; i < slotsCount; ++i) {
+        pSlots[i] = BOH_CONSTANT_POOL_EMPTY_SLOT;
+    }
+
+    const size_t constantsCount = bohDynArrayGetSize(&pPool->constants);
+
+    for (size_t i = 0; i < constantsCount; ++i) {
+        size_t slotIdx = parsGetConstantHash(BOH_DYN_ARRAY_AT_CONST(bohConstant, &pPool->constants, i)) & mask;
+
+        while (pSlots[slotIdx] != BOH_CONSTANT_POOL_EMPTY_SLOT) {
+            slotIdx = (slotIdx + 1) & mask;
+        }
+
+        pSlots[slotIdx] = (bohConstantIdx)i;
+    }
+}
+
+
+// Takes the constant over if there is no equal one in the pool yet, destroys it otherwise
+static bohConstantIdx parsConstantPoolAddMove(bohConstantPool* pPool, bohConstant* pConstant)
+{
+    BOH_ASSERT(pPool);
+    BOH_ASSERT(pConstant);
+
+    bohConstantIdx* pSlots = bohConstantSlotArrayGetData(&pPool->slots);
+    const size_t mask = bohConstantSlotArrayGetSize(&pPool->slots) - 1;
+
+    size_t slotIdx = parsGetConstantHash(pConstant) & mask;
+
+    for (; pSlots[slotIdx] != BOH_CONSTANT_POOL_EMPTY_SLOT; slotIdx = (slotIdx + 1) & mask) {
+        if (parsIsConstantsEqual(bohConstantPoolAt(pPool, pSlots[slotIdx]), pConstant)) {
+            bohConstantDestroy(pConstant);
+            return pSlots[slotIdx];
+        }
+    }
+
+    const size_t index = bohDynArrayGetSize(&pPool->constants);
+    BOH_ASSERT(index < BOH_CONSTANT_POOL_EMPTY_SLOT);
+
+    bohConstant* pNewConstant = (bohConstant*)bohDynArrayPushBackDummy(&pPool->constants);
+    bohConstantMove(pNewConstant, pConstant);
+
+    // Load factor is kept under 1/2, so probe sequences stay short
+    if ((index + 1) * 2 > bohConstantSlotArrayGetSize(&pPool->slots)) {
+        parsConstantPoolRehash(pPool, bohConstantSlotArrayGetSize(&pPool->slots) * 2);
+    } else {
+        pSlots[slotIdx] = (bohConstantIdx)index;
+    }
+
+    return (bohConstantIdx)index;
+}
+
+
+bohConstantPool bohConstantPoolCreate(void)
+{
+    bohConstantPool pool;
+
+    pool.constants = BOH_DYN_ARRAY_CREATE(bohConstant, ConstantDefConstr, ConstantDestr, ConstantCopy);
+    pool.slots = bohConstantSlotArrayCreate();
+
+    parsConstantPoolRehash(&pool, BOH_CONSTANT_POOL_MIN_SLOTS_COUNT);
+
+    return pool;
+}
+
+
+void bohConstantPoolDestroy(bohConstantPool* pPool)
+{
+    BOH_ASSERT(pPool);
+
+    bohDynArrayDestroy(&pPool->constants);
+    bohConstantSlotArrayDestroy(&pPool->slots);
+}
+
+
+bohConstantIdx bohConstantPoolAddNumber(bohConstantPool* pPool, bohNumber number)
+{
+    bohConstant constant;
+    bohConstantCreateNumberInPlace(&constant, number);
+
+    return parsConstantPoolAddMove(pPool, &constant);
+}
+
+
+bohConstantIdx bohConstantPoolAddStringMove(bohConstantPool* pPool, bohBoharesString* pString)
+{
+    BOH_ASSERT(pString);
+
+    bohBoharesStringIntern(pString);
+
+    bohConstant constant;
+    bohConstantCreateStringStringMoveInPlace(&constant, pString);
+
+    return parsConstantPoolAddMove(pPool, &constant);
+}
+
+
+const bohConstant* bohConstantPoolAt(const bohConstantPool* pPool, bohConstantIdx index)
+{
+    BOH_ASSERT(pPool);
+    return BOH_DYN_ARRAY_AT_CONST(bohConstant, &pPool->constants, index);
+}
+
+
+size_t bohConstantPoolGetSize(const bohConstantPool* pPool)
+{
+    BOH_ASSERT(pPool);
+    return bohDynArrayGetSize(&pPool->constants);
+}
+
+
+size_t bohConstantPoolGetMemorySize(const bohConstantPool* pPool)
+{
+    BOH_ASSERT(pPool);
+    return bohDynArrayGetMemorySize(&pPool->constants) + bohConstantSlotArrayGetMemorySize(&pPool->slots);
+}
+
+
+void bohValueExprDestroy(bohValueExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    pExpr->constantIdx = 0;
+}
+
+
+void bohValueExprCreateInPlace(bohValueExpr* pExpr, bohConstantIdx constantIdx)
+{
+    BOH_ASSERT(pExpr);
+    pExpr->constantIdx = constantIdx;
+}
+
+
+bohConstantIdx bohValueExprGetConstantIdx(const bohValueExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->constantIdx;
+}
+
+
+bohValueExpr* bohValueExprAssign(bohValueExpr* pDst, const bohValueExpr* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    pDst->constantIdx = pSrc->constantIdx;
+
+    return pDst;
+}
+
+
+bohValueExpr* bohValueExprMove(bohValueExpr* pDst, bohValueExpr* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    pDst->constantIdx = pSrc->constantIdx;
+    pSrc->constantIdx = 0;
 
     return pDst;
 }
@@ -417,7 +633,11 @@ bohBinaryExpr* bohBinaryExprMove(bohBinaryExpr* pDst, bohBinaryExpr* pSrc)
 void bohIdentifierExprDestroy(bohIdentifierExpr* pExpr)
 {
     BOH_ASSERT(pExpr);
+
     bohStringViewReset(&pExpr->name);
+
+    pExpr->depth = 0;
+    pExpr->slot = BOH_IDENTIFIER_EXPR_UNRESOLVED_SLOT;
 }
 
 
@@ -427,6 +647,9 @@ void bohIdentifierExprCreateInPlace(bohIdentifierExpr* pExpr, const bohStringVie
     BOH_ASSERT(pName);
 
     bohStringViewAssignStringViewPtr(&pExpr->name, pName);
+
+    pExpr->depth = 0;
+    pExpr->slot = BOH_IDENTIFIER_EXPR_UNRESOLVED_SLOT;
 }
 
 
@@ -437,6 +660,37 @@ const bohStringView* bohIdentifierExprGetName(const bohIdentifierExpr* pExpr)
 }
 
 
+void bohIdentifierExprSetStorage(bohIdentifierExpr* pExpr, uint32_t depth, uint32_t slot)
+{
+    BOH_ASSERT(pExpr);
+    BOH_ASSERT(slot != BOH_IDENTIFIER_EXPR_UNRESOLVED_SLOT);
+
+    pExpr->depth = depth;
+    pExpr->slot = slot;
+}
+
+
+uint32_t bohIdentifierExprGetDepth(const bohIdentifierExpr* pExpr)
+{
+    BOH_ASSERT(bohIdentifierExprIsResolved(pExpr));
+    return pExpr->depth;
+}
+
+
+uint32_t bohIdentifierExprGetSlot(const bohIdentifierExpr* pExpr)
+{
+    BOH_ASSERT(bohIdentifierExprIsResolved(pExpr));
+    return pExpr->slot;
+}
+
+
+bool bohIdentifierExprIsResolved(const bohIdentifierExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->slot != BOH_IDENTIFIER_EXPR_UNRESOLVED_SLOT;
+}
+
+
 bohIdentifierExpr* bohIdentifierExprAssign(bohIdentifierExpr* pDst, const bohIdentifierExpr* pSrc)
 {
     BOH_ASSERT(pDst);
@@ -444,6 +698,9 @@ bohIdentifierExpr* bohIdentifierExprAssign(bohIdentifierExpr* pDst, const bohIde
 
     bohStringViewAssignStringViewPtr(&pDst->name, &pSrc->name);
 
+    pDst->depth = pSrc->depth;
+    pDst->slot = pSrc->slot;
+
     return pDst;
 }
 
@@ -455,126 +712,307 @@ bohIdentifierExpr* bohIdentifierExprMove(bohIdentifierExpr* pDst, bohIdentifierE
 
     bohStringViewMove(&pDst->name, &pSrc->name);
 
+    pDst->depth = pSrc->depth;
+    pDst->slot = pSrc->slot;
+
+    pSrc->depth = 0;
+    pSrc->slot = BOH_IDENTIFIER_EXPR_UNRESOLVED_SLOT;
+
     return pDst;
 }
 
 
-static void bohExprSetLineColumnNmb(bohExpr* pExpr, bohLineNmb line, bohColumnNmb column)
+void bohCallExprDestroy(bohCallExpr* pExpr)
 {
     BOH_ASSERT(pExpr);
 
-    pExpr->line = line;
-    pExpr->column = column;
+    bohStringViewReset(&pExpr->name);
+    bohExprPtrSmallVecDestroy(&pExpr->argExprPtrs);
+
+    pExpr->pFuncStmt = NULL;
 }
 
 
-void bohExprDestroy(bohExpr* pExpr)
+void bohCallExprCreateInPlace(bohCallExpr* pExpr, const bohStringView* pName, bohExprPtrSmallVec* pArgExprPtrs)
 {
     BOH_ASSERT(pExpr);
+    BOH_ASSERT(pName);
+    BOH_ASSERT(pArgExprPtrs);
 
-    switch (pExpr->type) {
-        case BOH_EXPR_TYPE_VALUE:
-            bohValueExprDestroy(&pExpr->valueExpr);
-            break;
-        case BOH_EXPR_TYPE_UNARY:
-            bohUnaryExprDestroy(&pExpr->unaryExpr);
-            break;
-        case BOH_EXPR_TYPE_BINARY:
-            bohBinaryExprDestroy(&pExpr->binaryExpr);
-            break;
-        case BOH_EXPR_TYPE_IDENTIFIER:
-            bohIdentifierExprDestroy(&pExpr->identifierExpr);
-            break;
-        default:
-            BOH_ASSERT_FAIL("Invalid expression type");
-            break;
-    }
+    bohStringViewAssignStringViewPtr(&pExpr->name, pName);
 
-    pExpr->type = BOH_EXPR_TYPE_VALUE;
-    bohExprSetLineColumnNmb(pExpr, 0, 0);
+    pExpr->argExprPtrs = bohExprPtrSmallVecCreate();
+    bohExprPtrSmallVecMove(&pExpr->argExprPtrs, pArgExprPtrs);
+
+    pExpr->pFuncStmt = NULL;
 }
 
 
-void bohExprCreateNumberValueExprInPlace(bohExpr* pExpr, bohNumber number, bohLineNmb line, bohColumnNmb column)
+const bohStringView* bohCallExprGetName(const bohCallExpr* pExpr)
 {
-    bohExprCreateNumberValueExprPtrInPlace(pExpr, &number, line, column);
+    BOH_ASSERT(pExpr);
+    return &pExpr->name;
 }
 
 
-void bohExprCreateNumberValueExprPtrInPlace(bohExpr* pExpr, const bohNumber* pNumber, bohLineNmb line, bohColumnNmb column)
+size_t bohCallExprGetArgsCount(const bohCallExpr* pExpr)
 {
     BOH_ASSERT(pExpr);
-
-    pExpr->type = BOH_EXPR_TYPE_VALUE;
-    bohValueExprCreateNumberNumberPtrInPlace(&pExpr->valueExpr, pNumber);
-    bohExprSetLineColumnNmb(pExpr, line, column);
+    return bohExprPtrSmallVecGetSize(&pExpr->argExprPtrs);
 }
 
 
-void bohExprCreateStringValueExprInPlace(bohExpr* pExpr, const bohBoharesString* pString, bohLineNmb line, bohColumnNmb column)
+const bohExpr* bohCallExprGetArgAt(const bohCallExpr* pExpr, size_t index)
 {
     BOH_ASSERT(pExpr);
-
-    pExpr->type = BOH_EXPR_TYPE_VALUE;
-    bohValueExprCreateStringStringPtrInPlace(&pExpr->valueExpr, pString);
-    bohExprSetLineColumnNmb(pExpr, line, column);
+    return *bohExprPtrSmallVecAtConst(&pExpr->argExprPtrs, index);
 }
 
 
-void bohExprCreateStringValueExprMoveInPlace(bohExpr* pExpr, bohBoharesString* pString, bohLineNmb line, bohColumnNmb column)
+void bohCallExprSetFuncStmt(bohCallExpr* pExpr, const bohStmt* pFuncStmt)
 {
     BOH_ASSERT(pExpr);
+    BOH_ASSERT(pFuncStmt);
 
-    pExpr->type = BOH_EXPR_TYPE_VALUE;
-    bohValueExprCreateStringStringMoveInPlace(&pExpr->valueExpr, pString);
-    bohExprSetLineColumnNmb(pExpr, line, column);
+    pExpr->pFuncStmt = pFuncStmt;
 }
 
 
-void bohExprCreateUnaryExprInPlace(bohExpr* pExpr, bohExprOperator op, bohExpr* pArgExpr, bohLineNmb line, bohColumnNmb column)
+const bohStmt* bohCallExprGetFuncStmt(const bohCallExpr* pExpr)
 {
     BOH_ASSERT(pExpr);
-
-    pExpr->type = BOH_EXPR_TYPE_UNARY;
-    bohUnaryExprCreateOpExprInPlace(&pExpr->unaryExpr, op, pArgExpr);
-    bohExprSetLineColumnNmb(pExpr, line, column);
+    return pExpr->pFuncStmt;
 }
 
 
-void bohExprCreateBinaryExprInPlace(bohExpr* pExpr, bohExprOperator op, bohExpr* pLeftArgExpr, bohExpr* pRightArgExpr, bohLineNmb line, bohColumnNmb column)
+bohCallExpr* bohCallExprAssign(bohCallExpr* pDst, const bohCallExpr* pSrc)
 {
-    BOH_ASSERT(pExpr);
-    BOH_ASSERT(pLeftArgExpr);
-    BOH_ASSERT(pRightArgExpr);
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
 
-    pExpr->type = BOH_EXPR_TYPE_BINARY;
-    bohBinaryExprCreateOpExprInPlace(&pExpr->binaryExpr, op, pLeftArgExpr, pRightArgExpr);
-    bohExprSetLineColumnNmb(pExpr, line, column);
+    bohStringViewAssignStringViewPtr(&pDst->name, &pSrc->name);
+    bohExprPtrSmallVecAssign(&pDst->argExprPtrs, &pSrc->argExprPtrs);
+
+    pDst->pFuncStmt = pSrc->pFuncStmt;
+
+    return pDst;
 }
 
 
-void bohExprCreateIdentifierExprInPlace(bohExpr* pExpr, const bohStringView* pName, bohLineNmb line, bohColumnNmb column)
+bohCallExpr* bohCallExprMove(bohCallExpr* pDst, bohCallExpr* pSrc)
 {
-    BOH_ASSERT(pExpr);
-    BOH_ASSERT(pName);
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
 
-    pExpr->type = BOH_EXPR_TYPE_IDENTIFIER;
-    bohIdentifierExprCreateInPlace(&pExpr->identifierExpr, pName);
-    bohExprSetLineColumnNmb(pExpr, line, column);
+    bohStringViewMove(&pDst->name, &pSrc->name);
+    bohExprPtrSmallVecMove(&pDst->argExprPtrs, &pSrc->argExprPtrs);
+
+    pDst->pFuncStmt = pSrc->pFuncStmt;
+    pSrc->pFuncStmt = NULL;
+
+    return pDst;
 }
 
 
-bool bohExprIsValueExpr(const bohExpr* pExpr)
+void bohIndexExprDestroy(bohIndexExpr* pExpr)
 {
     BOH_ASSERT(pExpr);
-    return pExpr->type == BOH_EXPR_TYPE_VALUE;
+
+    pExpr->pObjectExpr = NULL;
+    pExpr->pBeginExpr = NULL;
+    pExpr->pEndExpr = NULL;
+    pExpr->isSlice = false;
 }
 
 
-bool bohExprIsUnaryExpr(const bohExpr* pExpr)
+void bohIndexExprCreateInPlace(bohIndexExpr* pExpr, const bohExpr* pObjectExpr, const bohExpr* pBeginExpr, const bohExpr* pEndExpr, bool isSlice)
 {
     BOH_ASSERT(pExpr);
-    return pExpr->type == BOH_EXPR_TYPE_UNARY;
+    BOH_ASSERT(pObjectExpr);
+    BOH_ASSERT(isSlice || pBeginExpr);
+    BOH_ASSERT(isSlice || !pEndExpr);
+
+    pExpr->pObjectExpr = pObjectExpr;
+    pExpr->pBeginExpr = pBeginExpr;
+    pExpr->pEndExpr = pEndExpr;
+    pExpr->isSlice = isSlice;
+}
+
+
+const bohExpr* bohIndexExprGetObjectExpr(const bohIndexExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->pObjectExpr;
+}
+
+
+const bohExpr* bohIndexExprGetBeginExpr(const bohIndexExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->pBeginExpr;
+}
+
+
+const bohExpr* bohIndexExprGetEndExpr(const bohIndexExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->pEndExpr;
+}
+
+
+bool bohIndexExprIsSlice(const bohIndexExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->isSlice;
+}
+
+
+bohIndexExpr* bohIndexExprAssign(bohIndexExpr* pDst, const bohIndexExpr* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    bohIndexExprDestroy(pDst);
+
+    pDst->pObjectExpr = pSrc->pObjectExpr;
+    pDst->pBeginExpr = pSrc->pBeginExpr;
+    pDst->pEndExpr = pSrc->pEndExpr;
+    pDst->isSlice = pSrc->isSlice;
+
+    return pDst;
+}
+
+
+bohIndexExpr* bohIndexExprMove(bohIndexExpr* pDst, bohIndexExpr* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    bohIndexExprAssign(pDst, pSrc);
+    bohIndexExprDestroy(pSrc);
+
+    return pDst;
+}
+
+
+static void bohExprSetLineColumnNmb(bohExpr* pExpr, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pExpr);
+
+    pExpr->line = line;
+    pExpr->column = column;
+}
+
+
+void bohExprDestroy(bohExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+
+    switch (pExpr->type) {
+        case BOH_EXPR_TYPE_VALUE:
+            bohValueExprDestroy(&pExpr->valueExpr);
+            break;
+        case BOH_EXPR_TYPE_UNARY:
+            bohUnaryExprDestroy(&pExpr->unaryExpr);
+            break;
+        case BOH_EXPR_TYPE_BINARY:
+            bohBinaryExprDestroy(&pExpr->binaryExpr);
+            break;
+        case BOH_EXPR_TYPE_IDENTIFIER:
+            bohIdentifierExprDestroy(&pExpr->identifierExpr);
+            break;
+        case BOH_EXPR_TYPE_CALL:
+            bohCallExprDestroy(&pExpr->callExpr);
+            break;
+        case BOH_EXPR_TYPE_INDEX:
+            bohIndexExprDestroy(&pExpr->indexExpr);
+            break;
+        default:
+            BOH_ASSERT_FAIL("Invalid expression type");
+            break;
+    }
+
+    pExpr->type = BOH_EXPR_TYPE_VALUE;
+    bohExprSetLineColumnNmb(pExpr, 0, 0);
+}
+
+
+void bohExprCreateValueExprInPlace(bohExpr* pExpr, bohConstantIdx constantIdx, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pExpr);
+
+    pExpr->type = BOH_EXPR_TYPE_VALUE;
+    bohValueExprCreateInPlace(&pExpr->valueExpr, constantIdx);
+    bohExprSetLineColumnNmb(pExpr, line, column);
+}
+
+
+void bohExprCreateUnaryExprInPlace(bohExpr* pExpr, bohExprOperator op, bohExpr* pArgExpr, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pExpr);
+
+    pExpr->type = BOH_EXPR_TYPE_UNARY;
+    bohUnaryExprCreateOpExprInPlace(&pExpr->unaryExpr, op, pArgExpr);
+    bohExprSetLineColumnNmb(pExpr, line, column);
+}
+
+
+void bohExprCreateBinaryExprInPlace(bohExpr* pExpr, bohExprOperator op, bohExpr* pLeftArgExpr, bohExpr* pRightArgExpr, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pExpr);
+    BOH_ASSERT(pLeftArgExpr);
+    BOH_ASSERT(pRightArgExpr);
+
+    pExpr->type = BOH_EXPR_TYPE_BINARY;
+    bohBinaryExprCreateOpExprInPlace(&pExpr->binaryExpr, op, pLeftArgExpr, pRightArgExpr);
+    bohExprSetLineColumnNmb(pExpr, line, column);
+}
+
+
+void bohExprCreateIdentifierExprInPlace(bohExpr* pExpr, const bohStringView* pName, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pExpr);
+    BOH_ASSERT(pName);
+
+    pExpr->type = BOH_EXPR_TYPE_IDENTIFIER;
+    bohIdentifierExprCreateInPlace(&pExpr->identifierExpr, pName);
+    bohExprSetLineColumnNmb(pExpr, line, column);
+}
+
+
+void bohExprCreateCallExprInPlace(bohExpr* pExpr, const bohStringView* pName, bohExprPtrSmallVec* pArgExprPtrs, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pExpr);
+    BOH_ASSERT(pName);
+
+    pExpr->type = BOH_EXPR_TYPE_CALL;
+    bohCallExprCreateInPlace(&pExpr->callExpr, pName, pArgExprPtrs);
+    bohExprSetLineColumnNmb(pExpr, line, column);
+}
+
+
+void bohExprCreateIndexExprInPlace(bohExpr* pExpr, const bohExpr* pObjectExpr, const bohExpr* pBeginExpr, const bohExpr* pEndExpr, 
+    bool isSlice, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pExpr);
+
+    pExpr->type = BOH_EXPR_TYPE_INDEX;
+    bohIndexExprCreateInPlace(&pExpr->indexExpr, pObjectExpr, pBeginExpr, pEndExpr, isSlice);
+    bohExprSetLineColumnNmb(pExpr, line, column);
+}
+
+
+bool bohExprIsValueExpr(const bohExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->type == BOH_EXPR_TYPE_VALUE;
+}
+
+
+bool bohExprIsUnaryExpr(const bohExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->type == BOH_EXPR_TYPE_UNARY;
 }
 
 
@@ -592,6 +1030,20 @@ bool bohExprIsIdentifierExpr(const bohExpr *pExpr)
 }
 
 
+bool bohExprIsCallExpr(const bohExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->type == BOH_EXPR_TYPE_CALL;
+}
+
+
+bool bohExprIsIndexExpr(const bohExpr* pExpr)
+{
+    BOH_ASSERT(pExpr);
+    return pExpr->type == BOH_EXPR_TYPE_INDEX;
+}
+
+
 const bohValueExpr* bohExprGetValueExpr(const bohExpr* pExpr)
 {
     BOH_ASSERT(bohExprIsValueExpr(pExpr));
@@ -619,6 +1071,20 @@ const bohIdentifierExpr* bohExprGetIdentifierExpr(const bohExpr* pExpr)
 }
 
 
+const bohCallExpr* bohExprGetCallExpr(const bohExpr* pExpr)
+{
+    BOH_ASSERT(bohExprIsCallExpr(pExpr));
+    return &pExpr->callExpr;
+}
+
+
+const bohIndexExpr* bohExprGetIndexExpr(const bohExpr* pExpr)
+{
+    BOH_ASSERT(bohExprIsIndexExpr(pExpr));
+    return &pExpr->indexExpr;
+}
+
+
 bohExprType bohExprGetType(const bohExpr* pExpr)
 {
     BOH_ASSERT(pExpr);
@@ -662,254 +1128,819 @@ bohExpr* bohExprAssign(bohExpr* pDst, const bohExpr* pSrc)
         case BOH_EXPR_TYPE_IDENTIFIER:
             bohIdentifierExprAssign(&pDst->identifierExpr, &pSrc->identifierExpr);
             break;
+        case BOH_EXPR_TYPE_CALL:
+            bohCallExprAssign(&pDst->callExpr, &pSrc->callExpr);
+            break;
+        case BOH_EXPR_TYPE_INDEX:
+            bohIndexExprAssign(&pDst->indexExpr, &pSrc->indexExpr);
+            break;
+        default:
+            BOH_ASSERT_FAIL("Invalid expression type");
+            break;
+    }
+
+    bohExprSetLineColumnNmb(pDst, pSrc->line, pSrc->column);
+
+    return pDst;
+}
+
+
+bohExpr* bohExprMove(bohExpr* pDst, bohExpr* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    bohExprDestroy(pDst);
+
+    pDst->type = pSrc->type;
+
+    switch (pSrc->type) {
+        case BOH_EXPR_TYPE_VALUE:
+            bohValueExprMove(&pDst->valueExpr, &pSrc->valueExpr);
+            break;
+        case BOH_EXPR_TYPE_UNARY:
+            bohUnaryExprMove(&pDst->unaryExpr, &pSrc->unaryExpr);
+            break;
+        case BOH_EXPR_TYPE_BINARY:
+            bohBinaryExprMove(&pDst->binaryExpr, &pSrc->binaryExpr);
+            break;
+        case BOH_EXPR_TYPE_IDENTIFIER:
+            bohIdentifierExprMove(&pDst->identifierExpr, &pSrc->identifierExpr);
+            break;
+        case BOH_EXPR_TYPE_CALL:
+            bohCallExprMove(&pDst->callExpr, &pSrc->callExpr);
+            break;
+        case BOH_EXPR_TYPE_INDEX:
+            bohIndexExprMove(&pDst->indexExpr, &pSrc->indexExpr);
+            break;
         default:
             BOH_ASSERT_FAIL("Invalid expression type");
             break;
     }
 
-    bohExprSetLineColumnNmb(pDst, pSrc->line, pSrc->column);
+    pDst->line = pSrc->line;
+    pDst->column = pSrc->column;
+
+    pSrc->type = BOH_EXPR_TYPE_VALUE;
+    bohExprSetLineColumnNmb(pSrc, 0, 0);
+
+    return pDst;
+}
+
+
+void bohPrintStmtDestroy(bohPrintStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    pStmt->pArgExpr = NULL;
+}
+
+
+void bohPrintStmtCreateInPlace(bohPrintStmt* pStmt, const bohExpr* pArgExpr)
+{
+    BOH_ASSERT(pStmt);
+    BOH_ASSERT(pArgExpr);
+
+    pStmt->pArgExpr = pArgExpr;
+}
+
+
+const bohExpr* bohPrintStmtGetArgExpr(const bohPrintStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->pArgExpr;
+}
+
+
+bohPrintStmt* bohPrintStmtAssign(bohPrintStmt* pDst, const bohPrintStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    bohPrintStmtDestroy(pDst);
+    pDst->pArgExpr = pSrc->pArgExpr;
+
+    return pDst;
+}
+
+
+bohPrintStmt* bohPrintStmtMove(bohPrintStmt* pDst, bohPrintStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    bohPrintStmtAssign(pDst, pSrc);
+    pSrc->pArgExpr = NULL;
+
+    return pDst;
+}
+
+
+bohStmtSpan bohStmtSpanCreate(void)
+{
+    bohStmtSpan span;
+
+    span.ppStmts = NULL;
+    span.size = 0;
+
+    return span;
+}
+
+
+bohStmtSpan bohStmtSpanCreateSized(const bohStmt* const* ppStmts, size_t size)
+{
+    BOH_ASSERT(ppStmts || size == 0);
+
+    bohStmtSpan span;
+
+    span.ppStmts = ppStmts;
+    span.size = size;
+
+    return span;
+}
+
+
+void bohStmtSpanReset(bohStmtSpan* pSpan)
+{
+    BOH_ASSERT(pSpan);
+
+    pSpan->ppStmts = NULL;
+    pSpan->size = 0;
+}
+
+
+const bohStmt* const* bohStmtSpanGetData(const bohStmtSpan* pSpan)
+{
+    BOH_ASSERT(pSpan);
+    return pSpan->ppStmts;
+}
+
+
+size_t bohStmtSpanGetSize(const bohStmtSpan* pSpan)
+{
+    BOH_ASSERT(pSpan);
+    return pSpan->size;
+}
+
+
+bool bohStmtSpanIsEmpty(const bohStmtSpan* pSpan)
+{
+    BOH_ASSERT(pSpan);
+    return pSpan->size == 0;
+}
+
+
+const bohStmt* bohStmtSpanAt(const bohStmtSpan* pSpan, size_t index)
+{
+    BOH_ASSERT(pSpan);
+    BOH_ASSERT(index < pSpan->size);
+
+    return pSpan->ppStmts[index];
+}
+
+
+void bohIfStmtDestroy(bohIfStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+
+    pStmt->pCondExpr = NULL;
+    bohStmtSpanReset(&pStmt->thenStmts);
+    bohStmtSpanReset(&pStmt->elseStmts);
+}
+
+
+void bohIfStmtCreateInPlace(bohIfStmt* pStmt, const bohExpr* pCondExpr, const bohStmtSpan* pThenStmts, const bohStmtSpan* pElseStmts)
+{
+    BOH_ASSERT(pStmt);
+    BOH_ASSERT(pCondExpr);
+    BOH_ASSERT(pThenStmts);
+    BOH_ASSERT(pElseStmts);
+
+    pStmt->pCondExpr = pCondExpr;
+    pStmt->thenStmts = *pThenStmts;
+    pStmt->elseStmts = *pElseStmts;
+}
+
+
+const bohExpr* bohIfStmtGetCondExpr(const bohIfStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->pCondExpr;
+}
+
+
+const bohStmtSpan* bohIfStmtGetThenStmts(const bohIfStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return &pStmt->thenStmts;
+}
+
+
+const bohStmtSpan* bohIfStmtGetElseStmts(const bohIfStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return &pStmt->elseStmts;
+}
+
+
+size_t bohIfStmtGetThenStmtsCount(const bohIfStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return bohStmtSpanGetSize(&pStmt->thenStmts);
+}
+
+
+size_t bohIfStmtGetElseStmtsCount(const bohIfStmt *pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return bohStmtSpanGetSize(&pStmt->elseStmts);
+}
+
+
+const bohStmt* bohIfStmtGetThenStmtAt(const bohIfStmt* pStmt, size_t index)
+{
+    BOH_ASSERT(pStmt);
+    return bohStmtSpanAt(&pStmt->thenStmts, index);
+}
+
+
+const bohStmt* bohIfStmtGetElseStmtAt(const bohIfStmt* pStmt, size_t index)
+{
+    BOH_ASSERT(pStmt);
+    return bohStmtSpanAt(&pStmt->elseStmts, index);
+}
+
+
+bohIfStmt* bohIfStmtAssign(bohIfStmt* pDst, const bohIfStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    pDst->pCondExpr = pSrc->pCondExpr;
+    pDst->thenStmts = pSrc->thenStmts;
+    pDst->elseStmts = pSrc->elseStmts;
+
+    return pDst;
+}
+
+
+bohIfStmt* bohIfStmtMove(bohIfStmt* pDst, bohIfStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    pDst->pCondExpr = pSrc->pCondExpr;
+    pDst->thenStmts = pSrc->thenStmts;
+    pDst->elseStmts = pSrc->elseStmts;
+
+    pSrc->pCondExpr = NULL;
+    bohStmtSpanReset(&pSrc->thenStmts);
+    bohStmtSpanReset(&pSrc->elseStmts);
+
+    return pDst;
+}
+
+
+void bohAssignmentStmtDestroy(bohAssignmentStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+
+    pStmt->pLeft = NULL;
+    pStmt->pRight = NULL;
+    pStmt->op = BOH_OP_UNKNOWN;
+}
+
+
+void bohAssignmentStmtCreateInPlace(bohAssignmentStmt* pStmt, const bohExpr* pLeft, const bohExpr* pRight, bohExprOperator op)
+{
+    BOH_ASSERT(pStmt);
+    BOH_ASSERT(op == BOH_OP_UNKNOWN || bohParsIsCompoundAssignExprOperator(op));
+
+    pStmt->pLeft = pLeft;
+    pStmt->pRight = pRight;
+    pStmt->op = op;
+}
+
+
+const bohExpr* bohAssignmentStmtGetLeftExpr(const bohAssignmentStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->pLeft;
+}
+
+
+const bohExpr* bohAssignmentStmtGetRightExpr(const bohAssignmentStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->pRight;
+}
+
+
+bohExprOperator bohAssignmentStmtGetOperator(const bohAssignmentStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->op;
+}
+
+
+bool bohAssignmentStmtIsCompound(const bohAssignmentStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->op != BOH_OP_UNKNOWN;
+}
+
+
+bohAssignmentStmt* bohAssignmentStmtAssign(bohAssignmentStmt* pDst, const bohAssignmentStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    pDst->pLeft = pSrc->pLeft;
+    pDst->pRight = pSrc->pRight;
+    pDst->op = pSrc->op;
+
+    return pDst;
+}
+
+
+bohAssignmentStmt* bohAssignmentStmtMove(bohAssignmentStmt* pDst, bohAssignmentStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    pDst->pLeft = pSrc->pLeft;
+    pDst->pRight = pSrc->pRight;
+    pDst->op = pSrc->op;
+
+    pSrc->pLeft = NULL;
+    pSrc->pRight = NULL;
+    pSrc->op = BOH_OP_UNKNOWN;
+    
+    return pDst;
+}
+
+
+void bohFuncStmtDestroy(bohFuncStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+
+    bohStringViewReset(&pStmt->name);
+    bohStringViewSmallVecDestroy(&pStmt->paramNames);
+    bohStmtSpanReset(&pStmt->bodyStmts);
+
+    pStmt->frameSlotsCount = 0;
+}
+
+
+void bohFuncStmtCreateInPlace(bohFuncStmt* pStmt, const bohStringView* pName, bohStringViewSmallVec* pParamNames, const bohStmtSpan* pBodyStmts)
+{
+    BOH_ASSERT(pStmt);
+    BOH_ASSERT(pName);
+    BOH_ASSERT(pBodyStmts);
+
+    bohStringViewAssignStringViewPtr(&pStmt->name, pName);
+    pStmt->paramNames = bohStringViewSmallVecCreate();
+    bohStringViewSmallVecMove(&pStmt->paramNames, pParamNames);
+    pStmt->bodyStmts = *pBodyStmts;
+
+    pStmt->frameSlotsCount = (uint32_t)bohStringViewSmallVecGetSize(&pStmt->paramNames);
+}
+
+
+const bohStringView* bohFuncStmtGetName(const bohFuncStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return &pStmt->name;
+}
+
+
+size_t bohFuncStmtGetParamsCount(const bohFuncStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return bohStringViewSmallVecGetSize(&pStmt->paramNames);
+}
+
+
+const bohStringView* bohFuncStmtGetParamNameAt(const bohFuncStmt* pStmt, size_t index)
+{
+    BOH_ASSERT(pStmt);
+    return bohStringViewSmallVecAtConst(&pStmt->paramNames, index);
+}
+
+
+const bohStmtSpan* bohFuncStmtGetBodyStmts(const bohFuncStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return &pStmt->bodyStmts;
+}
+
+
+size_t bohFuncStmtGetBodyStmtsCount(const bohFuncStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return bohStmtSpanGetSize(&pStmt->bodyStmts);
+}
+
+
+const bohStmt* bohFuncStmtGetBodyStmtAt(const bohFuncStmt* pStmt, size_t index)
+{
+    BOH_ASSERT(pStmt);
+    return bohStmtSpanAt(&pStmt->bodyStmts, index);
+}
+
+
+void bohFuncStmtSetFrameSlotsCount(bohFuncStmt* pStmt, uint32_t slotsCount)
+{
+    BOH_ASSERT(pStmt);
+    BOH_ASSERT(slotsCount >= bohFuncStmtGetParamsCount(pStmt));
+
+    pStmt->frameSlotsCount = slotsCount;
+}
+
+
+uint32_t bohFuncStmtGetFrameSlotsCount(const bohFuncStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->frameSlotsCount;
+}
+
+
+bohFuncStmt* bohFuncStmtAssign(bohFuncStmt* pDst, const bohFuncStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    bohStringViewAssignStringViewPtr(&pDst->name, &pSrc->name);
+    bohStringViewSmallVecAssign(&pDst->paramNames, &pSrc->paramNames);
+    pDst->bodyStmts = pSrc->bodyStmts;
+
+    pDst->frameSlotsCount = pSrc->frameSlotsCount;
+
+    return pDst;
+}
+
+
+bohFuncStmt* bohFuncStmtMove(bohFuncStmt* pDst, bohFuncStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    bohStringViewMove(&pDst->name, &pSrc->name);
+    bohStringViewSmallVecMove(&pDst->paramNames, &pSrc->paramNames);
+    pDst->bodyStmts = pSrc->bodyStmts;
+    bohStmtSpanReset(&pSrc->bodyStmts);
+
+    pDst->frameSlotsCount = pSrc->frameSlotsCount;
+    pSrc->frameSlotsCount = 0;
+
+    return pDst;
+}
+
+
+void bohReturnStmtDestroy(bohReturnStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    pStmt->pValueExpr = NULL;
+}
+
+
+void bohReturnStmtCreateInPlace(bohReturnStmt* pStmt, const bohExpr* pValueExpr)
+{
+    BOH_ASSERT(pStmt);
+    pStmt->pValueExpr = pValueExpr;
+}
 
-    return pDst;
+
+const bohExpr* bohReturnStmtGetValueExpr(const bohReturnStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->pValueExpr;
 }
 
 
-bohExpr* bohExprMove(bohExpr* pDst, bohExpr* pSrc)
+bool bohReturnStmtIsTailCall(const bohReturnStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->pValueExpr && bohExprIsCallExpr(pStmt->pValueExpr);
+}
+
+
+bohReturnStmt* bohReturnStmtAssign(bohReturnStmt* pDst, const bohReturnStmt* pSrc)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
-    bohExprDestroy(pDst);
-
-    pDst->type = pSrc->type;
+    pDst->pValueExpr = pSrc->pValueExpr;
 
-    switch (pSrc->type) {
-        case BOH_EXPR_TYPE_VALUE:
-            bohValueExprMove(&pDst->valueExpr, &pSrc->valueExpr);
-            break;
-        case BOH_EXPR_TYPE_UNARY:
-            bohUnaryExprMove(&pDst->unaryExpr, &pSrc->unaryExpr);
-            break;
-        case BOH_EXPR_TYPE_BINARY:
-            bohBinaryExprMove(&pDst->binaryExpr, &pSrc->binaryExpr);
-            break;
-        case BOH_EXPR_TYPE_IDENTIFIER:
-            bohIdentifierExprMove(&pDst->identifierExpr, &pSrc->identifierExpr);
-            break;
-        default:
-            BOH_ASSERT_FAIL("Invalid expression type");
-            break;
-    }
+    return pDst;
+}
 
-    pDst->line = pSrc->line;
-    pDst->column = pSrc->column;
 
-    pSrc->type = BOH_EXPR_TYPE_VALUE;
-    bohExprSetLineColumnNmb(pSrc, 0, 0);
+bohReturnStmt* bohReturnStmtMove(bohReturnStmt* pDst, bohReturnStmt* pSrc)
+{
+    bohReturnStmtAssign(pDst, pSrc);
+    pSrc->pValueExpr = NULL;
 
     return pDst;
 }
 
 
-void bohPrintStmtDestroy(bohPrintStmt* pStmt)
+void bohExprStmtDestroy(bohExprStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    pStmt->pArgExpr = NULL;
+    pStmt->pExpr = NULL;
 }
 
 
-void bohPrintStmtCreateInPlace(bohPrintStmt* pStmt, const bohExpr* pArgExpr)
+void bohExprStmtCreateInPlace(bohExprStmt* pStmt, const bohExpr* pExpr)
 {
     BOH_ASSERT(pStmt);
-    BOH_ASSERT(pArgExpr);
+    BOH_ASSERT(pExpr);
 
-    pStmt->pArgExpr = pArgExpr;
+    pStmt->pExpr = pExpr;
 }
 
 
-const bohExpr* bohPrintStmtGetArgExpr(const bohPrintStmt* pStmt)
+const bohExpr* bohExprStmtGetExpr(const bohExprStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    return pStmt->pArgExpr;
+    return pStmt->pExpr;
 }
 
 
-bohPrintStmt* bohPrintStmtAssign(bohPrintStmt* pDst, const bohPrintStmt* pSrc)
+bohExprStmt* bohExprStmtAssign(bohExprStmt* pDst, const bohExprStmt* pSrc)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
-    bohPrintStmtDestroy(pDst);
-    pDst->pArgExpr = pSrc->pArgExpr;
+    pDst->pExpr = pSrc->pExpr;
 
     return pDst;
 }
 
 
-bohPrintStmt* bohPrintStmtMove(bohPrintStmt* pDst, bohPrintStmt* pSrc)
+bohExprStmt* bohExprStmtMove(bohExprStmt* pDst, bohExprStmt* pSrc)
 {
-    BOH_ASSERT(pDst);
-    BOH_ASSERT(pSrc);
-
-    bohPrintStmtAssign(pDst, pSrc);
-    pSrc->pArgExpr = NULL;
+    bohExprStmtAssign(pDst, pSrc);
+    pSrc->pExpr = NULL;
 
     return pDst;
 }
 
 
-void bohIfStmtDestroy(bohIfStmt* pStmt)
+void bohWhileStmtDestroy(bohWhileStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
 
     pStmt->pCondExpr = NULL;
-    bohDynArrayDestroy(&pStmt->thenStmtPtrs);
-    bohDynArrayDestroy(&pStmt->elseStmtPtrs);
+    bohStmtSpanReset(&pStmt->bodyStmts);
+    pStmt->isDoWhile = false;
 }
 
 
-void bohIfStmtCreateInPlace(bohIfStmt* pStmt, const bohExpr* pCondExpr, bohDynArray* pThenStmtPtrs, bohDynArray* pElseStmtPtrs)
+void bohWhileStmtCreateInPlace(bohWhileStmt* pStmt, const bohExpr* pCondExpr, const bohStmtSpan* pBodyStmts, bool isDoWhile)
 {
     BOH_ASSERT(pStmt);
     BOH_ASSERT(pCondExpr);
+    BOH_ASSERT(pBodyStmts);
 
     pStmt->pCondExpr = pCondExpr;
-    bohDynArrayMove(&pStmt->thenStmtPtrs, pThenStmtPtrs);
-    bohDynArrayMove(&pStmt->elseStmtPtrs, pElseStmtPtrs);
+    pStmt->bodyStmts = *pBodyStmts;
+    pStmt->isDoWhile = isDoWhile;
 }
 
 
-const bohExpr* bohIfStmtGetCondExpr(const bohIfStmt* pStmt)
+const bohExpr* bohWhileStmtGetCondExpr(const bohWhileStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
     return pStmt->pCondExpr;
 }
 
 
-const bohDynArray* bohIfStmtGetThenStmts(const bohIfStmt* pStmt)
+const bohStmtSpan* bohWhileStmtGetBodyStmts(const bohWhileStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    return &pStmt->thenStmtPtrs;
+    return &pStmt->bodyStmts;
 }
 
 
-const bohDynArray* bohIfStmtGetElseStmts(const bohIfStmt* pStmt)
+bool bohWhileStmtIsDoWhile(const bohWhileStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    return &pStmt->elseStmtPtrs;
+    return pStmt->isDoWhile;
 }
 
 
-size_t bohIfStmtGetThenStmtsCount(const bohIfStmt* pStmt)
+bohWhileStmt* bohWhileStmtAssign(bohWhileStmt* pDst, const bohWhileStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    pDst->pCondExpr = pSrc->pCondExpr;
+    pDst->bodyStmts = pSrc->bodyStmts;
+    pDst->isDoWhile = pSrc->isDoWhile;
+
+    return pDst;
+}
+
+
+bohWhileStmt* bohWhileStmtMove(bohWhileStmt* pDst, bohWhileStmt* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    pDst->pCondExpr = pSrc->pCondExpr;
+    pDst->bodyStmts = pSrc->bodyStmts;
+    bohStmtSpanReset(&pSrc->bodyStmts);
+    pDst->isDoWhile = pSrc->isDoWhile;
+
+    pSrc->pCondExpr = NULL;
+    pSrc->isDoWhile = false;
+
+    return pDst;
+}
+
+
+void bohForStmtDestroy(bohForStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    return bohDynArrayGetSize(&pStmt->thenStmtPtrs);
+
+    pStmt->pInitStmt = NULL;
+    pStmt->pCondExpr = NULL;
+    pStmt->pStepStmt = NULL;
+    bohStmtSpanReset(&pStmt->bodyStmts);
 }
 
 
-size_t bohIfStmtGetElseStmtsCount(const bohIfStmt *pStmt)
+void bohForStmtCreateInPlace(bohForStmt* pStmt, const bohStmt* pInitStmt, const bohExpr* pCondExpr, const bohStmt* pStepStmt, const bohStmtSpan* pBodyStmts)
 {
     BOH_ASSERT(pStmt);
-    return bohDynArrayGetSize(&pStmt->elseStmtPtrs);
+    BOH_ASSERT(pBodyStmts);
+
+    pStmt->pInitStmt = pInitStmt;
+    pStmt->pCondExpr = pCondExpr;
+    pStmt->pStepStmt = pStepStmt;
+    pStmt->bodyStmts = *pBodyStmts;
 }
 
 
-const bohStmt* bohIfStmtGetThenStmtAt(const bohIfStmt* pStmt, size_t index)
+const bohStmt* bohForStmtGetInitStmt(const bohForStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    return *BOH_DYN_ARRAY_AT_CONST(bohStmt*, &pStmt->thenStmtPtrs, index);
+    return pStmt->pInitStmt;
 }
 
 
-const bohStmt* bohIfStmtGetElseStmtAt(const bohIfStmt* pStmt, size_t index)
+const bohExpr* bohForStmtGetCondExpr(const bohForStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    return *BOH_DYN_ARRAY_AT_CONST(bohStmt*, &pStmt->elseStmtPtrs, index);
+    return pStmt->pCondExpr;
 }
 
 
-bohIfStmt* bohIfStmtAssign(bohIfStmt* pDst, const bohIfStmt* pSrc)
+const bohStmt* bohForStmtGetStepStmt(const bohForStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->pStepStmt;
+}
+
+
+const bohStmtSpan* bohForStmtGetBodyStmts(const bohForStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return &pStmt->bodyStmts;
+}
+
+
+bohForStmt* bohForStmtAssign(bohForStmt* pDst, const bohForStmt* pSrc)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
+    pDst->pInitStmt = pSrc->pInitStmt;
     pDst->pCondExpr = pSrc->pCondExpr;
-    bohDynArrayAssign(&pDst->thenStmtPtrs, &pSrc->thenStmtPtrs);
-    bohDynArrayAssign(&pDst->elseStmtPtrs, &pSrc->elseStmtPtrs);
+    pDst->pStepStmt = pSrc->pStepStmt;
+    pDst->bodyStmts = pSrc->bodyStmts;
 
     return pDst;
 }
 
 
-bohIfStmt* bohIfStmtMove(bohIfStmt* pDst, bohIfStmt* pSrc)
+bohForStmt* bohForStmtMove(bohForStmt* pDst, bohForStmt* pSrc)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
+    pDst->pInitStmt = pSrc->pInitStmt;
     pDst->pCondExpr = pSrc->pCondExpr;
-    bohDynArrayMove(&pDst->thenStmtPtrs, &pSrc->thenStmtPtrs);
-    bohDynArrayMove(&pDst->elseStmtPtrs, &pSrc->elseStmtPtrs);
+    pDst->pStepStmt = pSrc->pStepStmt;
+    pDst->bodyStmts = pSrc->bodyStmts;
+    bohStmtSpanReset(&pSrc->bodyStmts);
 
+    pSrc->pInitStmt = NULL;
     pSrc->pCondExpr = NULL;
+    pSrc->pStepStmt = NULL;
 
     return pDst;
 }
 
 
-void bohAssignmentStmtDestroy(bohAssignmentStmt* pStmt)
+void bohRangeForStmtDestroy(bohRangeForStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
 
-    pStmt->pLeft = NULL;
-    pStmt->pRight = NULL;
+    pStmt->pIteratorExpr = NULL;
+    pStmt->pBeginExpr = NULL;
+    pStmt->pEndExpr = NULL;
+    pStmt->step = 0;
+    bohStmtSpanReset(&pStmt->bodyStmts);
 }
 
 
-void bohAssignmentStmtCreateInPlace(bohAssignmentStmt* pStmt, const bohExpr* pLeft, const bohExpr* pRight)
+void bohRangeForStmtCreateInPlace(bohRangeForStmt* pStmt, const bohExpr* pIteratorExpr, const bohExpr* pBeginExpr, const bohExpr* pEndExpr, 
+    int64_t step, const bohStmtSpan* pBodyStmts)
 {
     BOH_ASSERT(pStmt);
+    BOH_ASSERT(pIteratorExpr && bohExprIsIdentifierExpr(pIteratorExpr));
+    BOH_ASSERT(pBeginExpr);
+    BOH_ASSERT(pEndExpr);
+    BOH_ASSERT(step != 0);
+    BOH_ASSERT(pBodyStmts);
 
-    pStmt->pLeft = pLeft;
-    pStmt->pRight = pRight;
+    pStmt->pIteratorExpr = pIteratorExpr;
+    pStmt->pBeginExpr = pBeginExpr;
+    pStmt->pEndExpr = pEndExpr;
+    pStmt->step = step;
+    pStmt->bodyStmts = *pBodyStmts;
 }
 
 
-const bohExpr* bohAssignmentStmtGetLeftExpr(const bohAssignmentStmt* pStmt)
+const bohExpr* bohRangeForStmtGetIteratorExpr(const bohRangeForStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    return pStmt->pLeft;
+    return pStmt->pIteratorExpr;
 }
 
 
-const bohExpr* bohAssignmentStmtGetRightExpr(const bohAssignmentStmt* pStmt)
+const bohExpr* bohRangeForStmtGetBeginExpr(const bohRangeForStmt* pStmt)
 {
     BOH_ASSERT(pStmt);
-    return pStmt->pRight;
+    return pStmt->pBeginExpr;
 }
 
 
-bohAssignmentStmt* bohAssignmentStmtAssign(bohAssignmentStmt* pDst, const bohAssignmentStmt* pSrc)
+const bohExpr* bohRangeForStmtGetEndExpr(const bohRangeForStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->pEndExpr;
+}
+
+
+int64_t bohRangeForStmtGetStep(const bohRangeForStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->step;
+}
+
+
+const bohStmtSpan* bohRangeForStmtGetBodyStmts(const bohRangeForStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return &pStmt->bodyStmts;
+}
+
+
+bohRangeForStmt* bohRangeForStmtAssign(bohRangeForStmt* pDst, const bohRangeForStmt* pSrc)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
-    pDst->pLeft = pSrc->pLeft;
-    pDst->pRight = pSrc->pRight;
+    pDst->pIteratorExpr = pSrc->pIteratorExpr;
+    pDst->pBeginExpr = pSrc->pBeginExpr;
+    pDst->pEndExpr = pSrc->pEndExpr;
+    pDst->step = pSrc->step;
+    pDst->bodyStmts = pSrc->bodyStmts;
 
     return pDst;
 }
 
 
-bohAssignmentStmt* bohAssignmentStmtMove(bohAssignmentStmt* pDst, bohAssignmentStmt* pSrc)
+bohRangeForStmt* bohRangeForStmtMove(bohRangeForStmt* pDst, bohRangeForStmt* pSrc)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
-    pDst->pLeft = pSrc->pLeft;
-    pDst->pRight = pSrc->pRight;
+    pDst->pIteratorExpr = pSrc->pIteratorExpr;
+    pDst->pBeginExpr = pSrc->pBeginExpr;
+    pDst->pEndExpr = pSrc->pEndExpr;
+    pDst->step = pSrc->step;
+    pDst->bodyStmts = pSrc->bodyStmts;
+    bohStmtSpanReset(&pSrc->bodyStmts);
+
+    pSrc->pIteratorExpr = NULL;
+    pSrc->pBeginExpr = NULL;
+    pSrc->pEndExpr = NULL;
+    pSrc->step = 0;
 
-    pSrc->pLeft = NULL;
-    pSrc->pRight = NULL;
-    
     return pDst;
 }
 
@@ -939,6 +1970,24 @@ void bohStmtDestroy(bohStmt* pStmt)
         case BOH_STMT_TYPE_ASSIGNMENT:
             bohAssignmentStmtDestroy(&pStmt->assignStmt);
             break;
+        case BOH_STMT_TYPE_FUNC:
+            bohFuncStmtDestroy(&pStmt->funcStmt);
+            break;
+        case BOH_STMT_TYPE_RETURN:
+            bohReturnStmtDestroy(&pStmt->returnStmt);
+            break;
+        case BOH_STMT_TYPE_EXPR:
+            bohExprStmtDestroy(&pStmt->exprStmt);
+            break;
+        case BOH_STMT_TYPE_WHILE:
+            bohWhileStmtDestroy(&pStmt->whileStmt);
+            break;
+        case BOH_STMT_TYPE_FOR:
+            bohForStmtDestroy(&pStmt->forStmt);
+            break;
+        case BOH_STMT_TYPE_RANGE_FOR:
+            bohRangeForStmtDestroy(&pStmt->rangeForStmt);
+            break;
         default:
             BOH_ASSERT_FAIL("Invalid statement type");
             break;
@@ -959,22 +2008,83 @@ void bohStmtCreatePrintInPlace(bohStmt* pStmt, const bohExpr* pArgExpr, bohLineN
 }
 
 
-void bohStmtCreateIfInPlace(bohStmt* pStmt, const bohExpr* pCondExpr, bohDynArray* pThenStmtPtrs, bohDynArray* pElseStmtPtrs, bohLineNmb line, bohColumnNmb column)
+void bohStmtCreateIfInPlace(bohStmt* pStmt, const bohExpr* pCondExpr, const bohStmtSpan* pThenStmts, const bohStmtSpan* pElseStmts, bohLineNmb line, bohColumnNmb column)
 {
     BOH_ASSERT(pStmt);
 
     pStmt->type = BOH_STMT_TYPE_IF;
-    bohIfStmtCreateInPlace(&pStmt->ifStmt, pCondExpr, pThenStmtPtrs, pElseStmtPtrs);
+    bohIfStmtCreateInPlace(&pStmt->ifStmt, pCondExpr, pThenStmts, pElseStmts);
     bohStmtSetLineColumnNmb(pStmt, line, column);
 }
 
 
-void bohStmtCreateAssignInPlace(bohStmt* pStmt, const bohExpr* pLeft, const bohExpr* pRight, bohLineNmb line, bohColumnNmb column)
+void bohStmtCreateAssignInPlace(bohStmt* pStmt, const bohExpr* pLeft, const bohExpr* pRight, bohExprOperator op, bohLineNmb line, bohColumnNmb column)
 {
     BOH_ASSERT(pStmt);
 
     pStmt->type = BOH_STMT_TYPE_ASSIGNMENT;
-    bohAssignmentStmtCreateInPlace(&pStmt->assignStmt, pLeft, pRight);
+    bohAssignmentStmtCreateInPlace(&pStmt->assignStmt, pLeft, pRight, op);
+    bohStmtSetLineColumnNmb(pStmt, line, column);
+}
+
+
+void bohStmtCreateFuncInPlace(bohStmt* pStmt, const bohStringView* pName, bohStringViewSmallVec* pParamNames, const bohStmtSpan* pBodyStmts, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pStmt);
+
+    pStmt->type = BOH_STMT_TYPE_FUNC;
+    bohFuncStmtCreateInPlace(&pStmt->funcStmt, pName, pParamNames, pBodyStmts);
+    bohStmtSetLineColumnNmb(pStmt, line, column);
+}
+
+
+void bohStmtCreateReturnInPlace(bohStmt* pStmt, const bohExpr* pValueExpr, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pStmt);
+
+    pStmt->type = BOH_STMT_TYPE_RETURN;
+    bohReturnStmtCreateInPlace(&pStmt->returnStmt, pValueExpr);
+    bohStmtSetLineColumnNmb(pStmt, line, column);
+}
+
+
+void bohStmtCreateExprInPlace(bohStmt* pStmt, const bohExpr* pExpr, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pStmt);
+
+    pStmt->type = BOH_STMT_TYPE_EXPR;
+    bohExprStmtCreateInPlace(&pStmt->exprStmt, pExpr);
+    bohStmtSetLineColumnNmb(pStmt, line, column);
+}
+
+
+void bohStmtCreateWhileInPlace(bohStmt* pStmt, const bohExpr* pCondExpr, const bohStmtSpan* pBodyStmts, bool isDoWhile, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pStmt);
+
+    pStmt->type = BOH_STMT_TYPE_WHILE;
+    bohWhileStmtCreateInPlace(&pStmt->whileStmt, pCondExpr, pBodyStmts, isDoWhile);
+    bohStmtSetLineColumnNmb(pStmt, line, column);
+}
+
+
+void bohStmtCreateForInPlace(bohStmt* pStmt, const bohStmt* pInitStmt, const bohExpr* pCondExpr, const bohStmt* pStepStmt, const bohStmtSpan* pBodyStmts, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pStmt);
+
+    pStmt->type = BOH_STMT_TYPE_FOR;
+    bohForStmtCreateInPlace(&pStmt->forStmt, pInitStmt, pCondExpr, pStepStmt, pBodyStmts);
+    bohStmtSetLineColumnNmb(pStmt, line, column);
+}
+
+
+void bohStmtCreateRangeForInPlace(bohStmt* pStmt, const bohExpr* pIteratorExpr, const bohExpr* pBeginExpr, const bohExpr* pEndExpr, int64_t step, 
+    const bohStmtSpan* pBodyStmts, bohLineNmb line, bohColumnNmb column)
+{
+    BOH_ASSERT(pStmt);
+
+    pStmt->type = BOH_STMT_TYPE_RANGE_FOR;
+    bohRangeForStmtCreateInPlace(&pStmt->rangeForStmt, pIteratorExpr, pBeginExpr, pEndExpr, step, pBodyStmts);
     bohStmtSetLineColumnNmb(pStmt, line, column);
 }
 
@@ -1007,6 +2117,48 @@ bool bohStmtIsAssignment(const bohStmt* pStmt)
 }
 
 
+bool bohStmtIsFunc(const bohStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->type == BOH_STMT_TYPE_FUNC;
+}
+
+
+bool bohStmtIsReturn(const bohStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->type == BOH_STMT_TYPE_RETURN;
+}
+
+
+bool bohStmtIsExpr(const bohStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->type == BOH_STMT_TYPE_EXPR;
+}
+
+
+bool bohStmtIsWhile(const bohStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->type == BOH_STMT_TYPE_WHILE;
+}
+
+
+bool bohStmtIsFor(const bohStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->type == BOH_STMT_TYPE_FOR;
+}
+
+
+bool bohStmtIsRangeFor(const bohStmt* pStmt)
+{
+    BOH_ASSERT(pStmt);
+    return pStmt->type == BOH_STMT_TYPE_RANGE_FOR;
+}
+
+
 const bohPrintStmt* bohStmtGetPrint(const bohStmt* pStmt)
 {
     BOH_ASSERT(bohStmtIsPrint(pStmt));
@@ -1028,6 +2180,48 @@ const bohAssignmentStmt* bohStmtGetAssignment(const bohStmt* pStmt)
 }
 
 
+const bohFuncStmt* bohStmtGetFunc(const bohStmt* pStmt)
+{
+    BOH_ASSERT(bohStmtIsFunc(pStmt));
+    return &pStmt->funcStmt;
+}
+
+
+const bohReturnStmt* bohStmtGetReturn(const bohStmt* pStmt)
+{
+    BOH_ASSERT(bohStmtIsReturn(pStmt));
+    return &pStmt->returnStmt;
+}
+
+
+const bohExprStmt* bohStmtGetExpr(const bohStmt* pStmt)
+{
+    BOH_ASSERT(bohStmtIsExpr(pStmt));
+    return &pStmt->exprStmt;
+}
+
+
+const bohWhileStmt* bohStmtGetWhile(const bohStmt* pStmt)
+{
+    BOH_ASSERT(bohStmtIsWhile(pStmt));
+    return &pStmt->whileStmt;
+}
+
+
+const bohForStmt* bohStmtGetFor(const bohStmt* pStmt)
+{
+    BOH_ASSERT(bohStmtIsFor(pStmt));
+    return &pStmt->forStmt;
+}
+
+
+const bohRangeForStmt* bohStmtGetRangeFor(const bohStmt* pStmt)
+{
+    BOH_ASSERT(bohStmtIsRangeFor(pStmt));
+    return &pStmt->rangeForStmt;
+}
+
+
 bohStmt* bohStmtAssign(bohStmt* pDst, const bohStmt* pSrc)
 {
     BOH_ASSERT(pDst);
@@ -1049,6 +2243,24 @@ bohStmt* bohStmtAssign(bohStmt* pDst, const bohStmt* pSrc)
         case BOH_STMT_TYPE_ASSIGNMENT:
             bohAssignmentStmtAssign(&pDst->assignStmt, &pSrc->assignStmt);
             break;
+        case BOH_STMT_TYPE_FUNC:
+            bohFuncStmtAssign(&pDst->funcStmt, &pSrc->funcStmt);
+            break;
+        case BOH_STMT_TYPE_RETURN:
+            bohReturnStmtAssign(&pDst->returnStmt, &pSrc->returnStmt);
+            break;
+        case BOH_STMT_TYPE_EXPR:
+            bohExprStmtAssign(&pDst->exprStmt, &pSrc->exprStmt);
+            break;
+        case BOH_STMT_TYPE_WHILE:
+            bohWhileStmtAssign(&pDst->whileStmt, &pSrc->whileStmt);
+            break;
+        case BOH_STMT_TYPE_FOR:
+            bohForStmtAssign(&pDst->forStmt, &pSrc->forStmt);
+            break;
+        case BOH_STMT_TYPE_RANGE_FOR:
+            bohRangeForStmtAssign(&pDst->rangeForStmt, &pSrc->rangeForStmt);
+            break;
         default:
             BOH_ASSERT_FAIL("Invalid statement type");
             break;
@@ -1082,6 +2294,24 @@ bohStmt* bohStmtMove(bohStmt* pDst, bohStmt* pSrc)
         case BOH_STMT_TYPE_ASSIGNMENT:
             bohAssignmentStmtMove(&pDst->assignStmt, &pSrc->assignStmt);
             break;
+        case BOH_STMT_TYPE_FUNC:
+            bohFuncStmtMove(&pDst->funcStmt, &pSrc->funcStmt);
+            break;
+        case BOH_STMT_TYPE_RETURN:
+            bohReturnStmtMove(&pDst->returnStmt, &pSrc->returnStmt);
+            break;
+        case BOH_STMT_TYPE_EXPR:
+            bohExprStmtMove(&pDst->exprStmt, &pSrc->exprStmt);
+            break;
+        case BOH_STMT_TYPE_WHILE:
+            bohWhileStmtMove(&pDst->whileStmt, &pSrc->whileStmt);
+            break;
+        case BOH_STMT_TYPE_FOR:
+            bohForStmtMove(&pDst->forStmt, &pSrc->forStmt);
+            break;
+        case BOH_STMT_TYPE_RANGE_FOR:
+            bohRangeForStmtMove(&pDst->rangeForStmt, &pSrc->rangeForStmt);
+            break;
         default:
             BOH_ASSERT_FAIL("Invalid statement type");
             break;
@@ -1135,6 +2365,32 @@ bool bohParsIsBitwiseExprOperator(bohExprOperator op)
 }
 
 
+// "~=" is lexed, but isn't a compound assignment since "~" is unary
+bool bohParsIsCompoundAssignExprOperator(bohExprOperator op)
+{
+    return bohParsGetCompoundAssignBaseOperator(op) != BOH_OP_UNKNOWN;
+}
+
+
+// Returns the binary operator applied by the compound assignment, "+" for "+=" and so on
+bohExprOperator bohParsGetCompoundAssignBaseOperator(bohExprOperator op)
+{
+    switch (op) {
+        case BOH_OP_PLUS_ASSIGN:            return BOH_OP_PLUS;
+        case BOH_OP_MINUS_ASSIGN:           return BOH_OP_MINUS;
+        case BOH_OP_MULT_ASSIGN:            return BOH_OP_MULT;
+        case BOH_OP_DIV_ASSIGN:             return BOH_OP_DIV;
+        case BOH_OP_MOD_ASSIGN:             return BOH_OP_MOD;
+        case BOH_OP_BITWISE_AND_ASSIGN:     return BOH_OP_BITWISE_AND;
+        case BOH_OP_BITWISE_OR_ASSIGN:      return BOH_OP_BITWISE_OR;
+        case BOH_OP_BITWISE_XOR_ASSIGN:     return BOH_OP_BITWISE_XOR;
+        case BOH_OP_BITWISE_RSHIFT_ASSIGN:  return BOH_OP_BITWISE_RSHIFT;
+        case BOH_OP_BITWISE_LSHIFT_ASSIGN:  return BOH_OP_BITWISE_LSHIFT;
+        default:                            return BOH_OP_UNKNOWN;
+    }
+}
+
+
 static bohExprOperator parsTokenTypeToExprOperator(bohTokenType tokenType)
 {
     switch (tokenType) {
@@ -1177,7 +2433,7 @@ static bohExprOperator parsTokenTypeToExprOperator(bohTokenType tokenType)
 static const bohToken* parsPeekCurrToken(const bohParser* pParser)
 {
     BOH_ASSERT(pParser);
-    return BOH_DYN_ARRAY_AT_CONST(bohToken, pParser->pTokenStorage, pParser->currTokenIdx);
+    return bohTokenStorageAtConst(pParser->pTokenStorage, pParser->currTokenIdx);
 }
 
 
@@ -1187,9 +2443,9 @@ static const bohToken* parsPeekPrevToken(const bohParser* pParser)
     BOH_ASSERT(pParser->currTokenIdx > 0);
 
     const size_t prevTokenIdx = pParser->currTokenIdx - 1;
-    BOH_ASSERT(prevTokenIdx < bohDynArrayGetSize(pParser->pTokenStorage));
+    BOH_ASSERT(prevTokenIdx < bohTokenStorageGetSize(pParser->pTokenStorage));
 
-    return BOH_DYN_ARRAY_AT_CONST(bohToken, pParser->pTokenStorage, prevTokenIdx);
+    return bohTokenStorageAtConst(pParser->pTokenStorage, prevTokenIdx);
 }
 
 
@@ -1199,8 +2455,8 @@ static const bohToken* parsPeekNextToken(const bohParser* pParser)
 
     const size_t nextTokenIdx = pParser->currTokenIdx + 1;
 
-    if (nextTokenIdx < bohDynArrayGetSize(pParser->pTokenStorage)) {
-        return BOH_DYN_ARRAY_AT_CONST(bohToken, pParser->pTokenStorage, nextTokenIdx);
+    if (nextTokenIdx < bohTokenStorageGetSize(pParser->pTokenStorage)) {
+        return bohTokenStorageAtConst(pParser->pTokenStorage, nextTokenIdx);
     }
 
     return NULL;
@@ -1221,7 +2477,7 @@ static bool parsIsCurrTokenMatch(bohParser* pParser, bohTokenType type)
 {
     BOH_ASSERT(pParser);
 
-    if (pParser->currTokenIdx >= bohDynArrayGetSize(pParser->pTokenStorage)) {
+    if (pParser->currTokenIdx >= bohTokenStorageGetSize(pParser->pTokenStorage)) {
         return false;
     }
 
@@ -1237,7 +2493,31 @@ static bool parsIsCurrTokenMatch(bohParser* pParser, bohTokenType type)
 static bohExpr* parsParsExpr(bohParser* pParser);
 
 
-// <primary> = <integer> | <float> | <string> | <identifier> | '(' <expr> ')' 
+// <call> = <identifier> '(' (<expr> (',' <expr>)*)? ')'
+static bohExpr* parsParsCallExpr(bohParser* pParser, const bohToken* pNameToken)
+{
+    BOH_ASSERT(pParser);
+    BOH_ASSERT(pNameToken);
+
+    bohExprPtrSmallVec argExprPtrs = bohExprPtrSmallVecCreate();
+
+    if (!parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RPAREN)) {
+        do {
+            bohExprPtrSmallVecPushBack(&argExprPtrs, parsParsExpr(pParser));
+        } while (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_COMMA));
+
+        BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RPAREN), pNameToken->line, pNameToken->column, 
+            "missed closing \')\' in call of: %.*s", (int)bohStringViewGetSize(&pNameToken->lexeme), bohStringViewGetData(&pNameToken->lexeme));
+    }
+
+    bohExpr* pCallExpr = bohAstAllocateExpr(&pParser->ast);
+    bohExprCreateCallExprInPlace(pCallExpr, &pNameToken->lexeme, &argExprPtrs, pNameToken->line, pNameToken->column);
+
+    return pCallExpr;
+}
+
+
+// <primary> = <integer> | <float> | <string> | <identifier> | <call> | '(' <expr> ')' 
 static bohExpr* parsParsPrimary(bohParser* pParser)
 {
     BOH_ASSERT(pParser);
@@ -1246,14 +2526,16 @@ static bohExpr* parsParsPrimary(bohParser* pParser)
         bohExpr* pPrimaryExpr = bohAstAllocateExpr(&pParser->ast);
 
         const bohToken* pPrevToken = parsPeekPrevToken(pParser);
-        bohExprCreateNumberValueExprInPlace(pPrimaryExpr, bohNumberCreateI64(1), pPrevToken->line, pPrevToken->column);
+        const bohConstantIdx constantIdx = bohAstAddNumberConstant(&pParser->ast, bohNumberCreateI64(1));
+        bohExprCreateValueExprInPlace(pPrimaryExpr, constantIdx, pPrevToken->line, pPrevToken->column);
         
         return pPrimaryExpr;
     } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_FALSE)) {
         bohExpr* pPrimaryExpr = bohAstAllocateExpr(&pParser->ast);
 
         const bohToken* pPrevToken = parsPeekPrevToken(pParser);
-        bohExprCreateNumberValueExprInPlace(pPrimaryExpr, bohNumberCreateI64(0), pPrevToken->line, pPrevToken->column);
+        const bohConstantIdx constantIdx = bohAstAddNumberConstant(&pParser->ast, bohNumberCreateI64(0));
+        bohExprCreateValueExprInPlace(pPrimaryExpr, constantIdx, pPrevToken->line, pPrevToken->column);
 
         return pPrimaryExpr;
     } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_INTEGER)) {
@@ -1262,7 +2544,8 @@ static bohExpr* parsParsPrimary(bohParser* pParser)
         const bohToken* pPrevToken = parsPeekPrevToken(pParser);
 
         const int64_t value = _atoi64(bohStringViewGetData(&parsPeekPrevToken(pParser)->lexeme));
-        bohExprCreateNumberValueExprInPlace(pPrimaryExpr, bohNumberCreateI64(value), pPrevToken->line, pPrevToken->column);
+        const bohConstantIdx constantIdx = bohAstAddNumberConstant(&pParser->ast, bohNumberCreateI64(value));
+        bohExprCreateValueExprInPlace(pPrimaryExpr, constantIdx, pPrevToken->line, pPrevToken->column);
 
         return pPrimaryExpr;
     } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_FLOAT)) {
@@ -1271,43 +2554,101 @@ static bohExpr* parsParsPrimary(bohParser* pParser)
         const bohToken* pPrevToken = parsPeekPrevToken(pParser);
 
         const double value = atof(bohStringViewGetData(&parsPeekPrevToken(pParser)->lexeme));
-        bohExprCreateNumberValueExprInPlace(pPrimaryExpr, bohNumberCreateF64(value), pPrevToken->line, pPrevToken->column);
+        const bohConstantIdx constantIdx = bohAstAddNumberConstant(&pParser->ast, bohNumberCreateF64(value));
+        bohExprCreateValueExprInPlace(pPrimaryExpr, constantIdx, pPrevToken->line, pPrevToken->column);
         
         return pPrimaryExpr;
     } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_STRING)) {
-        bohBoharesString lexeme = bohBoharesStringCreateStringViewStringViewPtr(&parsPeekPrevToken(pParser)->lexeme);
-        bohBoharesString unescapedLexeme = parsGetUnescapedString(&lexeme);
+        const bohStringView unescapedLexemeView = parsGetUnescapedString(&pParser->ast, &parsPeekPrevToken(pParser)->lexeme);
+        bohBoharesString unescapedLexeme = bohBoharesStringCreateStringViewStringViewPtr(&unescapedLexemeView);
 
-        bohBoharesStringDestroy(&lexeme);
+        // Literal is interned, so every value evaluated from it is copied and compared in O(1)
+        const bohConstantIdx constantIdx = bohAstAddStringConstantMove(&pParser->ast, &unescapedLexeme);
         
         bohExpr* pPrimaryExpr = bohAstAllocateExpr(&pParser->ast);
         const bohToken* pPrevToken = parsPeekPrevToken(pParser);
 
-        bohExprCreateStringValueExprMoveInPlace(pPrimaryExpr, &unescapedLexeme, pPrevToken->line, pPrevToken->column);
+        bohExprCreateValueExprInPlace(pPrimaryExpr, constantIdx, pPrevToken->line, pPrevToken->column);
 
         return pPrimaryExpr;
     } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_IDENTIFIER)) {
-        bohExpr* pPrimaryExpr = bohAstAllocateExpr(&pParser->ast);        
-        
-        const bohToken* pPrevToken = parsPeekPrevToken(pParser);
-        bohExprCreateIdentifierExprInPlace(pPrimaryExpr, &pPrevToken->lexeme, pPrevToken->line, pPrevToken->column);
+        const bohToken* pNameToken = parsPeekPrevToken(pParser);
+
+        if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_LPAREN)) {
+            return parsParsCallExpr(pParser, pNameToken);
+        }
+
+        bohExpr* pPrimaryExpr = bohAstAllocateExpr(&pParser->ast);
+        bohExprCreateIdentifierExprInPlace(pPrimaryExpr, &pNameToken->lexeme, pNameToken->line, pNameToken->column);
 
         return pPrimaryExpr;
     } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_LPAREN)) {
-        const uint32_t line = parsPeekCurrToken(pParser)->line;
-        const uint32_t column = parsPeekCurrToken(pParser)->column;
+        const uint32_t line = parsPeekPrevToken(pParser)->line;
+        const uint32_t column = parsPeekPrevToken(pParser)->column;
 
         bohExpr* pExpr = parsParsExpr(pParser);
         BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RPAREN), line, column, "missed closing \')\'");
         
         return pExpr;
     }
+
+    const bool isTokensEndReached = pParser->currTokenIdx >= bohTokenStorageGetSize(pParser->pTokenStorage);
+    const bohToken* pErrorToken = isTokensEndReached ? parsPeekPrevToken(pParser) : parsPeekCurrToken(pParser);
+
+    BOH_PARSER_EXPECT(false, pErrorToken->line, pErrorToken->column, "expected expression%s%.*s", 
+        isTokensEndReached ? " at the end of file after: " : ", got: ",
+        bohStringViewGetSize(&pErrorToken->lexeme), bohStringViewGetData(&pErrorToken->lexeme));
     
-    return NULL;
+    // Placeholder keeps the tree valid, so parsing goes on and reports the rest errors
+    bohExpr* pPlaceholderExpr = bohAstAllocateExpr(&pParser->ast);
+    const bohConstantIdx constantIdx = bohAstAddNumberConstant(&pParser->ast, bohNumberCreateI64(0));
+    bohExprCreateValueExprInPlace(pPlaceholderExpr, constantIdx, pErrorToken->line, pErrorToken->column);
+
+    return pPlaceholderExpr;
+}
+
+
+// <postfix> = <primary> ('[' (<expr> | <expr>? '..' <expr>?) ']')*
+static bohExpr* parsParsPostfix(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
+
+    bohExpr* pObjectExpr = parsParsPrimary(pParser);
+
+    while (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_LSQUAR)) {
+        const uint32_t line = parsPeekPrevToken(pParser)->line;
+        const uint32_t column = parsPeekPrevToken(pParser)->column;
+
+        const bohExpr* pBeginExpr = NULL;
+        const bohExpr* pEndExpr = NULL;
+
+        bool isSlice = parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RANGE);
+
+        if (!isSlice) {
+            pBeginExpr = parsParsExpr(pParser);
+            isSlice = parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RANGE);
+        }
+
+        bool isClosed = parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RSQUAR);
+
+        if (isSlice && !isClosed) {
+            pEndExpr = parsParsExpr(pParser);
+            isClosed = parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RSQUAR);
+        }
+
+        BOH_PARSER_EXPECT(isClosed, line, column, "missed closing \']\'");
+
+        bohExpr* pIndexExpr = bohAstAllocateExpr(&pParser->ast);
+        bohExprCreateIndexExprInPlace(pIndexExpr, pObjectExpr, pBeginExpr, pEndExpr, isSlice, line, column);
+
+        pObjectExpr = pIndexExpr;
+    }
+
+    return pObjectExpr;
 }
 
 
-// <unary> = ('+' | '-' | '~' | '!') <unary> | <primary>
+// <unary> = ('+' | '-' | '~' | '!') <unary> | <postfix>
 static bohExpr* parsParsUnary(bohParser* pParser)
 {
     BOH_ASSERT(pParser);
@@ -1331,7 +2672,7 @@ static bohExpr* parsParsUnary(bohParser* pParser)
         return pUnaryExpr;
     }
 
-    return parsParsPrimary(pParser);
+    return parsParsPostfix(pParser);
 }
 
 
@@ -1617,7 +2958,8 @@ static bohStmt* parsParsPrintStmt(bohParser* pParser)
 {
     BOH_ASSERT(pParser);
     
-    const bohToken* pCurrToken = parsPeekCurrToken(pParser);
+    // Statement position is the keyword one, there may be no tokens after it
+    const bohToken* pCurrToken = parsPeekPrevToken(pParser);
     const bohExpr* pArgExpr = parsParsExpr(pParser);
 
     bohStmt* pPrintStmt = bohAstAllocateStmt(&pParser->ast);
@@ -1627,57 +2969,322 @@ static bohStmt* parsParsPrintStmt(bohParser* pParser)
 }
 
 
-// <if_stmt> = "if" <stmt> { (<stmt>)* } ("else" {(<stmt>)*})?
+// Copies the statements pushed to the scratch since scratchBegin into the exactly sized AST arena span and pops them
+static bohStmtSpan parsCommitStmtSpan(bohParser* pParser, size_t scratchBegin)
+{
+    BOH_ASSERT(pParser);
+
+    bohStmtPtrArray* pScratch = &pParser->stmtScratch;
+    
+    const size_t scratchSize = bohStmtPtrArrayGetSize(pScratch);
+    BOH_ASSERT(scratchBegin <= scratchSize);
+
+    const size_t stmtsCount = scratchSize - scratchBegin;
+
+    if (stmtsCount == 0) {
+        return bohStmtSpanCreate();
+    }
+
+    const size_t spanMemSize = stmtsCount * sizeof(bohStmt*);
+
+    bohStmt** ppStmts = (bohStmt**)bohArenaAllocatorAlloc(&pParser->ast.stmtSpansMemArena, spanMemSize, _Alignof(bohStmt*));
+    memcpy_s(ppStmts, spanMemSize, bohStmtPtrArrayAt(pScratch, scratchBegin), spanMemSize);
+
+    bohStmtPtrArrayResize(pScratch, scratchBegin);
+
+    return bohStmtSpanCreateSized((const bohStmt* const*)ppStmts, stmtsCount);
+}
+
+
+// <block> = '{' (<stmt>)* '}', pStmtName is used in error messages only.
+// Statements are collected in the parser scratch, nested blocks push on top of the enclosing one and commit their own span first
+static bohStmtSpan parsParsBlock(bohParser* pParser, const char* pStmtName)
+{
+    BOH_ASSERT(pParser);
+    BOH_ASSERT(pStmtName);
+
+    BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_LCURLY), parsPeekPrevToken(pParser)->line, parsPeekPrevToken(pParser)->column, 
+        "expected opening \'{\' in \'%s\' statement block", pStmtName);
+
+    if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RCURLY)) {
+        return bohStmtSpanCreate();
+    }
+
+    const size_t scratchBegin = bohStmtPtrArrayGetSize(&pParser->stmtScratch);
+    const size_t tokensCount = bohTokenStorageGetSize(pParser->pTokenStorage);
+
+    while(pParser->currTokenIdx < tokensCount && !parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RCURLY)) {
+        bohStmt* pStmt = parsParsNextStmt(pParser);
+
+        if (pStmt) {
+            bohStmtPtrArrayPushBack(&pParser->stmtScratch, pStmt);
+        }
+    }
+
+    const bohToken* pRCurlyToken = parsPeekPrevToken(pParser);
+    BOH_PARSER_EXPECT(pRCurlyToken->type == BOH_TOKEN_TYPE_RCURLY, pRCurlyToken->line, pRCurlyToken->column, 
+        "expected closing \'}\' in \'%s\' statement block", pStmtName);
+
+    return parsCommitStmtSpan(pParser, scratchBegin);
+}
+
+
+// <if_stmt> = "if" <expr> <block> ("else" <block>)?
 static bohStmt* parsParsIfStmt(bohParser* pParser)
 {
     BOH_ASSERT(pParser);
 
-    const bohToken* pCurrToken = parsPeekCurrToken(pParser);
+    const bohToken* pCurrToken = parsPeekPrevToken(pParser);
     const bohExpr* pCondExpr = parsParsExpr(pParser);
     
-    BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_LCURLY), parsPeekPrevToken(pParser)->line, parsPeekPrevToken(pParser)->column, 
-        "expected opening \'{\' in \'if\' statement block");
+    const bohStmtSpan thenStmts = parsParsBlock(pParser, "if");
+    const bohStmtSpan elseStmts = parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_ELSE) ? parsParsBlock(pParser, "else") : bohStmtSpanCreate();
 
-    bohDynArray thenStmtsPtrs = BOH_DYN_ARRAY_CREATE(bohStmt*, NULL, NULL, NULL);
-    bohDynArray elseStmtsPtrs = BOH_DYN_ARRAY_CREATE(bohStmt*, NULL, NULL, NULL);
+    bohStmt* pIfStmt = bohAstAllocateStmt(&pParser->ast);
+    bohStmtCreateIfInPlace(pIfStmt, pCondExpr, &thenStmts, &elseStmts, pCurrToken->line, pCurrToken->column);
+
+    return pIfStmt;
+}
+
+
+// <simple_stmt> = <expr> ('=' | <compound_assign_op>) <expr> | <call>
+static bohStmt* parsParsSimpleStmt(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
 
-    const size_t tokensCount = bohDynArrayGetSize(pParser->pTokenStorage);
+    const size_t stmtBeginTokenIdx = pParser->currTokenIdx;
+    const bohToken* pCurrToken = parsPeekCurrToken(pParser);
 
-    static const size_t BOH_PLEALLOCATED_INNER_STMT_COUNT = 16;
+    const bohExpr* pLeftExpr = parsParsExpr(pParser);
 
-    if (!parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RCURLY)) {
-        bohDynArrayReserve(&thenStmtsPtrs, BOH_PLEALLOCATED_INNER_STMT_COUNT);
+    const bool isTokensEndReached = pParser->currTokenIdx >= bohTokenStorageGetSize(pParser->pTokenStorage);
+    
+    const bohExprOperator compoundOp = isTokensEndReached ? BOH_OP_UNKNOWN : parsTokenTypeToExprOperator(parsPeekCurrToken(pParser)->type);
+    const bool isCompoundAssignment = bohParsIsCompoundAssignExprOperator(compoundOp);
 
-        while(pParser->currTokenIdx < tokensCount && !parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RCURLY)) {
-            bohStmt** ppThenStmt = (bohStmt**)bohDynArrayPushBackDummy(&thenStmtsPtrs);
-            *ppThenStmt = parsParsNextStmt(pParser);
+    if (isCompoundAssignment || parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_ASSIGNMENT)) {
+        if (isCompoundAssignment) {
+            parsAdvanceToken(pParser);
         }
 
-        const bohToken* pRCurlyToken = parsPeekPrevToken(pParser);
-        BOH_PARSER_EXPECT(pRCurlyToken->type == BOH_TOKEN_TYPE_RCURLY, pRCurlyToken->line, pRCurlyToken->column, 
-            "expected closing \'}\' in \'if\' statement block");
+        const bohExpr* pRightExpr = parsParsExpr(pParser);
+
+        bohStmt* pAssignmentStmt = bohAstAllocateStmt(&pParser->ast);
+        bohStmtCreateAssignInPlace(pAssignmentStmt, pLeftExpr, pRightExpr, isCompoundAssignment ? compoundOp : BOH_OP_UNKNOWN, 
+            pCurrToken->line, pCurrToken->column);
+        return pAssignmentStmt;
+    }
+
+    if (bohExprIsCallExpr(pLeftExpr)) {
+        bohStmt* pExprStmt = bohAstAllocateStmt(&pParser->ast);
+        bohStmtCreateExprInPlace(pExprStmt, pLeftExpr, pCurrToken->line, pCurrToken->column);
+        return pExprStmt;
     }
 
-    if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_ELSE)) {
-        bohDynArrayReserve(&elseStmtsPtrs, BOH_PLEALLOCATED_INNER_STMT_COUNT);
+    BOH_PARSER_EXPECT(false, pCurrToken->line, pCurrToken->column, "invalid statement: %.*s", 
+        bohStringViewGetSize(&pCurrToken->lexeme), bohStringViewGetData(&pCurrToken->lexeme));
 
-        BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_LCURLY), parsPeekPrevToken(pParser)->line, parsPeekPrevToken(pParser)->column, 
-            "expected opening \'{\' in \'else\' statement block");
-        
-        while(pParser->currTokenIdx < tokensCount && !parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RCURLY)) {
-            bohStmt** ppElseStmt = (bohStmt**)bohDynArrayPushBackDummy(&elseStmtsPtrs);
-            *ppElseStmt = parsParsNextStmt(pParser);
+    // Discarded node goes back to the pool, its children are released with the AST
+    bohAstFreeExpr(&pParser->ast, (bohExpr*)pLeftExpr);
+
+    // Skip the token to guarantee progress, parsing continues to report as many errors as possible
+    if (pParser->currTokenIdx == stmtBeginTokenIdx) {
+        parsAdvanceToken(pParser);
+    }
+
+    return NULL;
+}
+
+
+// <func_stmt> = "func" <identifier> '(' (<identifier> (',' <identifier>)*)? ')' { (<stmt>)* }
+static bohStmt* parsParsFuncStmt(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
+
+    const bohToken* pCurrToken = parsPeekPrevToken(pParser);
+
+    BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_IDENTIFIER), pCurrToken->line, pCurrToken->column, 
+        "expected function name after \'func\'");
+    
+    const bohToken* pNameToken = parsPeekPrevToken(pParser);
+
+    BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_LPAREN), pNameToken->line, pNameToken->column, 
+        "expected \'(\' after function name");
+
+    bohStringViewSmallVec paramNames = bohStringViewSmallVecCreate();
+
+    if (!parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RPAREN)) {
+        do {
+            BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_IDENTIFIER), parsPeekPrevToken(pParser)->line, parsPeekPrevToken(pParser)->column, 
+                "expected parameter name");
+
+            const bohToken* pParamToken = parsPeekPrevToken(pParser);
+            
+            if (pParamToken->type == BOH_TOKEN_TYPE_IDENTIFIER) {
+                bohStringViewSmallVecPushBack(&paramNames, pParamToken->lexeme);
+            }
+        } while (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_COMMA));
+
+        BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RPAREN), pNameToken->line, pNameToken->column, 
+            "missed closing \')\' in parameters list");
+    }
+
+    const bohStmtSpan bodyStmts = parsParsBlock(pParser, "func");
+
+    bohStmt* pFuncStmt = bohAstAllocateStmt(&pParser->ast);
+    bohStmtCreateFuncInPlace(pFuncStmt, &pNameToken->lexeme, &paramNames, &bodyStmts, pCurrToken->line, pCurrToken->column);
+
+    return pFuncStmt;
+}
+
+
+// <return_stmt> = "return" (<expr>)?
+// Value must start on the same line as "return", otherwise the next line is a statement of its own
+static bohStmt* parsParsReturnStmt(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
+
+    const bohToken* pCurrToken = parsPeekPrevToken(pParser);
+
+    const bool hasValue = pParser->currTokenIdx < bohTokenStorageGetSize(pParser->pTokenStorage) 
+        && parsPeekCurrToken(pParser)->line == pCurrToken->line
+        && parsPeekCurrToken(pParser)->type != BOH_TOKEN_TYPE_RCURLY;
+
+    const bohExpr* pValueExpr = hasValue ? parsParsExpr(pParser) : NULL;
+
+    bohStmt* pReturnStmt = bohAstAllocateStmt(&pParser->ast);
+    bohStmtCreateReturnInPlace(pReturnStmt, pValueExpr, pCurrToken->line, pCurrToken->column);
+
+    return pReturnStmt;
+}
+
+
+// <while_stmt> = "while" <expr> <block>
+static bohStmt* parsParsWhileStmt(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
+
+    const bohToken* pCurrToken = parsPeekPrevToken(pParser);
+    const bohExpr* pCondExpr = parsParsExpr(pParser);
+
+    const bohStmtSpan bodyStmts = parsParsBlock(pParser, "while");
+
+    bohStmt* pWhileStmt = bohAstAllocateStmt(&pParser->ast);
+    bohStmtCreateWhileInPlace(pWhileStmt, pCondExpr, &bodyStmts, false, pCurrToken->line, pCurrToken->column);
+
+    return pWhileStmt;
+}
+
+
+// <do_while_stmt> = "do" <block> "while" <expr>
+static bohStmt* parsParsDoWhileStmt(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
+
+    const bohToken* pCurrToken = parsPeekPrevToken(pParser);
+
+    const bohStmtSpan bodyStmts = parsParsBlock(pParser, "do");
+
+    BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_WHILE), parsPeekPrevToken(pParser)->line, parsPeekPrevToken(pParser)->column, 
+        "expected \'while\' after \'do\' statement block");
+
+    const bohExpr* pCondExpr = parsParsExpr(pParser);
+
+    bohStmt* pWhileStmt = bohAstAllocateStmt(&pParser->ast);
+    bohStmtCreateWhileInPlace(pWhileStmt, pCondExpr, &bodyStmts, true, pCurrToken->line, pCurrToken->column);
+
+    return pWhileStmt;
+}
+
+
+// <range_for_stmt> = "for" <identifier> "in" <expr> ".." <expr> (':' ('-')? <integer>)? <block>
+static bohStmt* parsParsRangeForStmt(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
+
+    const bohToken* pCurrToken = parsPeekPrevToken(pParser);
+    const bohToken* pIteratorToken = parsAdvanceToken(pParser);
+
+    bohExpr* pIteratorExpr = bohAstAllocateExpr(&pParser->ast);
+    bohExprCreateIdentifierExprInPlace(pIteratorExpr, &pIteratorToken->lexeme, pIteratorToken->line, pIteratorToken->column);
+
+    parsAdvanceToken(pParser); // Consume "in"
+
+    const bohExpr* pBeginExpr = parsParsExpr(pParser);
+
+    BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RANGE), parsPeekPrevToken(pParser)->line, parsPeekPrevToken(pParser)->column, 
+        "expected '..' after range begin");
+
+    const bohExpr* pEndExpr = parsParsExpr(pParser);
+
+    int64_t step = 1;
+
+    if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_COLON)) {
+        const bool isNegativeStep = parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_MINUS);
+        const bool isStepValid = parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_INTEGER);
+
+        const bohToken* pStepToken = parsPeekPrevToken(pParser);
+        BOH_PARSER_EXPECT(isStepValid, pStepToken->line, pStepToken->column, "range loop step must be an integer constant");
+
+        if (isStepValid) {
+            const int64_t value = _atoi64(bohStringViewGetData(&pStepToken->lexeme));
+            
+            BOH_PARSER_EXPECT(value != 0, pStepToken->line, pStepToken->column, "range loop step can't be zero");
+            step = value == 0 ? 1 : (isNegativeStep ? -value : value);
         }
+    }
+
+    const bohStmtSpan bodyStmts = parsParsBlock(pParser, "for");
+
+    bohStmt* pRangeForStmt = bohAstAllocateStmt(&pParser->ast);
+    bohStmtCreateRangeForInPlace(pRangeForStmt, pIteratorExpr, pBeginExpr, pEndExpr, step, &bodyStmts, pCurrToken->line, pCurrToken->column);
+
+    return pRangeForStmt;
+}
 
-        const bohToken* pRCurlyToken = parsPeekPrevToken(pParser);
-        BOH_PARSER_EXPECT(pRCurlyToken->type == BOH_TOKEN_TYPE_RCURLY, pRCurlyToken->line, pRCurlyToken->column, 
-            "expected closing \'}\' in \'else\' statement block");
+
+// <for_stmt> = "for" (<simple_stmt>)? ';' (<expr>)? ';' (<simple_stmt>)? <block> | <range_for_stmt>
+static bohStmt* parsParsForStmt(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
+
+    const bohToken* pCurrToken = parsPeekPrevToken(pParser);
+    const size_t tokensCount = bohTokenStorageGetSize(pParser->pTokenStorage);
+
+    const bohToken* pNextToken = parsPeekNextToken(pParser);
+    
+    if (pNextToken && pNextToken->type == BOH_TOKEN_TYPE_IN && parsPeekCurrToken(pParser)->type == BOH_TOKEN_TYPE_IDENTIFIER) {
+        return parsParsRangeForStmt(pParser);
     }
 
-    bohStmt* pIfStmt = bohAstAllocateStmt(&pParser->ast);
-    bohStmtCreateIfInPlace(pIfStmt, pCondExpr, &thenStmtsPtrs, &elseStmtsPtrs, pCurrToken->line, pCurrToken->column);
+    const bohStmt* pInitStmt = NULL;
+    const bohExpr* pCondExpr = NULL;
+    const bohStmt* pStepStmt = NULL;
 
-    return pIfStmt;
+    if (pParser->currTokenIdx < tokensCount && parsPeekCurrToken(pParser)->type != BOH_TOKEN_TYPE_SEMICOLON) {
+        pInitStmt = parsParsSimpleStmt(pParser);
+    }
+
+    BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_SEMICOLON), parsPeekPrevToken(pParser)->line, parsPeekPrevToken(pParser)->column, 
+        "expected \';\' after \'for\' loop initializer");
+
+    if (pParser->currTokenIdx < tokensCount && parsPeekCurrToken(pParser)->type != BOH_TOKEN_TYPE_SEMICOLON) {
+        pCondExpr = parsParsExpr(pParser);
+    }
+
+    BOH_PARSER_EXPECT(parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_SEMICOLON), parsPeekPrevToken(pParser)->line, parsPeekPrevToken(pParser)->column, 
+        "expected \';\' after \'for\' loop condition");
+
+    if (pParser->currTokenIdx < tokensCount && parsPeekCurrToken(pParser)->type != BOH_TOKEN_TYPE_LCURLY) {
+        pStepStmt = parsParsSimpleStmt(pParser);
+    }
+
+    const bohStmtSpan bodyStmts = parsParsBlock(pParser, "for");
+
+    bohStmt* pForStmt = bohAstAllocateStmt(&pParser->ast);
+    bohStmtCreateForInPlace(pForStmt, pInitStmt, pCondExpr, pStepStmt, &bodyStmts, pCurrToken->line, pCurrToken->column);
+
+    return pForStmt;
 }
 
 
@@ -1689,21 +3296,18 @@ static bohStmt* parsParsNextStmt(bohParser* pParser)
         return parsParsPrintStmt(pParser);
     } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_IF)) {
         return parsParsIfStmt(pParser);
+    } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_FUNC)) {
+        return parsParsFuncStmt(pParser);
+    } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_RETURN)) {
+        return parsParsReturnStmt(pParser);
+    } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_WHILE)) {
+        return parsParsWhileStmt(pParser);
+    } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_DO)) {
+        return parsParsDoWhileStmt(pParser);
+    } else if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_FOR)) {
+        return parsParsForStmt(pParser);
     } else {
-        const bohToken* pCurrToken = parsPeekCurrToken(pParser);
-
-        const bohExpr* pLeftExpr = parsParsExpr(pParser);
-
-        if (parsIsCurrTokenMatch(pParser, BOH_TOKEN_TYPE_ASSIGNMENT)) {
-            const bohExpr* pRightExpr = parsParsExpr(pParser);
-
-            bohStmt* pAssignmentStmt = bohAstAllocateStmt(&pParser->ast);
-            bohStmtCreateAssignInPlace(pAssignmentStmt, pLeftExpr, pRightExpr, pCurrToken->line, pCurrToken->column);
-            return pAssignmentStmt;
-        }
-
-        BOH_ASSERT_FAIL("Invalid token type");
-        return NULL;
+        return parsParsSimpleStmt(pParser);
     }
 }
 
@@ -1713,22 +3317,46 @@ static void parsParsStmts(bohParser* pParser)
     BOH_ASSERT(pParser);
 
     const bohTokenStorage* pTokenStorage = pParser->pTokenStorage;
-    const size_t tokensCount = bohDynArrayGetSize(pTokenStorage);
+    const size_t tokensCount = bohTokenStorageGetSize(pTokenStorage);
     
     while(pParser->currTokenIdx < tokensCount) {
-        bohAstPushStmtPtr(&pParser->ast, parsParsNextStmt(pParser));
+        bohStmt* pStmt = parsParsNextStmt(pParser);
+
+        if (pStmt) {
+            bohAstPushStmtPtr(&pParser->ast, pStmt);
+        }
     }
 }
 
 
+// Each arena stores nodes of a single type only, so walking it destroys every node, including the ones orphaned by parse errors
+static void parsDestroyPoolExpr(void* pExpr)
+{
+    bohExprDestroy((bohExpr*)pExpr);
+}
+
+
+static void parsDestroyPoolStmt(void* pStmt)
+{
+    bohStmtDestroy((bohStmt*)pStmt);
+}
+
+
 void bohAstDestroy(bohAST* pAST)
 {
     BOH_ASSERT(pAST);
 
-    bohDynArrayDestroy(&pAST->stmtPtrsStorage);
+    bohStmtPtrArrayDestroy(&pAST->stmtPtrsStorage);
+
+    bohPoolAllocatorForEach(&pAST->stmtPool, parsDestroyPoolStmt);
+    bohPoolAllocatorForEach(&pAST->exprPool, parsDestroyPoolExpr);
 
-    bohArenaAllocatorDestroy(&pAST->stmtMemArena);
-    bohArenaAllocatorDestroy(&pAST->epxrMemArena);
+    bohPoolAllocatorDestroy(&pAST->stmtPool);
+    bohPoolAllocatorDestroy(&pAST->exprPool);
+    bohArenaAllocatorDestroy(&pAST->stringMemArena);
+    bohArenaAllocatorDestroy(&pAST->stmtSpansMemArena);
+
+    bohConstantPoolDestroy(&pAST->constantPool);
 }
 
 
@@ -1736,10 +3364,14 @@ bohAST bohAstCreate(void)
 {
     bohAST ast = {0};
 
-    ast.stmtPtrsStorage = BOH_DYN_ARRAY_CREATE(bohStmt*, NULL, NULL, NULL);
+    ast.stmtPtrsStorage = bohStmtPtrArrayCreate();
+
+    ast.stmtPool = BOH_POOL_ALLOCATOR_CREATE(bohStmt, BOH_AST_POOL_SLAB_CAPACITY);
+    ast.exprPool = BOH_POOL_ALLOCATOR_CREATE(bohExpr, BOH_AST_POOL_SLAB_CAPACITY);
+    ast.stringMemArena = bohArenaAllocatorCreate((size_t)1 << 16);
+    ast.stmtSpansMemArena = bohArenaAllocatorCreate((size_t)1 << 16);
 
-    ast.stmtMemArena = bohArenaAllocatorCreate((size_t)1 << 20);
-    ast.epxrMemArena = bohArenaAllocatorCreate((size_t)1 << 20);
+    ast.constantPool = bohConstantPoolCreate();
 
     return ast;
 }
@@ -1748,14 +3380,43 @@ bohAST bohAstCreate(void)
 bohExpr* bohAstAllocateExpr(bohAST* pAst)
 {
     BOH_ASSERT(pAst);
-    return BOH_ARENA_ALLOCATOR_ALLOC(&pAst->epxrMemArena, bohExpr);
+
+    // Zeroed as the arena memory used to be, *CreateInPlace functions rely on it
+    bohExpr* pExpr = BOH_POOL_ALLOCATOR_ALLOC(&pAst->exprPool, bohExpr);
+    memset(pExpr, 0, sizeof(bohExpr));
+
+    return pExpr;
 }
 
 
 bohStmt* bohAstAllocateStmt(bohAST* pAst)
 {
     BOH_ASSERT(pAst);
-    return BOH_ARENA_ALLOCATOR_ALLOC(&pAst->stmtMemArena, bohStmt);
+
+    bohStmt* pStmt = BOH_POOL_ALLOCATOR_ALLOC(&pAst->stmtPool, bohStmt);
+    memset(pStmt, 0, sizeof(bohStmt));
+
+    return pStmt;
+}
+
+
+void bohAstFreeExpr(bohAST* pAst, bohExpr* pExpr)
+{
+    BOH_ASSERT(pAst);
+    BOH_ASSERT(pExpr);
+
+    bohExprDestroy(pExpr);
+    bohPoolAllocatorFree(&pAst->exprPool, pExpr);
+}
+
+
+void bohAstFreeStmt(bohAST* pAst, bohStmt* pStmt)
+{
+    BOH_ASSERT(pAst);
+    BOH_ASSERT(pStmt);
+
+    bohStmtDestroy(pStmt);
+    bohPoolAllocatorFree(&pAst->stmtPool, pStmt);
 }
 
 
@@ -1764,24 +3425,56 @@ bohStmt** bohAstPushStmtPtr(bohAST* pAst, bohStmt* pStmt)
     BOH_ASSERT(pAst);
     BOH_ASSERT(pStmt);
 
-    bohStmt** ppStmt = (bohStmt**)bohDynArrayPushBackDummy(&pAst->stmtPtrsStorage);
-    *ppStmt = pStmt;
-    
-    return ppStmt;
+    return bohStmtPtrArrayPushBack(&pAst->stmtPtrsStorage, pStmt);
 }
 
 
 const bohStmt* bohAstGetStmtByIdx(const bohAST* pAst, size_t index)
 {
     BOH_ASSERT(pAst);
-    return *BOH_DYN_ARRAY_AT_CONST(bohStmt*, &pAst->stmtPtrsStorage, index);
+    return *bohStmtPtrArrayAtConst(&pAst->stmtPtrsStorage, index);
+}
+
+
+bohConstantIdx bohAstAddNumberConstant(bohAST* pAst, bohNumber number)
+{
+    BOH_ASSERT(pAst);
+    return bohConstantPoolAddNumber(&pAst->constantPool, number);
+}
+
+
+bohConstantIdx bohAstAddStringConstantMove(bohAST* pAst, bohBoharesString* pString)
+{
+    BOH_ASSERT(pAst);
+    return bohConstantPoolAddStringMove(&pAst->constantPool, pString);
+}
+
+
+const bohConstant* bohAstGetConstant(const bohAST* pAst, const bohValueExpr* pExpr)
+{
+    BOH_ASSERT(pAst);
+    return bohConstantPoolAt(&pAst->constantPool, bohValueExprGetConstantIdx(pExpr));
 }
 
 
 size_t bohAstGetStmtCount(const bohAST* pAst)
 {
     BOH_ASSERT(pAst);
-    return bohDynArrayGetSize(&pAst->stmtPtrsStorage);
+    return bohStmtPtrArrayGetSize(&pAst->stmtPtrsStorage);
+}
+
+
+void bohAstSetGlobalFrameSlotsCount(bohAST* pAst, uint32_t slotsCount)
+{
+    BOH_ASSERT(pAst);
+    pAst->globalFrameSlotsCount = slotsCount;
+}
+
+
+uint32_t bohAstGetGlobalFrameSlotsCount(const bohAST* pAst)
+{
+    BOH_ASSERT(pAst);
+    return pAst->globalFrameSlotsCount;
 }
 
 
@@ -1789,9 +3482,12 @@ size_t bohAstGetMemorySize(const bohAST* pAst)
 {
     BOH_ASSERT(pAst);
     
-    return bohDynArrayGetMemorySize(&pAst->stmtPtrsStorage) + 
-        bohArenaAllocatorGetCapacity(&pAst->epxrMemArena) + 
-        bohArenaAllocatorGetCapacity(&pAst->stmtMemArena);
+    return bohStmtPtrArrayGetMemorySize(&pAst->stmtPtrsStorage) + 
+        bohPoolAllocatorGetCapacity(&pAst->exprPool) + 
+        bohPoolAllocatorGetCapacity(&pAst->stmtPool) + 
+        bohArenaAllocatorGetCapacity(&pAst->stringMemArena) +
+        bohArenaAllocatorGetCapacity(&pAst->stmtSpansMemArena) +
+        bohConstantPoolGetMemorySize(&pAst->constantPool);
 }
 
 
@@ -1804,6 +3500,8 @@ bohParser bohParserCreate(const bohTokenStorage *pTokenStorage)
     parser.pTokenStorage = pTokenStorage;
     parser.currTokenIdx = 0;
 
+    parser.stmtScratch = bohStmtPtrArrayCreate();
+
     parser.ast = bohAstCreate();
 
     return parser;
@@ -1817,6 +3515,8 @@ void bohParserDestroy(bohParser* pParser)
     pParser->pTokenStorage = NULL;
     pParser->currTokenIdx = 0;
 
+    bohStmtPtrArrayDestroy(&pParser->stmtScratch);
+
     bohAstDestroy(&pParser->ast);
 }
 
@@ -1828,6 +3528,13 @@ const bohAST* bohParserGetAST(const bohParser* pParser)
 }
 
 
+bohAST* bohParserGetMutableAST(bohParser* pParser)
+{
+    BOH_ASSERT(pParser);
+    return &pParser->ast;
+}
+
+
 void bohParserParse(bohParser* pParser)
 {
     BOH_ASSERT(pParser);
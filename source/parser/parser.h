@@ -1,6 +1,9 @@
 #pragma once
 
 #include "utils/memory/arena_allocator.h"
+#include "utils/memory/pool_allocator.h"
+#include "utils/ds/typed_dyn_array.h"
+#include "utils/ds/small_vec.h"
 #include "types.h"
 
 
@@ -46,6 +49,8 @@ typedef enum ExprOperator
 
 const char* bohParsExprOperatorToStr(bohExprOperator op);
 bool bohParsIsBitwiseExprOperator(bohExprOperator op);
+bool bohParsIsCompoundAssignExprOperator(bohExprOperator op);
+bohExprOperator bohParsGetCompoundAssignBaseOperator(bohExprOperator op);
 
 
 typedef struct Expr bohExpr;
@@ -53,42 +58,92 @@ typedef struct Stmt bohStmt;
 typedef struct AST bohAST;
 
 
-typedef enum ValueExprType
+BOH_DEFINE_DYN_ARRAY(bohStmt*, bohStmtPtrArray)
+
+// Most calls and functions have a few arguments. Inline counts are chosen so bohExpr and bohStmt don't grow
+BOH_DEFINE_SMALL_VEC(bohExpr*, 4, bohExprPtrSmallVec)
+BOH_DEFINE_SMALL_VEC(bohStringView, 2, bohStringViewSmallVec)
+
+
+typedef enum ConstantType
 {
-    BOH_VALUE_EXPR_TYPE_NUMBER,
-    BOH_VALUE_EXPR_TYPE_STRING
-} bohValueExprType;
+    BOH_CONSTANT_TYPE_NUMBER,
+    BOH_CONSTANT_TYPE_STRING
+} bohConstantType;
 
 
-typedef struct ValueExpr
+typedef struct Constant
 {
-    bohValueExprType type;
+    bohConstantType type;
     
     union 
     {
         bohNumber number;
         bohBoharesString string;
     };
+} bohConstant;
+
+
+void bohConstantDestroy(bohConstant* pConstant);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohConstantCreateInPlace(bohConstant* pConstant);
+void bohConstantCreateNumberInPlace(bohConstant* pConstant, bohNumber number);
+void bohConstantCreateNumberNumberPtrInPlace(bohConstant* pConstant, const bohNumber* pNumber);
+void bohConstantCreateStringStringPtrInPlace(bohConstant* pConstant, const bohBoharesString* pString);
+void bohConstantCreateStringStringMoveInPlace(bohConstant* pConstant, bohBoharesString* pString);
+
+bool bohConstantIsNumber(const bohConstant* pConstant);
+bool bohConstantIsNumberI64(const bohConstant* pConstant);
+bool bohConstantIsNumberF64(const bohConstant* pConstant);
+bool bohConstantIsString(const bohConstant* pConstant);
+
+bohConstantType bohConstantGetType(const bohConstant* pConstant);
+const bohNumber* bohConstantGetNumber(const bohConstant* pConstant);
+const bohBoharesString* bohConstantGetString(const bohConstant* pConstant);
+
+bohConstant* bohConstantAssign(bohConstant* pDst, const bohConstant* pSrc);
+bohConstant* bohConstantMove(bohConstant* pDst, bohConstant* pSrc);
+
+
+typedef uint32_t bohConstantIdx;
+
+BOH_DEFINE_DYN_ARRAY(bohConstantIdx, bohConstantSlotArray)
+
+
+// Literals of the AST. Equal literals are stored once, every occurrence refers to the same entry by index
+typedef struct ConstantPool
+{
+    bohDynArray constants;      // bohConstant
+    bohConstantSlotArray slots; // Open addressing lookup table, the count is a power of two
+} bohConstantPool;
+
+
+bohConstantPool bohConstantPoolCreate(void);
+void bohConstantPoolDestroy(bohConstantPool* pPool);
+
+// Return the index of the equal constant if it is already in the pool
+bohConstantIdx bohConstantPoolAddNumber(bohConstantPool* pPool, bohNumber number);
+// String is interned, so equal strings are found by the StrID compare
+bohConstantIdx bohConstantPoolAddStringMove(bohConstantPool* pPool, bohBoharesString* pString);
+
+const bohConstant* bohConstantPoolAt(const bohConstantPool* pPool, bohConstantIdx index);
+size_t bohConstantPoolGetSize(const bohConstantPool* pPool);
+size_t bohConstantPoolGetMemorySize(const bohConstantPool* pPool);
+
+
+typedef struct ValueExpr
+{
+    bohConstantIdx constantIdx;
 } bohValueExpr;
 
 
 void bohValueExprDestroy(bohValueExpr* pExpr);
 
 // NOTE: *CreateInPlace functions don't call destroy function
-void bohValueExprCreateInPlace(bohValueExpr* pExpr);
-void bohValueExprCreateNumberInPlace(bohValueExpr* pExpr, bohNumber number);
-void bohValueExprCreateNumberNumberPtrInPlace(bohValueExpr* pExpr, const bohNumber* pNumber);
-void bohValueExprCreateStringStringPtrInPlace(bohValueExpr* pExpr, const bohBoharesString* pString);
-void bohValueExprCreateStringStringMoveInPlace(bohValueExpr* pExpr, bohBoharesString* pString);
-
-bool bohValueExprIsNumber(const bohValueExpr* pExpr);
-bool bohValueExprIsNumberI64(const bohValueExpr* pExpr);
-bool bohValueExprIsNumberF64(const bohValueExpr* pExpr);
-bool bohValueExprIsString(const bohValueExpr* pExpr);
+void bohValueExprCreateInPlace(bohValueExpr* pExpr, bohConstantIdx constantIdx);
 
-bohValueExprType bohValueExprGetType(const bohValueExpr* pExpr);
-const bohNumber* bohValueExprGetNumber(const bohValueExpr* pExpr);
-const bohBoharesString* bohValueExprGetString(const bohValueExpr* pExpr);
+bohConstantIdx bohValueExprGetConstantIdx(const bohValueExpr* pExpr);
 
 bohValueExpr* bohValueExprAssign(bohValueExpr* pDst, const bohValueExpr* pSrc);
 bohValueExpr* bohValueExprMove(bohValueExpr* pDst, bohValueExpr* pSrc);
@@ -134,9 +189,17 @@ bohBinaryExpr* bohBinaryExprAssign(bohBinaryExpr* pDst, const bohBinaryExpr* pSr
 bohBinaryExpr* bohBinaryExprMove(bohBinaryExpr* pDst, bohBinaryExpr* pSrc);
 
 
+#define BOH_IDENTIFIER_EXPR_UNRESOLVED_SLOT UINT32_MAX
+
+
+// Storage is bound by the resolver: depth is the number of frames to go up from the current one, 
+// slot is the variable index inside that frame
 typedef struct IdentifierExpr
 {
     bohStringView name;
+
+    uint32_t depth;
+    uint32_t slot;
 } bohIdentifierExpr;
 
 
@@ -147,16 +210,73 @@ void bohIdentifierExprCreateInPlace(bohIdentifierExpr* pExpr, const bohStringVie
 
 const bohStringView* bohIdentifierExprGetName(const bohIdentifierExpr* pExpr);
 
+void bohIdentifierExprSetStorage(bohIdentifierExpr* pExpr, uint32_t depth, uint32_t slot);
+
+uint32_t bohIdentifierExprGetDepth(const bohIdentifierExpr* pExpr);
+uint32_t bohIdentifierExprGetSlot(const bohIdentifierExpr* pExpr);
+bool bohIdentifierExprIsResolved(const bohIdentifierExpr* pExpr);
+
 bohIdentifierExpr* bohIdentifierExprAssign(bohIdentifierExpr* pDst, const bohIdentifierExpr* pSrc);
 bohIdentifierExpr* bohIdentifierExprMove(bohIdentifierExpr* pDst, bohIdentifierExpr* pSrc);
 
 
+typedef struct CallExpr
+{
+    bohStringView name;
+    bohExprPtrSmallVec argExprPtrs;
+
+    const bohStmt* pFuncStmt; // Bound by the resolver
+} bohCallExpr;
+
+
+void bohCallExprDestroy(bohCallExpr* pExpr);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohCallExprCreateInPlace(bohCallExpr* pExpr, const bohStringView* pName, bohExprPtrSmallVec* pArgExprPtrs);
+
+const bohStringView* bohCallExprGetName(const bohCallExpr* pExpr);
+size_t bohCallExprGetArgsCount(const bohCallExpr* pExpr);
+const bohExpr* bohCallExprGetArgAt(const bohCallExpr* pExpr, size_t index);
+
+void bohCallExprSetFuncStmt(bohCallExpr* pExpr, const bohStmt* pFuncStmt);
+const bohStmt* bohCallExprGetFuncStmt(const bohCallExpr* pExpr);
+
+bohCallExpr* bohCallExprAssign(bohCallExpr* pDst, const bohCallExpr* pSrc);
+bohCallExpr* bohCallExprMove(bohCallExpr* pDst, bohCallExpr* pSrc);
+
+
+// String indexing (str[i]) or slicing (str[begin..end]), omitted slice bounds are NULL
+typedef struct IndexExpr
+{
+    const bohExpr* pObjectExpr;
+    const bohExpr* pBeginExpr;
+    const bohExpr* pEndExpr;
+    bool isSlice;
+} bohIndexExpr;
+
+
+void bohIndexExprDestroy(bohIndexExpr* pExpr);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohIndexExprCreateInPlace(bohIndexExpr* pExpr, const bohExpr* pObjectExpr, const bohExpr* pBeginExpr, const bohExpr* pEndExpr, bool isSlice);
+
+const bohExpr* bohIndexExprGetObjectExpr(const bohIndexExpr* pExpr);
+const bohExpr* bohIndexExprGetBeginExpr(const bohIndexExpr* pExpr);
+const bohExpr* bohIndexExprGetEndExpr(const bohIndexExpr* pExpr);
+bool bohIndexExprIsSlice(const bohIndexExpr* pExpr);
+
+bohIndexExpr* bohIndexExprAssign(bohIndexExpr* pDst, const bohIndexExpr* pSrc);
+bohIndexExpr* bohIndexExprMove(bohIndexExpr* pDst, bohIndexExpr* pSrc);
+
+
 typedef enum ExprType
 {
     BOH_EXPR_TYPE_VALUE,
     BOH_EXPR_TYPE_UNARY,
     BOH_EXPR_TYPE_BINARY,
     BOH_EXPR_TYPE_IDENTIFIER,
+    BOH_EXPR_TYPE_CALL,
+    BOH_EXPR_TYPE_INDEX,
 } bohExprType;
 
 
@@ -170,6 +290,8 @@ typedef struct Expr
         bohUnaryExpr unaryExpr;
         bohBinaryExpr binaryExpr;
         bohIdentifierExpr identifierExpr;
+        bohCallExpr callExpr;
+        bohIndexExpr indexExpr;
     };
 
     bohLineNmb line;
@@ -180,23 +302,27 @@ typedef struct Expr
 void bohExprDestroy(bohExpr* pExpr);
 
 // NOTE: *CreateInPlace functions don't call destroy function
-void bohExprCreateNumberValueExprInPlace(bohExpr* pExpr, bohNumber number, bohLineNmb line, bohColumnNmb column);
-void bohExprCreateNumberValueExprPtrInPlace(bohExpr* pExpr, const bohNumber* pNumber, bohLineNmb line, bohColumnNmb column);
-void bohExprCreateStringValueExprInPlace(bohExpr* pExpr, const bohBoharesString* pString, bohLineNmb line, bohColumnNmb column);
-void bohExprCreateStringValueExprMoveInPlace(bohExpr* pExpr, bohBoharesString* pString, bohLineNmb line, bohColumnNmb column);
+void bohExprCreateValueExprInPlace(bohExpr* pExpr, bohConstantIdx constantIdx, bohLineNmb line, bohColumnNmb column);
 void bohExprCreateUnaryExprInPlace(bohExpr* pExpr, bohExprOperator op, bohExpr* pArgExpr, bohLineNmb line, bohColumnNmb column);
 void bohExprCreateBinaryExprInPlace(bohExpr* pExpr, bohExprOperator op, bohExpr* pLeftArgExpr, bohExpr* pRightArgExpr, bohLineNmb line, bohColumnNmb column);
 void bohExprCreateIdentifierExprInPlace(bohExpr* pExpr, const bohStringView* pName, bohLineNmb line, bohColumnNmb column);
+void bohExprCreateCallExprInPlace(bohExpr* pExpr, const bohStringView* pName, bohExprPtrSmallVec* pArgExprPtrs, bohLineNmb line, bohColumnNmb column);
+void bohExprCreateIndexExprInPlace(bohExpr* pExpr, const bohExpr* pObjectExpr, const bohExpr* pBeginExpr, const bohExpr* pEndExpr, 
+    bool isSlice, bohLineNmb line, bohColumnNmb column);
 
 bool bohExprIsValueExpr(const bohExpr* pExpr);
 bool bohExprIsUnaryExpr(const bohExpr* pExpr);
 bool bohExprIsBinaryExpr(const bohExpr* pExpr);
 bool bohExprIsIdentifierExpr(const bohExpr* pExpr);
+bool bohExprIsCallExpr(const bohExpr* pExpr);
+bool bohExprIsIndexExpr(const bohExpr* pExpr);
 
 const bohValueExpr* bohExprGetValueExpr(const bohExpr* pExpr);
 const bohUnaryExpr* bohExprGetUnaryExpr(const bohExpr* pExpr);
 const bohBinaryExpr* bohExprGetBinaryExpr(const bohExpr* pExpr);
 const bohIdentifierExpr* bohExprGetIdentifierExpr(const bohExpr* pExpr);
+const bohCallExpr* bohExprGetCallExpr(const bohExpr* pExpr);
+const bohIndexExpr* bohExprGetIndexExpr(const bohExpr* pExpr);
 
 bohExprType bohExprGetType(const bohExpr* pExpr);
 bohLineNmb bohExprGetLine(const bohExpr* pExpr);
@@ -223,22 +349,42 @@ bohPrintStmt* bohPrintStmtAssign(bohPrintStmt* pDst, const bohPrintStmt* pSrc);
 bohPrintStmt* bohPrintStmtMove(bohPrintStmt* pDst, bohPrintStmt* pSrc);
 
 
+// Non-owning view of the block statements. Pointers are stored contiguously in the AST arena with the exact block length
+typedef struct StmtSpan
+{
+    const bohStmt* const* ppStmts;
+    size_t size;
+} bohStmtSpan;
+
+
+bohStmtSpan bohStmtSpanCreate(void);
+bohStmtSpan bohStmtSpanCreateSized(const bohStmt* const* ppStmts, size_t size);
+
+void bohStmtSpanReset(bohStmtSpan* pSpan);
+
+const bohStmt* const* bohStmtSpanGetData(const bohStmtSpan* pSpan);
+size_t bohStmtSpanGetSize(const bohStmtSpan* pSpan);
+bool bohStmtSpanIsEmpty(const bohStmtSpan* pSpan);
+
+const bohStmt* bohStmtSpanAt(const bohStmtSpan* pSpan, size_t index);
+
+
 typedef struct IfStmt
 {
     const bohExpr* pCondExpr;
-    bohDynArray thenStmtPtrs;
-    bohDynArray elseStmtPtrs;
+    bohStmtSpan thenStmts;
+    bohStmtSpan elseStmts;
 } bohIfStmt;
 
 
 void bohIfStmtDestroy(bohIfStmt* pStmt);
 
 // NOTE: *CreateInPlace functions don't call destroy function
-void bohIfStmtCreateInPlace(bohIfStmt* pStmt, const bohExpr* pCondExpr, bohDynArray* pThenStmtPtrs, bohDynArray* pElseStmtPtrs);
+void bohIfStmtCreateInPlace(bohIfStmt* pStmt, const bohExpr* pCondExpr, const bohStmtSpan* pThenStmts, const bohStmtSpan* pElseStmts);
 
 const bohExpr* bohIfStmtGetCondExpr(const bohIfStmt* pStmt);
-const bohDynArray* bohIfStmtGetThenStmts(const bohIfStmt* pStmt);
-const bohDynArray* bohIfStmtGetElseStmts(const bohIfStmt* pStmt);
+const bohStmtSpan* bohIfStmtGetThenStmts(const bohIfStmt* pStmt);
+const bohStmtSpan* bohIfStmtGetElseStmts(const bohIfStmt* pStmt);
 
 size_t bohIfStmtGetThenStmtsCount(const bohIfStmt* pStmt);
 size_t bohIfStmtGetElseStmtsCount(const bohIfStmt* pStmt);
@@ -250,31 +396,183 @@ bohIfStmt* bohIfStmtAssign(bohIfStmt* pDst, const bohIfStmt* pSrc);
 bohIfStmt* bohIfStmtMove(bohIfStmt* pDst, bohIfStmt* pSrc);
 
 
+// Compound assignment ("x += 1") updates the variable storage in place
 typedef struct AssignmentStmt
 {
     const bohExpr* pLeft;
     const bohExpr* pRight;
+    bohExprOperator op; // BOH_OP_UNKNOWN for plain "=", compound assignment operator otherwise
 } bohAssignmentStmt;
 
 
 void bohAssignmentStmtDestroy(bohAssignmentStmt* pStmt);
 
 // NOTE: *CreateInPlace functions don't call destroy function
-void bohAssignmentStmtCreateInPlace(bohAssignmentStmt* pStmt, const bohExpr* pLeft, const bohExpr* pRight);
+void bohAssignmentStmtCreateInPlace(bohAssignmentStmt* pStmt, const bohExpr* pLeft, const bohExpr* pRight, bohExprOperator op);
 
 const bohExpr* bohAssignmentStmtGetLeftExpr(const bohAssignmentStmt* pStmt);
 const bohExpr* bohAssignmentStmtGetRightExpr(const bohAssignmentStmt* pStmt);
+bohExprOperator bohAssignmentStmtGetOperator(const bohAssignmentStmt* pStmt);
+bool bohAssignmentStmtIsCompound(const bohAssignmentStmt* pStmt);
 
 bohAssignmentStmt* bohAssignmentStmtAssign(bohAssignmentStmt* pDst, const bohAssignmentStmt* pSrc);
 bohAssignmentStmt* bohAssignmentStmtMove(bohAssignmentStmt* pDst, bohAssignmentStmt* pSrc);
 
 
+// Parameters are stored as the first variables of the function frame
+typedef struct FuncStmt
+{
+    bohStringView name;
+    bohStringViewSmallVec paramNames;
+    bohStmtSpan bodyStmts;
+
+    uint32_t frameSlotsCount; // Set by the resolver
+} bohFuncStmt;
+
+
+void bohFuncStmtDestroy(bohFuncStmt* pStmt);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohFuncStmtCreateInPlace(bohFuncStmt* pStmt, const bohStringView* pName, bohStringViewSmallVec* pParamNames, const bohStmtSpan* pBodyStmts);
+
+const bohStringView* bohFuncStmtGetName(const bohFuncStmt* pStmt);
+
+size_t bohFuncStmtGetParamsCount(const bohFuncStmt* pStmt);
+const bohStringView* bohFuncStmtGetParamNameAt(const bohFuncStmt* pStmt, size_t index);
+
+const bohStmtSpan* bohFuncStmtGetBodyStmts(const bohFuncStmt* pStmt);
+size_t bohFuncStmtGetBodyStmtsCount(const bohFuncStmt* pStmt);
+const bohStmt* bohFuncStmtGetBodyStmtAt(const bohFuncStmt* pStmt, size_t index);
+
+void bohFuncStmtSetFrameSlotsCount(bohFuncStmt* pStmt, uint32_t slotsCount);
+uint32_t bohFuncStmtGetFrameSlotsCount(const bohFuncStmt* pStmt);
+
+bohFuncStmt* bohFuncStmtAssign(bohFuncStmt* pDst, const bohFuncStmt* pSrc);
+bohFuncStmt* bohFuncStmtMove(bohFuncStmt* pDst, bohFuncStmt* pSrc);
+
+
+typedef struct ReturnStmt
+{
+    const bohExpr* pValueExpr; // NULL if nothing is returned
+} bohReturnStmt;
+
+
+void bohReturnStmtDestroy(bohReturnStmt* pStmt);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohReturnStmtCreateInPlace(bohReturnStmt* pStmt, const bohExpr* pValueExpr);
+
+const bohExpr* bohReturnStmtGetValueExpr(const bohReturnStmt* pStmt);
+bool bohReturnStmtIsTailCall(const bohReturnStmt* pStmt);
+
+bohReturnStmt* bohReturnStmtAssign(bohReturnStmt* pDst, const bohReturnStmt* pSrc);
+bohReturnStmt* bohReturnStmtMove(bohReturnStmt* pDst, bohReturnStmt* pSrc);
+
+
+// Expression evaluated for its side effects only, function call for example
+typedef struct ExprStmt
+{
+    const bohExpr* pExpr;
+} bohExprStmt;
+
+
+void bohExprStmtDestroy(bohExprStmt* pStmt);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohExprStmtCreateInPlace(bohExprStmt* pStmt, const bohExpr* pExpr);
+
+const bohExpr* bohExprStmtGetExpr(const bohExprStmt* pStmt);
+
+bohExprStmt* bohExprStmtAssign(bohExprStmt* pDst, const bohExprStmt* pSrc);
+bohExprStmt* bohExprStmtMove(bohExprStmt* pDst, bohExprStmt* pSrc);
+
+
+// "while <cond> {}" checks the condition before every iteration, "do {} while <cond>" after it
+typedef struct WhileStmt
+{
+    const bohExpr* pCondExpr;
+    bohStmtSpan bodyStmts;
+    bool isDoWhile;
+} bohWhileStmt;
+
+
+void bohWhileStmtDestroy(bohWhileStmt* pStmt);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohWhileStmtCreateInPlace(bohWhileStmt* pStmt, const bohExpr* pCondExpr, const bohStmtSpan* pBodyStmts, bool isDoWhile);
+
+const bohExpr* bohWhileStmtGetCondExpr(const bohWhileStmt* pStmt);
+const bohStmtSpan* bohWhileStmtGetBodyStmts(const bohWhileStmt* pStmt);
+bool bohWhileStmtIsDoWhile(const bohWhileStmt* pStmt);
+
+bohWhileStmt* bohWhileStmtAssign(bohWhileStmt* pDst, const bohWhileStmt* pSrc);
+bohWhileStmt* bohWhileStmtMove(bohWhileStmt* pDst, bohWhileStmt* pSrc);
+
+
+// "for <init>; <cond>; <step> {}", every part may be omitted, loop without condition runs until return or error
+typedef struct ForStmt
+{
+    const bohStmt* pInitStmt;
+    const bohExpr* pCondExpr;
+    const bohStmt* pStepStmt;
+    bohStmtSpan bodyStmts;
+} bohForStmt;
+
+
+void bohForStmtDestroy(bohForStmt* pStmt);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohForStmtCreateInPlace(bohForStmt* pStmt, const bohStmt* pInitStmt, const bohExpr* pCondExpr, const bohStmt* pStepStmt, const bohStmtSpan* pBodyStmts);
+
+const bohStmt* bohForStmtGetInitStmt(const bohForStmt* pStmt);
+const bohExpr* bohForStmtGetCondExpr(const bohForStmt* pStmt);
+const bohStmt* bohForStmtGetStepStmt(const bohForStmt* pStmt);
+const bohStmtSpan* bohForStmtGetBodyStmts(const bohForStmt* pStmt);
+
+bohForStmt* bohForStmtAssign(bohForStmt* pDst, const bohForStmt* pSrc);
+bohForStmt* bohForStmtMove(bohForStmt* pDst, bohForStmt* pSrc);
+
+
+// "for <identifier> in <begin>..<end> (: <step>)? {}" iterates over [begin, end), negative step counts down.
+// Bounds are evaluated once, the step is an integer constant. Iterator variable is read-only in the body
+typedef struct RangeForStmt
+{
+    const bohExpr* pIteratorExpr;
+    const bohExpr* pBeginExpr;
+    const bohExpr* pEndExpr;
+    int64_t step;
+    bohStmtSpan bodyStmts;
+} bohRangeForStmt;
+
+
+void bohRangeForStmtDestroy(bohRangeForStmt* pStmt);
+
+// NOTE: *CreateInPlace functions don't call destroy function
+void bohRangeForStmtCreateInPlace(bohRangeForStmt* pStmt, const bohExpr* pIteratorExpr, const bohExpr* pBeginExpr, const bohExpr* pEndExpr, 
+    int64_t step, const bohStmtSpan* pBodyStmts);
+
+const bohExpr* bohRangeForStmtGetIteratorExpr(const bohRangeForStmt* pStmt);
+const bohExpr* bohRangeForStmtGetBeginExpr(const bohRangeForStmt* pStmt);
+const bohExpr* bohRangeForStmtGetEndExpr(const bohRangeForStmt* pStmt);
+int64_t bohRangeForStmtGetStep(const bohRangeForStmt* pStmt);
+const bohStmtSpan* bohRangeForStmtGetBodyStmts(const bohRangeForStmt* pStmt);
+
+bohRangeForStmt* bohRangeForStmtAssign(bohRangeForStmt* pDst, const bohRangeForStmt* pSrc);
+bohRangeForStmt* bohRangeForStmtMove(bohRangeForStmt* pDst, bohRangeForStmt* pSrc);
+
+
 typedef enum StmtType
 {
     BOH_STMT_TYPE_EMPTY,
     BOH_STMT_TYPE_PRINT,
     BOH_STMT_TYPE_IF,
     BOH_STMT_TYPE_ASSIGNMENT,
+    BOH_STMT_TYPE_FUNC,
+    BOH_STMT_TYPE_RETURN,
+    BOH_STMT_TYPE_EXPR,
+    BOH_STMT_TYPE_WHILE,
+    BOH_STMT_TYPE_FOR,
+    BOH_STMT_TYPE_RANGE_FOR,
 } bohStmtType;
 
 
@@ -287,6 +585,12 @@ typedef struct Stmt
         bohIfStmt ifStmt;
         bohPrintStmt printStmt;
         bohAssignmentStmt assignStmt;
+        bohFuncStmt funcStmt;
+        bohReturnStmt returnStmt;
+        bohExprStmt exprStmt;
+        bohWhileStmt whileStmt;
+        bohForStmt forStmt;
+        bohRangeForStmt rangeForStmt;
     };
     
     bohLineNmb line;
@@ -298,17 +602,36 @@ void bohStmtDestroy(bohStmt* pStmt);
 
 // NOTE: *CreateInPlace functions don't call destroy function
 void bohStmtCreatePrintInPlace(bohStmt* pStmt, const bohExpr* pArgExpr, bohLineNmb line, bohColumnNmb column);
-void bohStmtCreateIfInPlace(bohStmt* pStmt, const bohExpr* pCondExpr, bohDynArray* pThenStmtPtrs, bohDynArray* pElseStmtPtrs, bohLineNmb line, bohColumnNmb column);
-void bohStmtCreateAssignInPlace(bohStmt* pStmt, const bohExpr* pLeft, const bohExpr* pRight, bohLineNmb line, bohColumnNmb column);
+void bohStmtCreateIfInPlace(bohStmt* pStmt, const bohExpr* pCondExpr, const bohStmtSpan* pThenStmts, const bohStmtSpan* pElseStmts, bohLineNmb line, bohColumnNmb column);
+void bohStmtCreateAssignInPlace(bohStmt* pStmt, const bohExpr* pLeft, const bohExpr* pRight, bohExprOperator op, bohLineNmb line, bohColumnNmb column);
+void bohStmtCreateFuncInPlace(bohStmt* pStmt, const bohStringView* pName, bohStringViewSmallVec* pParamNames, const bohStmtSpan* pBodyStmts, bohLineNmb line, bohColumnNmb column);
+void bohStmtCreateReturnInPlace(bohStmt* pStmt, const bohExpr* pValueExpr, bohLineNmb line, bohColumnNmb column);
+void bohStmtCreateExprInPlace(bohStmt* pStmt, const bohExpr* pExpr, bohLineNmb line, bohColumnNmb column);
+void bohStmtCreateWhileInPlace(bohStmt* pStmt, const bohExpr* pCondExpr, const bohStmtSpan* pBodyStmts, bool isDoWhile, bohLineNmb line, bohColumnNmb column);
+void bohStmtCreateForInPlace(bohStmt* pStmt, const bohStmt* pInitStmt, const bohExpr* pCondExpr, const bohStmt* pStepStmt, const bohStmtSpan* pBodyStmts, bohLineNmb line, bohColumnNmb column);
+void bohStmtCreateRangeForInPlace(bohStmt* pStmt, const bohExpr* pIteratorExpr, const bohExpr* pBeginExpr, const bohExpr* pEndExpr, int64_t step, 
+    const bohStmtSpan* pBodyStmts, bohLineNmb line, bohColumnNmb column);
 
 bool bohStmtIsEmpty(const bohStmt* pStmt);
 bool bohStmtIsPrint(const bohStmt* pStmt);
 bool bohStmtIsIf(const bohStmt* pStmt);
 bool bohStmtIsAssignment(const bohStmt* pStmt);
+bool bohStmtIsFunc(const bohStmt* pStmt);
+bool bohStmtIsReturn(const bohStmt* pStmt);
+bool bohStmtIsExpr(const bohStmt* pStmt);
+bool bohStmtIsWhile(const bohStmt* pStmt);
+bool bohStmtIsFor(const bohStmt* pStmt);
+bool bohStmtIsRangeFor(const bohStmt* pStmt);
 
 const bohPrintStmt* bohStmtGetPrint(const bohStmt* pStmt);
 const bohIfStmt* bohStmtGetIf(const bohStmt* pStmt);
 const bohAssignmentStmt* bohStmtGetAssignment(const bohStmt* pStmt);
+const bohFuncStmt* bohStmtGetFunc(const bohStmt* pStmt);
+const bohReturnStmt* bohStmtGetReturn(const bohStmt* pStmt);
+const bohExprStmt* bohStmtGetExpr(const bohStmt* pStmt);
+const bohWhileStmt* bohStmtGetWhile(const bohStmt* pStmt);
+const bohForStmt* bohStmtGetFor(const bohStmt* pStmt);
+const bohRangeForStmt* bohStmtGetRangeFor(const bohStmt* pStmt);
 
 bohStmt* bohStmtAssign(bohStmt* pDst, const bohStmt* pSrc);
 bohStmt* bohStmtMove(bohStmt* pDst, bohStmt* pSrc);
@@ -320,10 +643,16 @@ bohColumnNmb bohStmtGetColumn(const bohStmt* pStmt);
 
 typedef struct AST
 {
-    bohDynArray stmtPtrsStorage;
+    bohStmtPtrArray stmtPtrsStorage;
+
+    bohPoolAllocator stmtPool;
+    bohPoolAllocator exprPool;
+    bohArenaAllocator stringMemArena;    // Unescaped string literals
+    bohArenaAllocator stmtSpansMemArena; // const bohStmt*, exact-sized block statements spans
+
+    bohConstantPool constantPool;
 
-    bohArenaAllocator stmtMemArena;
-    bohArenaAllocator epxrMemArena;
+    uint32_t globalFrameSlotsCount; // Set by the resolver
 } bohAST;
 
 
@@ -334,21 +663,34 @@ bohAST bohAstCreate(void);
 bohExpr* bohAstAllocateExpr(bohAST* pAst);
 bohStmt* bohAstAllocateStmt(bohAST* pAst);
 
+// Destroys the node and returns its memory to the pool for reuse. Child nodes are not freed
+void bohAstFreeExpr(bohAST* pAst, bohExpr* pExpr);
+void bohAstFreeStmt(bohAST* pAst, bohStmt* pStmt);
+
 bohStmt** bohAstPushStmtPtr(bohAST* pAst, bohStmt* pStmt);
 
 const bohStmt* bohAstGetStmtByIdx(const bohAST* pAst, size_t index);
 
+bohConstantIdx bohAstAddNumberConstant(bohAST* pAst, bohNumber number);
+bohConstantIdx bohAstAddStringConstantMove(bohAST* pAst, bohBoharesString* pString);
+const bohConstant* bohAstGetConstant(const bohAST* pAst, const bohValueExpr* pExpr);
+
 size_t bohAstGetStmtCount(const bohAST* pAst);
+
+void bohAstSetGlobalFrameSlotsCount(bohAST* pAst, uint32_t slotsCount);
+uint32_t bohAstGetGlobalFrameSlotsCount(const bohAST* pAst);
 size_t bohAstGetMemorySize(const bohAST* pAst);
 
 
-typedef bohDynArray bohTokenStorage;
+typedef struct bohTokenStorage bohTokenStorage;
 
 typedef struct Parser
 {
     const bohTokenStorage* pTokenStorage;
     size_t currTokenIdx;
 
+    bohStmtPtrArray stmtScratch; // Statements of the open blocks, inner block ones are on top
+
     bohAST ast;
 } bohParser;
 
@@ -357,5 +699,6 @@ bohParser bohParserCreate(const bohTokenStorage* pTokenStorage);
 void bohParserDestroy(bohParser* pParser);
 
 const bohAST* bohParserGetAST(const bohParser* pParser);
+bohAST* bohParserGetMutableAST(bohParser* pParser);
 
 void bohParserParse(bohParser* pParser);
@@ -13,6 +13,8 @@
 
 #include <assert.h>
 
+#include "utils/memory/memory.h"
+
 #include "utils/file/file.h"
 
 #include "utils/ds/string.h"
@@ -0,0 +1,532 @@
+#include "pch.h"
+
+#include "core.h"
+
+#include "resolver.h"
+#include "state/state.h"
+
+#include "error.h"
+
+
+#define BOH_RESOLVER_PRINT_ERROR(LINE, COLUMN, FMT, ...) \
+    bohErrorsStatePrintError(stderr, bohErrorsStateGerCurrProcessingFileGlobal(), LINE, COLUMN, "RESOLVER ERROR", FMT, __VA_ARGS__)
+
+#define BOH_RESOLVER_EXPECT(COND, LINE, COLUMN, FMT, ...)         \
+    if (!(COND)) {                                                \
+        BOH_RESOLVER_PRINT_ERROR(LINE, COLUMN, FMT, __VA_ARGS__); \
+        bohErrorsStatePushResolverErrorGlobal();                  \
+    }
+
+
+// AST is immutable for the interpreter only, the resolver annotates identifier nodes in place
+static bohIdentifierExpr* resGetMutableIdentifierExpr(const bohExpr* pExpr)
+{
+    BOH_ASSERT(bohExprIsIdentifierExpr(pExpr));
+    return (bohIdentifierExpr*)bohExprGetIdentifierExpr(pExpr);
+}
+
+
+static bohCallExpr* resGetMutableCallExpr(const bohExpr* pExpr)
+{
+    BOH_ASSERT(bohExprIsCallExpr(pExpr));
+    return (bohCallExpr*)bohExprGetCallExpr(pExpr);
+}
+
+
+static bohFuncStmt* resGetMutableFuncStmt(const bohStmt* pStmt)
+{
+    BOH_ASSERT(bohStmtIsFunc(pStmt));
+    return (bohFuncStmt*)bohStmtGetFunc(pStmt);
+}
+
+
+static void resBeginScope(bohResolver* pResolver)
+{
+    BOH_ASSERT(pResolver);
+
+    size_t* pScopeBegin = (size_t*)bohDynArrayPushBackDummy(&pResolver->scopeBegins);
+    *pScopeBegin = bohDynArrayGetSize(&pResolver->symbols);
+}
+
+
+static void resEndScope(bohResolver* pResolver)
+{
+    BOH_ASSERT(pResolver);
+
+    const size_t scopesCount = bohDynArrayGetSize(&pResolver->scopeBegins);
+    BOH_ASSERT(scopesCount > 0);
+
+    const size_t scopeBegin = *BOH_DYN_ARRAY_AT_CONST(size_t, &pResolver->scopeBegins, scopesCount - 1);
+
+    // Slots are given out sequentially, so the first symbol of the scope holds the lowest slot to release
+    if (scopeBegin < bohDynArrayGetSize(&pResolver->symbols)) {
+        const bohSymbol* pFirstSymbol = BOH_DYN_ARRAY_AT_CONST(bohSymbol, &pResolver->symbols, scopeBegin);
+        pResolver->frameSlotsCount = pFirstSymbol->slot;
+    }
+
+    bohDynArrayResize(&pResolver->symbols, scopeBegin);
+    bohDynArrayResize(&pResolver->scopeBegins, scopesCount - 1);
+}
+
+
+static const bohSymbol* resFindSymbol(const bohResolver* pResolver, const bohStrID* pName)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pName);
+
+    // Searching from the innermost scope makes inner declarations shadow outer ones
+    for (size_t i = bohDynArrayGetSize(&pResolver->symbols); i > 0; --i) {
+        const bohSymbol* pSymbol = BOH_DYN_ARRAY_AT_CONST(bohSymbol, &pResolver->symbols, i - 1);
+
+        if (bohStrIDEqual(&pSymbol->name, pName)) {
+            return pSymbol;
+        }
+    }
+
+    return NULL;
+}
+
+
+static const bohSymbol* resDeclareVariable(bohResolver* pResolver, const bohStrID* pName, bool isReadOnly)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pName);
+
+    bohSymbol* pSymbol = (bohSymbol*)bohDynArrayPushBackDummy(&pResolver->symbols);
+
+    bohStrIDAssign(&pSymbol->name, pName);
+    pSymbol->frameLevel = pResolver->frameLevel;
+    pSymbol->slot = pResolver->frameSlotsCount++;
+    pSymbol->type = BOH_SYMBOL_TYPE_VAR;
+    pSymbol->isReadOnly = isReadOnly;
+    pSymbol->pFuncStmt = NULL;
+
+    if (pResolver->frameSlotsCount > pResolver->frameMaxSlotsCount) {
+        pResolver->frameMaxSlotsCount = pResolver->frameSlotsCount;
+    }
+
+    return pSymbol;
+}
+
+
+static void resDeclareFunc(bohResolver* pResolver, const bohStmt* pStmt)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pStmt);
+
+    const bohStrID nameID = bohStrIDCreateStringView(bohFuncStmtGetName(bohStmtGetFunc(pStmt)));
+    const bohSymbol* pPrevSymbol = resFindSymbol(pResolver, &nameID);
+
+    BOH_RESOLVER_EXPECT(!pPrevSymbol, bohStmtGetLine(pStmt), bohStmtGetColumn(pStmt), "function redefinition: %s", 
+        bohStrIDGetCStr(&nameID));
+
+    if (pPrevSymbol) {
+        return;
+    }
+
+    bohSymbol* pSymbol = (bohSymbol*)bohDynArrayPushBackDummy(&pResolver->symbols);
+
+    bohStrIDAssign(&pSymbol->name, &nameID);
+    pSymbol->frameLevel = pResolver->frameLevel;
+    pSymbol->slot = pResolver->frameSlotsCount; // Functions take no slot, the value only keeps resEndScope release point valid
+    pSymbol->type = BOH_SYMBOL_TYPE_FUNC;
+    pSymbol->isReadOnly = true;
+    pSymbol->pFuncStmt = pStmt;
+}
+
+
+static void resBindIdentifier(const bohResolver* pResolver, const bohExpr* pExpr, const bohSymbol* pSymbol)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pSymbol);
+    BOH_ASSERT(pSymbol->frameLevel <= pResolver->frameLevel);
+
+    const uint32_t depth = pResolver->frameLevel - pSymbol->frameLevel;
+    bohIdentifierExprSetStorage(resGetMutableIdentifierExpr(pExpr), depth, pSymbol->slot);
+}
+
+
+static void resResolveExpr(bohResolver* pResolver, const bohExpr* pExpr);
+
+
+static void resResolveCallExpr(bohResolver* pResolver, const bohExpr* pExpr)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pExpr);
+
+    const bohCallExpr* pCallExpr = bohExprGetCallExpr(pExpr);
+    const size_t argsCount = bohCallExprGetArgsCount(pCallExpr);
+
+    for (size_t i = 0; i < argsCount; ++i) {
+        resResolveExpr(pResolver, bohCallExprGetArgAt(pCallExpr, i));
+    }
+
+    const bohStringView* pName = bohCallExprGetName(pCallExpr);
+    const bohStrID nameID = bohStrIDCreateStringView(pName);
+
+    const bohSymbol* pSymbol = resFindSymbol(pResolver, &nameID);
+    const bool isFunc = pSymbol && pSymbol->type == BOH_SYMBOL_TYPE_FUNC;
+
+    BOH_RESOLVER_EXPECT(isFunc, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), "undefined function: %.*s",
+        (int)bohStringViewGetSize(pName), bohStringViewGetData(pName));
+
+    if (!isFunc) {
+        return;
+    }
+
+    const size_t paramsCount = bohFuncStmtGetParamsCount(bohStmtGetFunc(pSymbol->pFuncStmt));
+
+    BOH_RESOLVER_EXPECT(argsCount == paramsCount, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), 
+        "function %.*s expects %zu arguments, got %zu", (int)bohStringViewGetSize(pName), bohStringViewGetData(pName), paramsCount, argsCount);
+
+    bohCallExprSetFuncStmt(resGetMutableCallExpr(pExpr), pSymbol->pFuncStmt);
+}
+
+
+static void resResolveExpr(bohResolver* pResolver, const bohExpr* pExpr)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pExpr);
+
+    switch (bohExprGetType(pExpr)) {
+        case BOH_EXPR_TYPE_VALUE:
+            break;
+        case BOH_EXPR_TYPE_UNARY:
+            resResolveExpr(pResolver, bohUnaryExprGetExpr(bohExprGetUnaryExpr(pExpr)));
+            break;
+        case BOH_EXPR_TYPE_BINARY:
+            resResolveExpr(pResolver, bohBinaryExprGetLeftExpr(bohExprGetBinaryExpr(pExpr)));
+            resResolveExpr(pResolver, bohBinaryExprGetRightExpr(bohExprGetBinaryExpr(pExpr)));
+            break;
+        case BOH_EXPR_TYPE_IDENTIFIER:
+        {
+            const bohStringView* pName = bohIdentifierExprGetName(bohExprGetIdentifierExpr(pExpr));
+            const bohStrID nameID = bohStrIDCreateStringView(pName);
+
+            const bohSymbol* pSymbol = resFindSymbol(pResolver, &nameID);
+            BOH_RESOLVER_EXPECT(pSymbol, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), "undefined variable: %.*s",
+                bohStringViewGetSize(pName), bohStringViewGetData(pName));
+
+            const bool isFunc = pSymbol && pSymbol->type == BOH_SYMBOL_TYPE_FUNC;
+            BOH_RESOLVER_EXPECT(!isFunc, bohExprGetLine(pExpr), bohExprGetColumn(pExpr), "function can't be used as a value: %.*s",
+                (int)bohStringViewGetSize(pName), bohStringViewGetData(pName));
+
+            if (pSymbol && !isFunc) {
+                resBindIdentifier(pResolver, pExpr, pSymbol);
+            }
+            break;
+        }
+        case BOH_EXPR_TYPE_CALL:
+            resResolveCallExpr(pResolver, pExpr);
+            break;
+        case BOH_EXPR_TYPE_INDEX:
+        {
+            const bohIndexExpr* pIndexExpr = bohExprGetIndexExpr(pExpr);
+
+            const bohExpr* pBeginExpr = bohIndexExprGetBeginExpr(pIndexExpr);
+            const bohExpr* pEndExpr = bohIndexExprGetEndExpr(pIndexExpr);
+
+            resResolveExpr(pResolver, bohIndexExprGetObjectExpr(pIndexExpr));
+
+            if (pBeginExpr) {
+                resResolveExpr(pResolver, pBeginExpr);
+            }
+
+            if (pEndExpr) {
+                resResolveExpr(pResolver, pEndExpr);
+            }
+            break;
+        }
+        default:
+            BOH_ASSERT_FAIL("Invalid expression type");
+            break;
+    }
+}
+
+
+static void resResolveStmt(bohResolver* pResolver, const bohStmt* pStmt);
+
+
+static void resResolveBlock(bohResolver* pResolver, const bohStmtSpan* pStmts)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pStmts);
+
+    resBeginScope(pResolver);
+
+    const size_t stmtsCount = bohStmtSpanGetSize(pStmts);
+
+    for (size_t i = 0; i < stmtsCount; ++i) {
+        resResolveStmt(pResolver, bohStmtSpanAt(pStmts, i));
+    }
+
+    resEndScope(pResolver);
+}
+
+
+static void resResolveAssignmentStmt(bohResolver* pResolver, const bohStmt* pStmt)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pStmt);
+
+    const bohAssignmentStmt* pAssignStmt = bohStmtGetAssignment(pStmt);
+    const bohExpr* pLeftExpr = bohAssignmentStmtGetLeftExpr(pAssignStmt);
+
+    // Right side is resolved first, so "x = x" can't see the variable it declares
+    resResolveExpr(pResolver, bohAssignmentStmtGetRightExpr(pAssignStmt));
+
+    BOH_RESOLVER_EXPECT(bohExprIsIdentifierExpr(pLeftExpr), bohExprGetLine(pLeftExpr), bohExprGetColumn(pLeftExpr),
+        "left side of assignment must be a variable");
+
+    if (!bohExprIsIdentifierExpr(pLeftExpr)) {
+        return;
+    }
+
+    const bohStrID nameID = bohStrIDCreateStringView(bohIdentifierExprGetName(bohExprGetIdentifierExpr(pLeftExpr)));
+
+    const bohSymbol* pSymbol = resFindSymbol(pResolver, &nameID);
+
+    // Compound assignment reads the variable, so it can't declare one
+    if (bohAssignmentStmtIsCompound(pAssignStmt)) {
+        BOH_RESOLVER_EXPECT(pSymbol, bohExprGetLine(pLeftExpr), bohExprGetColumn(pLeftExpr), "undefined variable: %s", 
+            bohStrIDGetCStr(&nameID));
+
+        if (!pSymbol) {
+            return;
+        }
+    } else if (!pSymbol) {
+        pSymbol = resDeclareVariable(pResolver, &nameID, false);
+    }
+
+    BOH_RESOLVER_EXPECT(pSymbol->type != BOH_SYMBOL_TYPE_FUNC, bohExprGetLine(pLeftExpr), bohExprGetColumn(pLeftExpr),
+        "can't assign to function: %s", bohStrIDGetCStr(&nameID));
+    BOH_RESOLVER_EXPECT(pSymbol->type != BOH_SYMBOL_TYPE_VAR || !pSymbol->isReadOnly, bohExprGetLine(pLeftExpr), bohExprGetColumn(pLeftExpr),
+        "can't assign to range loop variable: %s", bohStrIDGetCStr(&nameID));
+
+    if (pSymbol->type == BOH_SYMBOL_TYPE_VAR) {
+        resBindIdentifier(pResolver, pLeftExpr, pSymbol);
+    }
+}
+
+
+// Function body gets its own frame, globals are reached through the parent frame link
+static void resResolveFuncStmt(bohResolver* pResolver, const bohStmt* pStmt)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pStmt);
+
+    const bool isTopLevel = pResolver->frameLevel == 0 && bohDynArrayGetSize(&pResolver->scopeBegins) == 1;
+    BOH_RESOLVER_EXPECT(isTopLevel, bohStmtGetLine(pStmt), bohStmtGetColumn(pStmt), "functions can be declared at the top level only");
+
+    if (!isTopLevel) {
+        return;
+    }
+
+    const bohFuncStmt* pFuncStmt = bohStmtGetFunc(pStmt);
+
+    const uint32_t outerFrameSlotsCount = pResolver->frameSlotsCount;
+    const uint32_t outerFrameMaxSlotsCount = pResolver->frameMaxSlotsCount;
+
+    ++pResolver->frameLevel;
+    pResolver->frameSlotsCount = 0;
+    pResolver->frameMaxSlotsCount = 0;
+
+    resBeginScope(pResolver);
+
+    // Parameters take the first slots, the caller places arguments there
+    const size_t paramsCount = bohFuncStmtGetParamsCount(pFuncStmt);
+
+    for (size_t i = 0; i < paramsCount; ++i) {
+        const bohStringView* pParamName = bohFuncStmtGetParamNameAt(pFuncStmt, i);
+        
+        for (size_t j = 0; j < i; ++j) {
+            BOH_RESOLVER_EXPECT(!bohStringViewEqualPtr(pParamName, bohFuncStmtGetParamNameAt(pFuncStmt, j)), bohStmtGetLine(pStmt), bohStmtGetColumn(pStmt), 
+                "duplicate parameter name: %.*s", bohStringViewGetSize(pParamName), bohStringViewGetData(pParamName));
+        }
+
+        const bohStrID paramID = bohStrIDCreateStringView(pParamName);
+        resDeclareVariable(pResolver, &paramID, false);
+    }
+
+    const size_t stmtsCount = bohFuncStmtGetBodyStmtsCount(pFuncStmt);
+
+    for (size_t i = 0; i < stmtsCount; ++i) {
+        resResolveStmt(pResolver, bohFuncStmtGetBodyStmtAt(pFuncStmt, i));
+    }
+
+    resEndScope(pResolver);
+
+    bohFuncStmtSetFrameSlotsCount(resGetMutableFuncStmt(pStmt), pResolver->frameMaxSlotsCount);
+
+    --pResolver->frameLevel;
+    pResolver->frameSlotsCount = outerFrameSlotsCount;
+    pResolver->frameMaxSlotsCount = outerFrameMaxSlotsCount;
+}
+
+
+// Variables declared by the initializer are visible in the whole loop only
+static void resResolveForStmt(bohResolver* pResolver, const bohForStmt* pForStmt)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pForStmt);
+
+    resBeginScope(pResolver);
+
+    if (bohForStmtGetInitStmt(pForStmt)) {
+        resResolveStmt(pResolver, bohForStmtGetInitStmt(pForStmt));
+    }
+
+    if (bohForStmtGetCondExpr(pForStmt)) {
+        resResolveExpr(pResolver, bohForStmtGetCondExpr(pForStmt));
+    }
+
+    resResolveBlock(pResolver, bohForStmtGetBodyStmts(pForStmt));
+
+    if (bohForStmtGetStepStmt(pForStmt)) {
+        resResolveStmt(pResolver, bohForStmtGetStepStmt(pForStmt));
+    }
+
+    resEndScope(pResolver);
+}
+
+
+// Bounds are resolved before the iterator is declared, so "for i in 0..i" reads the outer "i"
+static void resResolveRangeForStmt(bohResolver* pResolver, const bohRangeForStmt* pRangeForStmt)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pRangeForStmt);
+
+    resResolveExpr(pResolver, bohRangeForStmtGetBeginExpr(pRangeForStmt));
+    resResolveExpr(pResolver, bohRangeForStmtGetEndExpr(pRangeForStmt));
+
+    resBeginScope(pResolver);
+
+    const bohExpr* pIteratorExpr = bohRangeForStmtGetIteratorExpr(pRangeForStmt);
+    const bohStrID nameID = bohStrIDCreateStringView(bohIdentifierExprGetName(bohExprGetIdentifierExpr(pIteratorExpr)));
+
+    resBindIdentifier(pResolver, pIteratorExpr, resDeclareVariable(pResolver, &nameID, true));
+    resResolveBlock(pResolver, bohRangeForStmtGetBodyStmts(pRangeForStmt));
+
+    resEndScope(pResolver);
+}
+
+
+static void resResolveStmt(bohResolver* pResolver, const bohStmt* pStmt)
+{
+    BOH_ASSERT(pResolver);
+    BOH_ASSERT(pStmt);
+
+    switch (bohStmtGetType(pStmt)) {
+        case BOH_STMT_TYPE_PRINT:
+            resResolveExpr(pResolver, bohPrintStmtGetArgExpr(bohStmtGetPrint(pStmt)));
+            break;
+        case BOH_STMT_TYPE_IF:
+        {
+            const bohIfStmt* pIfStmt = bohStmtGetIf(pStmt);
+
+            resResolveExpr(pResolver, bohIfStmtGetCondExpr(pIfStmt));
+            resResolveBlock(pResolver, bohIfStmtGetThenStmts(pIfStmt));
+            resResolveBlock(pResolver, bohIfStmtGetElseStmts(pIfStmt));
+            break;
+        }
+        case BOH_STMT_TYPE_ASSIGNMENT:
+            resResolveAssignmentStmt(pResolver, pStmt);
+            break;
+        case BOH_STMT_TYPE_FUNC:
+            resResolveFuncStmt(pResolver, pStmt);
+            break;
+        case BOH_STMT_TYPE_RETURN:
+        {
+            const bohExpr* pValueExpr = bohReturnStmtGetValueExpr(bohStmtGetReturn(pStmt));
+            
+            BOH_RESOLVER_EXPECT(pResolver->frameLevel > 0, bohStmtGetLine(pStmt), bohStmtGetColumn(pStmt), "\'return\' outside of function");
+
+            if (pValueExpr) {
+                resResolveExpr(pResolver, pValueExpr);
+            }
+            break;
+        }
+        case BOH_STMT_TYPE_EXPR:
+            resResolveExpr(pResolver, bohExprStmtGetExpr(bohStmtGetExpr(pStmt)));
+            break;
+        case BOH_STMT_TYPE_WHILE:
+        {
+            const bohWhileStmt* pWhileStmt = bohStmtGetWhile(pStmt);
+
+            // Condition of "do {} while" is evaluated after the body, but the body variables are already out of scope there
+            if (bohWhileStmtIsDoWhile(pWhileStmt)) {
+                resResolveBlock(pResolver, bohWhileStmtGetBodyStmts(pWhileStmt));
+                resResolveExpr(pResolver, bohWhileStmtGetCondExpr(pWhileStmt));
+            } else {
+                resResolveExpr(pResolver, bohWhileStmtGetCondExpr(pWhileStmt));
+                resResolveBlock(pResolver, bohWhileStmtGetBodyStmts(pWhileStmt));
+            }
+            break;
+        }
+        case BOH_STMT_TYPE_FOR:
+            resResolveForStmt(pResolver, bohStmtGetFor(pStmt));
+            break;
+        case BOH_STMT_TYPE_RANGE_FOR:
+            resResolveRangeForStmt(pResolver, bohStmtGetRangeFor(pStmt));
+            break;
+        default:
+            BOH_ASSERT_FAIL("Invalid statement type");
+            break;
+    }
+}
+
+
+bohResolver bohResolverCreate(bohAST* pAst)
+{
+    BOH_ASSERT(pAst);
+
+    bohResolver resolver;
+
+    resolver.pAst = pAst;
+    resolver.symbols = BOH_DYN_ARRAY_CREATE(bohSymbol, NULL, NULL, NULL);
+    resolver.scopeBegins = BOH_DYN_ARRAY_CREATE(size_t, NULL, NULL, NULL);
+    resolver.frameLevel = 0;
+    resolver.frameSlotsCount = 0;
+    resolver.frameMaxSlotsCount = 0;
+
+    return resolver;
+}
+
+
+void bohResolverDestroy(bohResolver* pResolver)
+{
+    BOH_ASSERT(pResolver);
+
+    bohDynArrayDestroy(&pResolver->symbols);
+    bohDynArrayDestroy(&pResolver->scopeBegins);
+
+    pResolver->pAst = NULL;
+}
+
+
+void bohResolverResolve(bohResolver* pResolver)
+{
+    BOH_ASSERT(pResolver);
+
+    bohAST* pAst = pResolver->pAst;
+    const size_t stmtsCount = bohAstGetStmtCount(pAst);
+
+    resBeginScope(pResolver);
+
+    // Functions are visible from the whole file, so they may call each other regardless of the declaration order
+    for (size_t i = 0; i < stmtsCount; ++i) {
+        const bohStmt* pStmt = bohAstGetStmtByIdx(pAst, i);
+
+        if (bohStmtIsFunc(pStmt)) {
+            resDeclareFunc(pResolver, pStmt);
+        }
+    }
+
+    for (size_t i = 0; i < stmtsCount; ++i) {
+        resResolveStmt(pResolver, bohAstGetStmtByIdx(pAst, i));
+    }
+
+    resEndScope(pResolver);
+
+    bohAstSetGlobalFrameSlotsCount(pAst, pResolver->frameMaxSlotsCount);
+}
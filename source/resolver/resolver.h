@@ -0,0 +1,28 @@
+#pragma once
+
+#include "utils/ds/dyn_array.h"
+
+#include "parser/parser.h"
+
+
+// Static pass between parsing and execution. Binds every identifier to a (depth, slot) pair and computes
+// frame sizes, so the interpreter reads variables by index and never looks names up.
+// Variable is declared by the first assignment to it, the declaration is visible until the end of the enclosing block.
+// Functions are declared at the top level only, their frames are linked to the global one
+typedef struct Resolver
+{
+    bohAST* pAst;
+
+    bohDynArray symbols;     // bohSymbol, the innermost scope symbols are the last ones
+    bohDynArray scopeBegins; // size_t, index of the first symbol of every open scope
+
+    uint32_t frameLevel;
+    uint32_t frameSlotsCount;    // Slots of the closed blocks are reused by the next ones
+    uint32_t frameMaxSlotsCount;
+} bohResolver;
+
+
+bohResolver bohResolverCreate(bohAST* pAst);
+void bohResolverDestroy(bohResolver* pResolver);
+
+void bohResolverResolve(bohResolver* pResolver);
@@ -5,11 +5,50 @@
 #include "core.h"
 
 
-bohStackFrame bohStackFrameCreateChild(const bohStackFrame* pParentScope)
+bohStackFrame bohStackFrameCreate(bohStackFrame* pParentScope, bohExprInterpResult* pSlots, size_t slotsCount)
 {
-    bohStackFrame frame = {0};
+    BOH_ASSERT(pSlots || slotsCount == 0);
+
+    bohStackFrame frame;
 
     frame.pParentScope = pParentScope;
+    frame.pSlots = pSlots;
+    frame.slotsCount = slotsCount;
 
     return frame;
 }
+
+
+void bohStackFrameDestroy(bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pFrame);
+
+    for (size_t i = 0; i < pFrame->slotsCount; ++i) {
+        bohExprInterpResultDestroy(&pFrame->pSlots[i]);
+    }
+
+    pFrame->pParentScope = NULL;
+    pFrame->pSlots = NULL;
+    pFrame->slotsCount = 0;
+}
+
+
+bohExprInterpResult* bohStackFrameGetSlot(bohStackFrame* pFrame, uint32_t depth, uint32_t slot)
+{
+    BOH_ASSERT(pFrame);
+
+    for (uint32_t i = 0; i < depth; ++i) {
+        pFrame = pFrame->pParentScope;
+        BOH_ASSERT_MSG(pFrame, "Variable depth is out of frames chain");
+    }
+
+    BOH_ASSERT(slot < pFrame->slotsCount);
+    return pFrame->pSlots + slot;
+}
+
+
+size_t bohStackFrameGetSlotsCount(const bohStackFrame* pFrame)
+{
+    BOH_ASSERT(pFrame);
+    return pFrame->slotsCount;
+}
@@ -2,6 +2,8 @@
 
 #include "utils/ds/strid.h"
 
+#include "interpreter/interpreter.h"
+
 
 typedef enum SymbolType
 {
@@ -13,15 +15,29 @@ typedef enum SymbolType
 typedef struct Symbol
 {
     bohStrID      name;
-    size_t        varSize;
+    uint32_t      frameLevel; // Nesting level of the frame which owns the symbol storage
+    uint32_t      slot;
     bohSymbolType type;
+    bool          isReadOnly; // Range loop iterators, the loop owns their value
+
+    const bohStmt* pFuncStmt; // Declaration of BOH_SYMBOL_TYPE_FUNC symbols
 } bohSymbol;
 
 
+// Variables are addressed by slot indices assigned by the resolver, frame size is known before it is created.
+// Slots storage is owned by the caller, the interpreter takes it from the call stack
 typedef struct StackFrame
 {
     struct StackFrame* pParentScope;
+
+    bohExprInterpResult* pSlots;
+    size_t slotsCount;
 } bohStackFrame;
 
 
-bohStackFrame bohStackFrameCreateChild(const bohStackFrame* pParentScope);
\ No newline at end of file
+// Slots must be initialized, the frame destroys their values but doesn't free the storage
+bohStackFrame bohStackFrameCreate(bohStackFrame* pParentScope, bohExprInterpResult* pSlots, size_t slotsCount);
+void bohStackFrameDestroy(bohStackFrame* pFrame);
+
+bohExprInterpResult* bohStackFrameGetSlot(bohStackFrame* pFrame, uint32_t depth, uint32_t slot);
+size_t bohStackFrameGetSlotsCount(const bohStackFrame* pFrame);
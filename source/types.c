@@ -3,6 +3,217 @@
 #include "core.h"
 #include "types.h"
 
+#include "utils/ds/hash.h"
+#include "utils/fmt/fmt.h"
+#include "utils/memory/pool_allocator.h"
+
+
+// Shorter concatenation results are copied right away, it is cheaper than a node and its later flattening
+#define BOH_ROPE_MIN_SIZE 64
+// Concatenation keeps ropes height balanced, so this is only a safety bound on the recursion depth of the node walks
+#define BOH_ROPE_MAX_DEPTH 256
+
+// Slice shorter than 1/BOH_SLICE_MIN_PARENT_FRACTION of a parent of at least BOH_SLICE_PIN_PARENT_SIZE bytes is copied
+#define BOH_SLICE_MIN_PARENT_FRACTION 16
+#define BOH_SLICE_PIN_PARENT_SIZE     4096
+
+#define BOH_ROPE_NODE_POOL_SLAB_CAPACITY 1024
+
+
+struct RopeNode
+{
+    size_t refCount;
+    size_t size;
+    uint32_t depth;         // Number of nested nodes levels, 0 once flattened
+    bool isFlat;
+    bool isHashed;          // Content is immutable, so the hash is computed once, on the first equality check
+
+    uint64_t hash;
+
+    bohBoharesString left;  // Holds the whole string once flattened, the right one is empty then
+    bohBoharesString right;
+};
+
+
+// Nodes are created and released on every concatenation and sharing, the pool reuses freed nodes instead of the heap
+static bohPoolAllocator s_ropeNodePool;
+// Shared nodes may outlive an allocator scoped around the string operation that created them (example: interpreter
+// scratch memory), so the buffers they allocate themselves come from the allocator current at the engine init
+static const bohAllocator* s_pRopeNodeAllocator = NULL;
+
+
+void bohBoharesStringEngineInit(void)
+{
+    s_ropeNodePool = BOH_POOL_ALLOCATOR_CREATE(bohRopeNode, BOH_ROPE_NODE_POOL_SLAB_CAPACITY);
+    s_pRopeNodeAllocator = bohMemGetAllocator();
+}
+
+
+void bohBoharesStringEngineTerminate(void)
+{
+    BOH_ASSERT_MSG(bohPoolAllocatorGetAllocatedCount(&s_ropeNodePool) == 0, "Rope nodes leak");
+    bohPoolAllocatorDestroy(&s_ropeNodePool);
+}
+
+
+// Flattened node holds a single string, so it is a leaf as any other non rope string
+static uint32_t ropeGetDepth(const bohBoharesString* pString)
+{
+    return bohBoharesStringIsRope(pString) && !pString->pRope->isFlat ? pString->pRope->depth + 1 : 0;
+}
+
+
+static void ropeNodeRelease(bohRopeNode* pNode)
+{
+    BOH_ASSERT(pNode);
+    BOH_ASSERT(pNode->refCount > 0);
+
+    if (--pNode->refCount > 0) {
+        return;
+    }
+
+    bohBoharesStringDestroy(&pNode->left);
+    bohBoharesStringDestroy(&pNode->right);
+
+    bohPoolAllocatorFree(&s_ropeNodePool, pNode);
+}
+
+
+static void ropeCopyTo(const bohBoharesString* pString, char* pDst);
+
+
+static void ropeNodeCopyTo(const bohRopeNode* pNode, char* pDst)
+{
+    BOH_ASSERT(pNode);
+    BOH_ASSERT(pDst);
+
+    ropeCopyTo(&pNode->left, pDst);
+    ropeCopyTo(&pNode->right, pDst + bohBoharesStringGetSize(&pNode->left));
+}
+
+
+static void ropeCopyTo(const bohBoharesString* pString, char* pDst)
+{
+    if (bohBoharesStringIsRope(pString)) {
+        ropeNodeCopyTo(pString->pRope, pDst);
+        return;
+    }
+
+    const size_t size = bohBoharesStringGetSize(pString);
+
+    if (size > 0) {
+        memcpy(pDst, bohBoharesStringGetData(pString), size);
+    }
+}
+
+
+// Node content doesn't change, so all rope copies see the flattened string
+static void ropeNodeFlatten(bohRopeNode* pNode)
+{
+    BOH_ASSERT(pNode);
+
+    if (pNode->isFlat) {
+        return;
+    }
+
+    const bohAllocator* pPrevAllocator = bohMemSetAllocator(s_pRopeNodeAllocator);
+
+    bohString flat = bohStringCreate();
+    bohStringResize(&flat, pNode->size);
+
+    bohMemSetAllocator(pPrevAllocator);
+
+    ropeNodeCopyTo(pNode, bohStringGetData(&flat));
+
+    bohBoharesStringDestroy(&pNode->left);
+    bohBoharesStringDestroy(&pNode->right);
+
+    pNode->left.type = BOH_STRING_TYPE_STRING;
+    pNode->left.string = flat;
+
+    pNode->depth = 0;
+    pNode->isFlat = true;
+}
+
+
+// Inline strings are cheaper to copy than to share
+static bool ropeIsSharingWorth(const bohBoharesString* pString)
+{
+    return bohBoharesStringIsString(pString) && !bohStringIsInline(&pString->string);
+}
+
+
+static void internMakeString(bohBoharesString* pString)
+{
+    BOH_ASSERT(bohBoharesStringIsInterned(pString));
+
+    const bohStringView data = bohStringViewCreateConstCStrSized(bohStrIDGetCStr(&pString->internID), bohStrIDGetSize(&pString->internID));
+
+    pString->type = BOH_STRING_TYPE_STRING;
+    pString->string = bohStringCreateStringViewPtr(&data);
+}
+
+
+// Hash is free for interned strings and cached for the shared ones, other strings aren't worth hashing for a single comparison
+static bool internHasHash(const bohBoharesString* pString)
+{
+    return bohBoharesStringIsInterned(pString) || bohBoharesStringIsRope(pString);
+}
+
+
+static uint64_t internGetHash(const bohBoharesString* pString)
+{
+    BOH_ASSERT(internHasHash(pString));
+
+    if (bohBoharesStringIsInterned(pString)) {
+        return bohStrIDGetHash(&pString->internID);
+    }
+
+    bohRopeNode* pNode = pString->pRope;
+
+    if (!pNode->isHashed) {
+        pNode->hash = bohHashCStr(bohBoharesStringGetData(pString), pNode->size);
+        pNode->isHashed = true;
+    }
+
+    return pNode->hash;
+}
+
+
+static void sliceMakeString(bohBoharesString* pString)
+{
+    BOH_ASSERT(bohBoharesStringIsSlice(pString));
+
+    bohString string = bohStringCreateStringViewPtr(&pString->slice.view);
+    ropeNodeRelease(pString->slice.pParent);
+
+    pString->type = BOH_STRING_TYPE_STRING;
+    pString->string = string;
+}
+
+
+// Turns rope into plain string before mutation, the flat buffer is taken over if no one else shares the node
+static void ropeMakeString(bohBoharesString* pString)
+{
+    BOH_ASSERT(bohBoharesStringIsRope(pString));
+
+    bohRopeNode* pNode = pString->pRope;
+    ropeNodeFlatten(pNode);
+
+    bohString string = bohStringCreate();
+    
+    if (pNode->refCount == 1) {
+        bohStringMove(&string, &pNode->left.string);
+    } else {
+        bohStringAssign(&string, &pNode->left.string);
+    }
+
+    ropeNodeRelease(pNode);
+
+    pString->type = BOH_STRING_TYPE_STRING;
+    pString->string = string;
+}
+
 
 bohBoharesString bohBoharesStringCreateStringView(void)
 {
@@ -83,11 +294,15 @@ void bohBoharesStringDestroy(bohBoharesString* pString)
 
     if (bohBoharesStringIsString(pString)) {
         bohStringDestroy(&pString->string);
-    } else {
-        bohStringViewReset(&pString->view);
+    } else if (bohBoharesStringIsRope(pString)) {
+        ropeNodeRelease(pString->pRope);
+    } else if (bohBoharesStringIsSlice(pString)) {
+        ropeNodeRelease(pString->slice.pParent);
     }
 
+    // Inline string leaves garbage in the view fields, so the view is always reset
     pString->type = BOH_STRING_TYPE_VIEW;
+    pString->view = bohStringViewCreate();
 }
 
 
@@ -99,8 +314,22 @@ bohBoharesString* bohBoharesStringAssign(bohBoharesString* pDst, const bohBohare
     bohBoharesStringDestroy(pDst);
 
     if (bohBoharesStringIsString(pSrc)) {
+        pDst->string = bohStringCreate();
         bohStringAssign(&pDst->string, &pSrc->string);
         pDst->type = BOH_STRING_TYPE_STRING;
+    } else if (bohBoharesStringIsRope(pSrc)) {
+        ++pSrc->pRope->refCount;
+
+        pDst->pRope = pSrc->pRope;
+        pDst->type = BOH_STRING_TYPE_ROPE;
+    } else if (bohBoharesStringIsSlice(pSrc)) {
+        ++pSrc->slice.pParent->refCount;
+
+        pDst->slice = pSrc->slice;
+        pDst->type = BOH_STRING_TYPE_SLICE;
+    } else if (bohBoharesStringIsInterned(pSrc)) {
+        bohStrIDAssign(&pDst->internID, &pSrc->internID);
+        pDst->type = BOH_STRING_TYPE_INTERNED;
     } else {
         bohStringViewAssignStringViewPtr(&pDst->view, &pSrc->view);
         pDst->type = BOH_STRING_TYPE_VIEW;
@@ -123,6 +352,7 @@ bohBoharesString* bohBoharesStringStringAssignStringViewPtr(bohBoharesString* pD
 
     bohBoharesStringDestroy(pDst);
 
+    pDst->string = bohStringCreate();
     bohStringAssignStringViewPtr(&pDst->string, pSrc);
     pDst->type = BOH_STRING_TYPE_STRING;
 
@@ -166,6 +396,14 @@ bohBoharesString* bohBoharesStringResize(bohBoharesString* pString, size_t newSi
 {
     BOH_ASSERT(pString);
 
+    if (bohBoharesStringIsRope(pString)) {
+        ropeMakeString(pString);
+    } else if (bohBoharesStringIsSlice(pString)) {
+        sliceMakeString(pString);
+    } else if (bohBoharesStringIsInterned(pString)) {
+        internMakeString(pString);
+    }
+
     if (bohBoharesStringIsString(pString)) {
         bohStringResize(&pString->string, newSize);
     } else {
@@ -186,7 +424,20 @@ bohBoharesString* bohBoharesStringMove(bohBoharesString* pDst, bohBoharesString*
     pDst->type = pSrc->type;
 
     if (bohBoharesStringIsString(pSrc)) {
+        pDst->string = bohStringCreate();
         bohStringMove(&pDst->string, &pSrc->string);
+    } else if (bohBoharesStringIsRope(pSrc)) {
+        pDst->pRope = pSrc->pRope;
+
+        pSrc->type = BOH_STRING_TYPE_VIEW;
+        pSrc->view = bohStringViewCreate();
+    } else if (bohBoharesStringIsSlice(pSrc)) {
+        pDst->slice = pSrc->slice;
+
+        pSrc->type = BOH_STRING_TYPE_VIEW;
+        pSrc->view = bohStringViewCreate();
+    } else if (bohBoharesStringIsInterned(pSrc)) {
+        bohStrIDAssign(&pDst->internID, &pSrc->internID);
     } else {
         bohStringViewMove(&pDst->view, &pSrc->view);
     }
@@ -195,6 +446,66 @@ bohBoharesString* bohBoharesStringMove(bohBoharesString* pDst, bohBoharesString*
 }
 
 
+bohBoharesString* bohBoharesStringShare(bohBoharesString* pDst, bohBoharesString* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    bohBoharesStringMakeShared(pSrc);
+    return bohBoharesStringAssign(pDst, pSrc);
+}
+
+
+bohBoharesString* bohBoharesStringIntern(bohBoharesString* pString)
+{
+    BOH_ASSERT(pString);
+
+    if (bohBoharesStringIsInterned(pString)) {
+        return pString;
+    }
+
+    const bohStringView data = bohStringViewCreateConstCStrSized(bohBoharesStringGetData(pString), bohBoharesStringGetSize(pString));
+    const bohStrID internID = bohStrIDCreateStringView(&data);
+
+    bohBoharesStringDestroy(pString);
+
+    pString->type = BOH_STRING_TYPE_INTERNED;
+    pString->internID = internID;
+
+    return pString;
+}
+
+
+bohBoharesString* bohBoharesStringMakeShared(bohBoharesString* pString)
+{
+    BOH_ASSERT(pString);
+
+    if (!ropeIsSharingWorth(pString)) {
+        return pString;
+    }
+
+    bohRopeNode* pNode = BOH_POOL_ALLOCATOR_ALLOC(&s_ropeNodePool, bohRopeNode);
+    BOH_ASSERT(pNode);
+
+    pNode->refCount = 1;
+    pNode->size = bohStringGetSize(&pString->string);
+    pNode->depth = 0;
+    pNode->isFlat = true;
+    pNode->isHashed = false;
+    pNode->hash = 0;
+
+    pNode->left = bohBoharesStringCreateString();
+    pNode->right = bohBoharesStringCreateStringView();
+
+    bohStringMove(&pNode->left.string, &pString->string);
+
+    pString->type = BOH_STRING_TYPE_ROPE;
+    pString->pRope = pNode;
+
+    return pString;
+}
+
+
 bool bohBoharesStringIsStringView(const bohBoharesString* pString)
 {
     BOH_ASSERT(pString);
@@ -209,6 +520,27 @@ bool bohBoharesStringIsString(const bohBoharesString* pString)
 }
 
 
+bool bohBoharesStringIsRope(const bohBoharesString* pString)
+{
+    BOH_ASSERT(pString);
+    return pString->type == BOH_STRING_TYPE_ROPE;
+}
+
+
+bool bohBoharesStringIsSlice(const bohBoharesString* pString)
+{
+    BOH_ASSERT(pString);
+    return pString->type == BOH_STRING_TYPE_SLICE;
+}
+
+
+bool bohBoharesStringIsInterned(const bohBoharesString* pString)
+{
+    BOH_ASSERT(pString);
+    return pString->type == BOH_STRING_TYPE_INTERNED;
+}
+
+
 const bohStringView* bohBoharesStringGetStringView(const bohBoharesString* pString)
 {
     BOH_ASSERT(pString);
@@ -233,6 +565,13 @@ const char* bohBoharesStringGetData(const bohBoharesString* pString)
 
     if (bohBoharesStringIsString(pString)) {
         return bohStringGetCStr(&pString->string);
+    } else if (bohBoharesStringIsRope(pString)) {
+        ropeNodeFlatten(pString->pRope);
+        return bohStringGetCStr(&pString->pRope->left.string);
+    } else if (bohBoharesStringIsSlice(pString)) {
+        return bohStringViewGetData(&pString->slice.view);
+    } else if (bohBoharesStringIsInterned(pString)) {
+        return bohStrIDGetCStr(&pString->internID);
     } else {
         return bohStringViewGetData(&pString->view);
     }
@@ -245,6 +584,12 @@ size_t bohBoharesStringGetSize(const bohBoharesString* pString)
 
     if (bohBoharesStringIsString(pString)) {
         return bohStringGetSize(&pString->string);
+    } else if (bohBoharesStringIsRope(pString)) {
+        return pString->pRope->size;
+    } else if (bohBoharesStringIsSlice(pString)) {
+        return bohStringViewGetSize(&pString->slice.view);
+    } else if (bohBoharesStringIsInterned(pString)) {
+        return bohStrIDGetSize(&pString->internID);
     } else {
         return bohStringViewGetSize(&pString->view);
     }
@@ -257,6 +602,11 @@ char bohBoharesStringAt(const bohBoharesString* pString, size_t index)
 
     if (bohBoharesStringIsString(pString)) {
         return bohStringAt(&pString->string, index);
+    } else if (bohBoharesStringIsRope(pString) || bohBoharesStringIsInterned(pString)) {
+        BOH_ASSERT(index < bohBoharesStringGetSize(pString));
+        return bohBoharesStringGetData(pString)[index];
+    } else if (bohBoharesStringIsSlice(pString)) {
+        return bohStringViewAt(&pString->slice.view, index);
     } else {
         return bohStringViewAt(&pString->view, index);
     }
@@ -265,6 +615,14 @@ char bohBoharesStringAt(const bohBoharesString* pString, size_t index)
 
 void bohBoharesStringSetAt(bohBoharesString* pString, char ch, size_t index)
 {
+    if (bohBoharesStringIsRope(pString)) {
+        ropeMakeString(pString);
+    } else if (bohBoharesStringIsSlice(pString)) {
+        sliceMakeString(pString);
+    } else if (bohBoharesStringIsInterned(pString)) {
+        internMakeString(pString);
+    }
+
     if (bohBoharesStringIsString(pString)) {
         bohStringSetAt(&pString->string, ch, index);
     } else {
@@ -279,6 +637,12 @@ bool bohBoharesStringIsEmpty(const bohBoharesString* pString)
 
     if (bohBoharesStringIsString(pString)) {
         return bohStringIsEmpty(&pString->string);
+    } else if (bohBoharesStringIsRope(pString)) {
+        return pString->pRope->size == 0;
+    } else if (bohBoharesStringIsSlice(pString)) {
+        return bohStringViewIsEmpty(&pString->slice.view);
+    } else if (bohBoharesStringIsInterned(pString)) {
+        return bohStrIDGetSize(&pString->internID) == 0;
     } else {
         return bohStringViewIsEmpty(&pString->view);
     }
@@ -296,8 +660,8 @@ int32_t bohBoharesStringCmp(const bohBoharesString* pLeft, const bohBoharesStrin
     BOH_ASSERT(pLeft);
     BOH_ASSERT(pRight);
 
-    const bohStringView left = bohBoharesStringIsString(pLeft) ? bohStringViewCreateConstString(&pLeft->string) : pLeft->view;
-    const bohStringView right = bohBoharesStringIsString(pRight) ? bohStringViewCreateConstString(&pRight->string) : pRight->view;
+    const bohStringView left = bohStringViewCreateConstCStrSized(bohBoharesStringGetData(pLeft), bohBoharesStringGetSize(pLeft));
+    const bohStringView right = bohStringViewCreateConstCStrSized(bohBoharesStringGetData(pRight), bohBoharesStringGetSize(pRight));
 
     return bohStringViewCmpPtr(&left, &right);
 }
@@ -305,13 +669,33 @@ int32_t bohBoharesStringCmp(const bohBoharesString* pLeft, const bohBoharesStrin
 
 bool bohBoharesStringEqual(const bohBoharesString* pLeft, const bohBoharesString* pRight)
 {
-    return bohBoharesStringCmp(pLeft, pRight) == 0;
+    BOH_ASSERT(pLeft);
+    BOH_ASSERT(pRight);
+
+    if (bohBoharesStringIsInterned(pLeft) && bohBoharesStringIsInterned(pRight)) {
+        return bohStrIDEqual(&pLeft->internID, &pRight->internID);
+    }
+
+    const size_t size = bohBoharesStringGetSize(pLeft);
+
+    if (size != bohBoharesStringGetSize(pRight)) {
+        return false;
+    }
+
+    if (internHasHash(pLeft) && internHasHash(pRight) && internGetHash(pLeft) != internGetHash(pRight)) {
+        return false;
+    }
+
+    const char* pLeftData = bohBoharesStringGetData(pLeft);
+    const char* pRightData = bohBoharesStringGetData(pRight);
+
+    return pLeftData == pRightData || memcmp(pLeftData, pRightData, size) == 0;
 }
 
 
 bool bohBoharesStringNotEqual(const bohBoharesString* pLeft, const bohBoharesString* pRight)
 {
-    return bohBoharesStringCmp(pLeft, pRight) != 0;
+    return !bohBoharesStringEqual(pLeft, pRight);
 }
 
 
@@ -344,23 +728,236 @@ bohBoharesString bohBoharesStringAdd(const bohBoharesString* pLeft, const bohBoh
     BOH_ASSERT(pLeft);
     BOH_ASSERT(pRight);
 
-    bohBoharesString result = bohBoharesStringCreateString();
+    // Rope operands are shared, not copied
+    bohBoharesString left = bohBoharesStringCreateStringView();
+    bohBoharesString right = bohBoharesStringCreateStringView();
 
-    if (bohBoharesStringIsString(pLeft)) {
-        if (bohBoharesStringIsString(pRight)) {
-            result.string = bohStringAdd(&pLeft->string, &pRight->string);
-        } else {
-            result.string = bohStringAddStringView(&pLeft->string, &pRight->view);
-        }
+    bohBoharesStringAssign(&left, pLeft);
+    bohBoharesStringAssign(&right, pRight);
+
+    return bohBoharesStringAddRValPtr(&left, &right);
+}
+
+
+// Takes over both strings
+static bohBoharesString ropeCreate(bohBoharesString* pLeft, bohBoharesString* pRight)
+{
+    bohRopeNode* pNode = BOH_POOL_ALLOCATOR_ALLOC(&s_ropeNodePool, bohRopeNode);
+    BOH_ASSERT(pNode);
+
+    const uint32_t leftDepth = ropeGetDepth(pLeft);
+    const uint32_t rightDepth = ropeGetDepth(pRight);
+
+    pNode->refCount = 1;
+    pNode->size = bohBoharesStringGetSize(pLeft) + bohBoharesStringGetSize(pRight);
+    pNode->depth = leftDepth > rightDepth ? leftDepth : rightDepth;
+    pNode->isFlat = false;
+    pNode->isHashed = false;
+    pNode->hash = 0;
+
+    pNode->left = bohBoharesStringCreateStringView();
+    pNode->right = bohBoharesStringCreateStringView();
+
+    bohBoharesStringMove(&pNode->left, pLeft);
+    bohBoharesStringMove(&pNode->right, pRight);
+
+    if (pNode->depth > BOH_ROPE_MAX_DEPTH) {
+        ropeNodeFlatten(pNode);
+    }
+
+    bohBoharesString rope = bohBoharesStringCreateStringView();
+
+    rope.type = BOH_STRING_TYPE_ROPE;
+    rope.pRope = pNode;
+
+    return rope;
+}
+
+
+// Takes the children of a not flattened rope and releases it. Children of a node shared with other ropes are shared too,
+// so splitting doesn't copy strings
+static void ropeSplit(bohBoharesString* pRope, bohBoharesString* pLeft, bohBoharesString* pRight)
+{
+    BOH_ASSERT(ropeGetDepth(pRope) > 0);
+
+    bohRopeNode* pNode = pRope->pRope;
+
+    if (pNode->refCount == 1) {
+        bohBoharesStringMove(pLeft, &pNode->left);
+        bohBoharesStringMove(pRight, &pNode->right);
     } else {
-        if (bohBoharesStringIsString(pRight)) {
-            result.string = bohStringViewAddString(&pLeft->view, &pRight->string);
-        } else {
-            result.string = bohStringViewAddStringView(&pLeft->view, &pRight->view);
+        bohBoharesStringShare(pLeft, &pNode->left);
+        bohBoharesStringShare(pRight, &pNode->right);
+    }
+
+    bohBoharesStringDestroy(pRope);
+}
+
+
+// AVL join by depth: the shallower string is joined to the facing side of the deeper one and the path back up is
+// rotated where the depths of siblings differ by more than one. Repeated appends and prepends create O(log n) nodes
+// each instead of a degenerate rope that has to be flattened
+static bohBoharesString ropeJoin(bohBoharesString* pLeft, bohBoharesString* pRight)
+{
+    const size_t size = bohBoharesStringGetSize(pLeft) + bohBoharesStringGetSize(pRight);
+
+    if (size < BOH_ROPE_MIN_SIZE) {
+        bohBoharesString result = bohBoharesStringCreateStringView();
+        
+        bohBoharesStringMove(&result, pLeft);
+        bohBoharesStringAppend(&result, pRight);
+
+        bohBoharesStringDestroy(pRight);
+
+        return result;
+    }
+
+    const uint32_t leftDepth = ropeGetDepth(pLeft);
+    const uint32_t rightDepth = ropeGetDepth(pRight);
+
+    bohBoharesString outer = bohBoharesStringCreateStringView();
+    bohBoharesString inner = bohBoharesStringCreateStringView();
+
+    if (leftDepth > rightDepth + 1) {
+        ropeSplit(pLeft, &outer, &inner);
+
+        bohBoharesString joined = ropeJoin(&inner, pRight);
+
+        if (ropeGetDepth(&joined) <= ropeGetDepth(&outer) + 1) {
+            return ropeCreate(&outer, &joined);
         }
+
+        // Joined part is two levels deeper than its sibling, its inner child is moved over to the sibling
+        bohBoharesString joinedInner = bohBoharesStringCreateStringView();
+        bohBoharesString joinedOuter = bohBoharesStringCreateStringView();
+
+        ropeSplit(&joined, &joinedInner, &joinedOuter);
+
+        if (ropeGetDepth(&joinedInner) <= ropeGetDepth(&joinedOuter)) {
+            bohBoharesString newInner = ropeCreate(&outer, &joinedInner);
+            return ropeCreate(&newInner, &joinedOuter);
+        }
+
+        bohBoharesString innerLeft = bohBoharesStringCreateStringView();
+        bohBoharesString innerRight = bohBoharesStringCreateStringView();
+
+        ropeSplit(&joinedInner, &innerLeft, &innerRight);
+
+        bohBoharesString newLeft = ropeCreate(&outer, &innerLeft);
+        bohBoharesString newRight = ropeCreate(&innerRight, &joinedOuter);
+
+        return ropeCreate(&newLeft, &newRight);
     }
 
-    return result;
+    if (rightDepth > leftDepth + 1) {
+        ropeSplit(pRight, &inner, &outer);
+
+        bohBoharesString joined = ropeJoin(pLeft, &inner);
+
+        if (ropeGetDepth(&joined) <= ropeGetDepth(&outer) + 1) {
+            return ropeCreate(&joined, &outer);
+        }
+
+        bohBoharesString joinedOuter = bohBoharesStringCreateStringView();
+        bohBoharesString joinedInner = bohBoharesStringCreateStringView();
+
+        ropeSplit(&joined, &joinedOuter, &joinedInner);
+
+        if (ropeGetDepth(&joinedInner) <= ropeGetDepth(&joinedOuter)) {
+            bohBoharesString newInner = ropeCreate(&joinedInner, &outer);
+            return ropeCreate(&joinedOuter, &newInner);
+        }
+
+        bohBoharesString innerLeft = bohBoharesStringCreateStringView();
+        bohBoharesString innerRight = bohBoharesStringCreateStringView();
+
+        ropeSplit(&joinedInner, &innerLeft, &innerRight);
+
+        bohBoharesString newLeft = ropeCreate(&joinedOuter, &innerLeft);
+        bohBoharesString newRight = ropeCreate(&innerRight, &outer);
+
+        return ropeCreate(&newLeft, &newRight);
+    }
+
+    return ropeCreate(pLeft, pRight);
+}
+
+
+bohBoharesString bohBoharesStringAddRValPtr(bohBoharesString* pLeft, bohBoharesString* pRight)
+{
+    BOH_ASSERT(pLeft);
+    BOH_ASSERT(pRight);
+
+    return ropeJoin(pLeft, pRight);
+}
+
+
+// View is copied into an owned string on the first append, the next appends reuse its spare capacity
+bohBoharesString* bohBoharesStringAppend(bohBoharesString* pDst, const bohBoharesString* pSrc)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pSrc);
+
+    if (bohBoharesStringIsRope(pDst)) {
+        ropeMakeString(pDst);
+    } else if (bohBoharesStringIsSlice(pDst)) {
+        sliceMakeString(pDst);
+    } else if (bohBoharesStringIsInterned(pDst)) {
+        internMakeString(pDst);
+    } else if (bohBoharesStringIsStringView(pDst)) {
+        bohString string = bohStringCreate();
+        bohStringAppendStringViewPtr(&string, &pDst->view);
+
+        bohStringViewReset(&pDst->view);
+
+        pDst->type = BOH_STRING_TYPE_STRING;
+        pDst->string = string;
+    }
+
+    bohStringAppendSizedCStr(&pDst->string, bohBoharesStringGetData(pSrc), bohBoharesStringGetSize(pSrc));
+
+    return pDst;
+}
+
+
+static bool promoteIsInRegion(const void* pMemory, const void* pRegion, size_t regionSize)
+{
+    return (const uint8_t*)pMemory >= (const uint8_t*)pRegion && (const uint8_t*)pMemory < (const uint8_t*)pRegion + regionSize;
+}
+
+
+// Only uniquely referenced nodes are walked, so promoting a concatenation with a long shared rope is O(new nodes)
+bohBoharesString* bohBoharesStringPromote(bohBoharesString* pString, const void* pRegion, size_t regionSize)
+{
+    BOH_ASSERT(pString);
+
+    switch (pString->type) {
+        case BOH_STRING_TYPE_STRING:
+            if (!bohStringIsInline(&pString->string) && promoteIsInRegion(bohStringGetData(&pString->string), pRegion, regionSize)) {
+                const bohStringView data = bohStringViewCreateConstCStrSized(bohStringGetData(&pString->string), bohStringGetSize(&pString->string));
+                bohString string = bohStringCreateStringViewPtr(&data);
+
+                bohStringDestroy(&pString->string);
+                pString->string = string;
+            }
+            break;
+        case BOH_STRING_TYPE_ROPE:
+            if (pString->pRope->refCount == 1) {
+                bohBoharesStringPromote(&pString->pRope->left, pRegion, regionSize);
+                bohBoharesStringPromote(&pString->pRope->right, pRegion, regionSize);
+            }
+            break;
+        case BOH_STRING_TYPE_SLICE:
+            if (pString->slice.pParent->refCount == 1 && promoteIsInRegion(bohStringViewGetData(&pString->slice.view), pRegion, regionSize)) {
+                sliceMakeString(pString);
+            }
+            break;
+        default:
+            // Views and interned strings don't own their data
+            break;
+    }
+
+    return pString;
 }
 
 
@@ -803,10 +1400,10 @@ bohString bohNumberToString(const bohNumber* pNumber)
 {
     BOH_ASSERT(pNumber);
 
-    char buff[256] = { 0 };
-    sprintf_s(buff, sizeof(buff) - 1, bohNumberIsF64(pNumber) ? "%.10f" : "%lld", BOH_NUMBER_GET_UNDERLYING_VALUE(pNumber));
+    char buff[BOH_FMT_NUMBER_MAX_SIZE];
+    const size_t size = bohNumberIsF64(pNumber) ? bohFmtF64(buff, pNumber->f64) : bohFmtI64(buff, pNumber->i64);
 
-    return bohStringCreateCStr(buff);
+    return bohStringCreateFromTo(buff, buff + size);
 }
 
 
@@ -837,3 +1434,53 @@ bohNumber* bohNumberMove(bohNumber* pDst, bohNumber* pSrc)
 
     return pDst;
 }
+
+
+bohBoharesString bohBoharesStringSlice(bohBoharesString* pString, size_t begin, size_t end)
+{
+    BOH_ASSERT(pString);
+    BOH_ASSERT(begin <= end);
+    BOH_ASSERT(end <= bohBoharesStringGetSize(pString));
+
+    const size_t size = end - begin;
+    // Slice of slice pins the same buffer
+    const size_t parentSize = bohBoharesStringIsSlice(pString) ? pString->slice.pParent->size : bohBoharesStringGetSize(pString);
+
+    const bool isPinningParent = parentSize >= BOH_SLICE_PIN_PARENT_SIZE && size < parentSize / BOH_SLICE_MIN_PARENT_FRACTION;
+
+    bohBoharesString result = bohBoharesStringCreateStringView();
+
+    if (bohBoharesStringIsStringView(pString) || bohBoharesStringIsInterned(pString)) {
+        // Interned data lives until the StrID engine termination, so it is viewed the same way
+        result.view = bohStringViewCreateConstCStrSized(bohBoharesStringGetData(pString) + begin, size);
+        return result;
+    }
+
+    const char* pData = bohBoharesStringGetData(pString);
+
+    if (size <= BOH_STRING_SSO_MAX_SIZE || isPinningParent) {
+        result.type = BOH_STRING_TYPE_STRING;
+        result.string = bohStringCreateFromTo(pData + begin, pData + end);
+
+        return result;
+    }
+
+    bohBoharesStringMakeShared(pString);
+
+    bohRopeNode* pParent = NULL;
+    
+    if (bohBoharesStringIsSlice(pString)) {
+        pParent = pString->slice.pParent;
+    } else {
+        BOH_ASSERT(bohBoharesStringIsRope(pString) && pString->pRope->isFlat);
+        pParent = pString->pRope;
+    }
+
+    ++pParent->refCount;
+
+    result.type = BOH_STRING_TYPE_SLICE;
+    result.slice.view = bohStringViewCreateConstCStrSized(pData + begin, size);
+    result.slice.pParent = pParent;
+
+    return result;
+}
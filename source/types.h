@@ -2,17 +2,33 @@
 
 #include "utils/ds/string.h"
 #include "utils/ds/string_view.h"
+#include "utils/ds/strid.h"
 
 #include <stdint.h>
 
 
 typedef enum StringType
 {
-    BOH_STRING_TYPE_VIEW,  // String literals (example: "Hello World")
-    BOH_STRING_TYPE_STRING // (example: var = "Hello World", var2 = var)
+    BOH_STRING_TYPE_VIEW,    // Non-owning view (example: lexemes)
+    BOH_STRING_TYPE_STRING,  // Uniquely owned, mutable (example: var = "Hello World", var += "!")
+    BOH_STRING_TYPE_ROPE,    // Shared, immutable (example: var = str1 + str2 + str3, var2 = var)
+    BOH_STRING_TYPE_SLICE,   // Part of the shared string (example: var = str[2..10])
+    BOH_STRING_TYPE_INTERNED // Stored in the StrID pool, immutable, copies and equality checks are O(1) (example: "Hello World")
 } bohStringType;
 
 
+// Immutable refcounted node shared by all copies of the rope. Concatenation node is flattened once, on the first data access.
+// Flat node is a copy-on-write buffer, mutation of the shared string copies it, mutation of the last reference takes the buffer over
+typedef struct RopeNode bohRopeNode;
+
+
+typedef struct StringSlice
+{
+    bohStringView view;   // Points into the parent buffer
+    bohRopeNode* pParent; // Flat node, it is kept alive while the slice exists
+} bohStringSlice;
+
+
 typedef struct BoharesString
 {
     bohStringType type;
@@ -20,10 +36,18 @@ typedef struct BoharesString
     union {
         bohStringView view;
         bohString string;
+        bohRopeNode* pRope;
+        bohStringSlice slice;
+        bohStrID internID;
     };
 } bohBoharesString;
 
 
+// Rope nodes are allocated from the engine pool, so the engine must outlive every rope and slice
+void bohBoharesStringEngineInit(void);
+void bohBoharesStringEngineTerminate(void);
+
+
 bohBoharesString bohBoharesStringCreateStringView(void);
 bohBoharesString bohBoharesStringCreateStringViewStringView(bohStringView strView);
 bohBoharesString bohBoharesStringCreateStringViewStringViewPtr(const bohStringView* pStrView);
@@ -46,13 +70,23 @@ bohBoharesString* bohBoharesStringStringViewAssignString(bohBoharesString* pDst,
 bohBoharesString* bohBoharesStringResize(bohBoharesString* pString, size_t newSize);
 
 bohBoharesString* bohBoharesStringMove(bohBoharesString* pDst, bohBoharesString* pSrc);
+// Heap string source is turned into the shared one, so this and the next copies cost a refcount increment only
+bohBoharesString* bohBoharesStringShare(bohBoharesString* pDst, bohBoharesString* pSrc);
+bohBoharesString* bohBoharesStringMakeShared(bohBoharesString* pString);
+// Moves the content into the StrID pool, it is never freed until the StrID engine termination, so intern only the strings
+// which live long or are compared often
+bohBoharesString* bohBoharesStringIntern(bohBoharesString* pString);
 
 bool bohBoharesStringIsStringView(const bohBoharesString* pString);
 bool bohBoharesStringIsString(const bohBoharesString* pString);
+bool bohBoharesStringIsRope(const bohBoharesString* pString);
+bool bohBoharesStringIsSlice(const bohBoharesString* pString);
+bool bohBoharesStringIsInterned(const bohBoharesString* pString);
 
 const bohStringView* bohBoharesStringGetStringView(const bohBoharesString* pString);
 const bohString* bohBoharesStringGetString(const bohBoharesString* pString);
 
+// Flattens rope, so the data is contiguous
 const char* bohBoharesStringGetData(const bohBoharesString* pString);
 size_t bohBoharesStringGetSize(const bohBoharesString* pString);
 
@@ -64,6 +98,7 @@ bool bohBoharesStringIsConstStringView(const bohBoharesString* pString);
 
 int32_t bohBoharesStringCmp(const bohBoharesString* pLeft, const bohBoharesString* pRight);
 
+// Interned strings are compared by ID, others are compared by size and cached hashes first
 bool bohBoharesStringEqual(const bohBoharesString* pLeft, const bohBoharesString* pRight);
 bool bohBoharesStringNotEqual(const bohBoharesString* pLeft, const bohBoharesString* pRight);
 bool bohBoharesStringLess(const bohBoharesString* pLeft, const bohBoharesString* pRight);
@@ -72,6 +107,18 @@ bool bohBoharesStringGreater(const bohBoharesString* pLeft, const bohBoharesStri
 bool bohBoharesStringGreaterEqual(const bohBoharesString* pLeft, const bohBoharesString* pRight);
 
 bohBoharesString bohBoharesStringAdd(const bohBoharesString* pLeft, const bohBoharesString* pRight);
+// Operands are moved into the result, long results are ropes, so chained concatenation doesn't copy the prefix again
+bohBoharesString bohBoharesStringAddRValPtr(bohBoharesString* pLeft, bohBoharesString* pRight);
+bohBoharesString* bohBoharesStringAppend(bohBoharesString* pDst, const bohBoharesString* pSrc);
+
+// Chars in [begin, end). Heap source becomes shared and the result points into its buffer without copying.
+// Short slices and small slices of huge strings are copied, so they don't pin the parent
+bohBoharesString bohBoharesStringSlice(bohBoharesString* pString, size_t begin, size_t end);
+
+// Copies the buffers which lie in [pRegion, pRegion + regionSize) out of it with the current allocator (example: a string
+// built in the interpreter scratch memory is assigned to a variable). Nodes shared with other strings are skipped,
+// the region must not be referenced by anything but this string
+bohBoharesString* bohBoharesStringPromote(bohBoharesString* pString, const void* pRegion, size_t regionSize);
 
 
 typedef struct Number bohNumber;
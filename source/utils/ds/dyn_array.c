@@ -40,7 +40,7 @@ void bohDynArrayDestroy(bohDynArray* pArray)
 
     bohDynArrayResize(pArray, 0);
 
-    free(pArray->pData);
+    bohMemFree(pArray->pData);
     pArray->pData = NULL;
     pArray->capacity = 0;
 
@@ -63,7 +63,7 @@ void bohDynArrayReserve(bohDynArray* pArray, size_t newCapacity)
     const size_t newCapacityInBytes = newCapacity * pArray->elementSize;
     const size_t elemSize = pArray->elementSize;
 
-    void* pNewBuffer = malloc(newCapacityInBytes);
+    void* pNewBuffer = bohMemAlloc(newCapacityInBytes);
     BOH_ASSERT(pNewBuffer);
 
     memset(pNewBuffer, 0, newCapacityInBytes);
@@ -96,7 +96,7 @@ void bohDynArrayReserve(bohDynArray* pArray, size_t newCapacity)
         }
     }
 
-    free(pOldBuffer);
+    bohMemFree(pOldBuffer);
 }
 
 
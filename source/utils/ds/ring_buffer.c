@@ -0,0 +1,120 @@
+#include "pch.h"
+
+#include "core.h"
+
+#include "ring_buffer.h"
+
+
+static size_t ringRoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+
+    while (result < value) {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+
+bohRingBuffer bohRingBufferCreate(size_t capacity)
+{
+    BOH_ASSERT(capacity > 0);
+
+    bohRingBuffer ring;
+    memset(&ring, 0, sizeof(bohRingBuffer));
+
+    ring.capacity = ringRoundUpToPowerOfTwo(capacity);
+    
+    ring.pData = (char*)bohMemAlloc(ring.capacity);
+    BOH_ASSERT(ring.pData);
+
+    return ring;
+}
+
+
+void bohRingBufferDestroy(bohRingBuffer* pRing)
+{
+    BOH_ASSERT(pRing);
+
+    bohMemFree(pRing->pData);
+    memset(pRing, 0, sizeof(bohRingBuffer));
+}
+
+
+size_t bohRingBufferGetCapacity(const bohRingBuffer* pRing)
+{
+    BOH_ASSERT(pRing);
+    return pRing->capacity;
+}
+
+
+size_t bohRingBufferWrite(bohRingBuffer* pRing, const void* pData, size_t size)
+{
+    BOH_ASSERT(pRing);
+    BOH_ASSERT(pData || size == 0);
+
+    const uint64_t writePos = pRing->producerWritePos;
+
+    size_t freeSize = pRing->capacity - (size_t)(writePos - pRing->cachedReadPos);
+
+    if (freeSize < size) {
+        pRing->cachedReadPos = BOH_ATOMIC_LOAD_ACQUIRE_U64(&pRing->readPos);
+        freeSize = pRing->capacity - (size_t)(writePos - pRing->cachedReadPos);
+    }
+
+    const size_t writeSize = size < freeSize ? size : freeSize;
+    if (writeSize == 0) {
+        return 0;
+    }
+
+    const size_t offset = (size_t)writePos & (pRing->capacity - 1);
+    const size_t firstPartSize = pRing->capacity - offset < writeSize ? pRing->capacity - offset : writeSize;
+
+    memcpy(pRing->pData + offset, pData, firstPartSize);
+    memcpy(pRing->pData, (const char*)pData + firstPartSize, writeSize - firstPartSize);
+
+    // Publishes the copied bytes to the consumer
+    pRing->producerWritePos = writePos + writeSize;
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pRing->writePos, pRing->producerWritePos);
+
+    return writeSize;
+}
+
+
+const char* bohRingBufferPeek(bohRingBuffer* pRing, size_t* pSize)
+{
+    BOH_ASSERT(pRing);
+    BOH_ASSERT(pSize);
+
+    const uint64_t readPos = pRing->consumerReadPos;
+
+    if (pRing->cachedWritePos == readPos) {
+        pRing->cachedWritePos = BOH_ATOMIC_LOAD_ACQUIRE_U64(&pRing->writePos);
+    }
+
+    const size_t offset = (size_t)readPos & (pRing->capacity - 1);
+    const size_t readableSize = (size_t)(pRing->cachedWritePos - readPos);
+
+    *pSize = pRing->capacity - offset < readableSize ? pRing->capacity - offset : readableSize;
+    
+    return pRing->pData + offset;
+}
+
+
+void bohRingBufferConsume(bohRingBuffer* pRing, size_t size)
+{
+    BOH_ASSERT(pRing);
+    BOH_ASSERT(size <= (size_t)(pRing->cachedWritePos - pRing->consumerReadPos));
+
+    // Returns the space to the producer only after the bytes have been used
+    pRing->consumerReadPos += size;
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pRing->readPos, pRing->consumerReadPos);
+}
+
+
+bool bohRingBufferIsEmpty(const bohRingBuffer* pRing)
+{
+    BOH_ASSERT(pRing);
+    return BOH_ATOMIC_LOAD_SEQ_CST_U64(&pRing->writePos) == BOH_ATOMIC_LOAD_SEQ_CST_U64(&pRing->readPos);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "utils/sys/atomic.h"
+
+
+// Lock free byte ring buffer for exactly one producer thread and one consumer thread.
+// Positions grow monotonically and are wrapped with a mask, so capacity is always a power of two.
+// Each side keeps a cached copy of the other side position to touch the shared cache line only when required
+typedef struct RingBuffer
+{
+    char* pData;
+    size_t capacity;
+
+    // Producer side. Shared position is only written by the producer, which works with its private copy
+    uint64_t writePos;
+    uint64_t producerWritePos;
+    uint64_t cachedReadPos;
+    uint8_t producerPadding[BOH_CACHE_LINE_SIZE - 3 * sizeof(uint64_t)];
+
+    // Consumer side
+    uint64_t readPos;
+    uint64_t consumerReadPos;
+    uint64_t cachedWritePos;
+    uint8_t consumerPadding[BOH_CACHE_LINE_SIZE - 3 * sizeof(uint64_t)];
+} bohRingBuffer;
+
+
+// Capacity is rounded up to a power of two
+bohRingBuffer bohRingBufferCreate(size_t capacity);
+void bohRingBufferDestroy(bohRingBuffer* pRing);
+
+size_t bohRingBufferGetCapacity(const bohRingBuffer* pRing);
+
+// Producer only. Copies as many bytes as fit and returns their number, never blocks
+size_t bohRingBufferWrite(bohRingBuffer* pRing, const void* pData, size_t size);
+
+// Consumer only. Returns contiguous readable region, its size is 0 if the ring is empty
+const char* bohRingBufferPeek(bohRingBuffer* pRing, size_t* pSize);
+// Consumer only. Releases size bytes of the region returned by bohRingBufferPeek
+void bohRingBufferConsume(bohRingBuffer* pRing, size_t size);
+
+// May be called from any thread, the result is a snapshot
+bool bohRingBufferIsEmpty(const bohRingBuffer* pRing);
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "core.h"
+
+#include "utils/memory/memory.h"
+#include "utils/ds/typed_dyn_array.h"
+
+
+// Typed dynamic array for trivially copyable elements which keeps the first INLINE_CAPACITY elements inside the struct
+// and spills to the heap only past them. Inline elements share the storage with the heap pointer and the data is
+// never addressed through a pointer into the struct itself, so the vector may be copied or moved with a plain assignment.
+// BOH_DEFINE_SMALL_VEC(bohExpr*, 4, bohExprPtrSmallVec) defines bohExprPtrSmallVec type and the same set of functions
+// as BOH_DEFINE_DYN_ARRAY: bohExprPtrSmallVecCreate, bohExprPtrSmallVecPushBack, bohExprPtrSmallVecAt, etc.
+#define BOH_DEFINE_SMALL_VEC(ELEM_TYPE, INLINE_CAPACITY, NAME)                                                          \
+    typedef ELEM_TYPE NAME##Elem;                                                                                       \
+                                                                                                                        \
+    typedef struct NAME                                                                                                 \
+    {                                                                                                                   \
+        union {                                                                                                         \
+            NAME##Elem inlineData[INLINE_CAPACITY];                                                                     \
+            NAME##Elem* pHeapData;                                                                                      \
+        };                                                                                                              \
+                                                                                                                        \
+        size_t size;                                                                                                    \
+        size_t capacity;                                                                                                \
+    } NAME;                                                                                                             \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME NAME##Create(void)                                                                               \
+    {                                                                                                                   \
+        NAME vec;                                                                                                       \
+                                                                                                                        \
+        vec.pHeapData = NULL;                                                                                           \
+        vec.size = 0;                                                                                                   \
+        vec.capacity = (INLINE_CAPACITY);                                                                               \
+                                                                                                                        \
+        return vec;                                                                                                     \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline bool NAME##IsInline(const NAME* pVec)                                                                 \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        return pVec->capacity <= (INLINE_CAPACITY);                                                                     \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##Destroy(NAME* pVec)                                                                        \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+                                                                                                                        \
+        if (!NAME##IsInline(pVec)) {                                                                                    \
+            bohMemFree(pVec->pHeapData);                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        *pVec = NAME##Create();                                                                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME##Elem* NAME##GetData(NAME* pVec)                                                                 \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        return NAME##IsInline(pVec) ? pVec->inlineData : pVec->pHeapData;                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline const NAME##Elem* NAME##GetDataConst(const NAME* pVec)                                                \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        return NAME##IsInline(pVec) ? pVec->inlineData : pVec->pHeapData;                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##Reserve(NAME* pVec, size_t newCapacity)                                                    \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+                                                                                                                        \
+        if (newCapacity <= pVec->capacity) {                                                                            \
+            return;                                                                                                     \
+        }                                                                                                               \
+                                                                                                                        \
+        const size_t newCapacityInBytes = newCapacity * sizeof(NAME##Elem);                                             \
+                                                                                                                        \
+        if (NAME##IsInline(pVec)) {                                                                                     \
+            NAME##Elem* pNewData = (NAME##Elem*)bohMemAlloc(newCapacityInBytes);                                        \
+            BOH_ASSERT(pNewData);                                                                                       \
+                                                                                                                        \
+            if (pVec->size > 0) {                                                                                       \
+                memcpy(pNewData, pVec->inlineData, pVec->size * sizeof(NAME##Elem));                                    \
+            }                                                                                                           \
+                                                                                                                        \
+            pVec->pHeapData = pNewData;                                                                                 \
+        } else {                                                                                                        \
+            NAME##Elem* pNewData = (NAME##Elem*)bohMemRealloc(pVec->pHeapData, newCapacityInBytes);                     \
+            BOH_ASSERT(pNewData);                                                                                       \
+                                                                                                                        \
+            pVec->pHeapData = pNewData;                                                                                 \
+        }                                                                                                               \
+                                                                                                                        \
+        pVec->capacity = newCapacity;                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##Resize(NAME* pVec, size_t newSize)                                                         \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+                                                                                                                        \
+        NAME##Reserve(pVec, newSize);                                                                                   \
+        pVec->size = newSize;                                                                                           \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##Clear(NAME* pVec)                                                                          \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        pVec->size = 0;                                                                                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME##Elem* NAME##PushBackDummy(NAME* pVec)                                                           \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+                                                                                                                        \
+        if (pVec->size == pVec->capacity) {                                                                             \
+            NAME##Reserve(pVec, pVec->capacity * 2);                                                                    \
+        }                                                                                                               \
+                                                                                                                        \
+        return NAME##GetData(pVec) + pVec->size++;                                                                      \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME##Elem* NAME##PushBack(NAME* pVec, NAME##Elem element)                                            \
+    {                                                                                                                   \
+        NAME##Elem* pElement = NAME##PushBackDummy(pVec);                                                               \
+        *pElement = element;                                                                                            \
+                                                                                                                        \
+        return pElement;                                                                                                \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##PopBack(NAME* pVec)                                                                        \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        BOH_DYN_ARRAY_CHECK_INDEX(0, pVec->size);                                                                       \
+                                                                                                                        \
+        --pVec->size;                                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME##Elem* NAME##At(NAME* pVec, size_t index)                                                        \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        BOH_DYN_ARRAY_CHECK_INDEX(index, pVec->size);                                                                   \
+                                                                                                                        \
+        return NAME##GetData(pVec) + index;                                                                             \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline const NAME##Elem* NAME##AtConst(const NAME* pVec, size_t index)                                       \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        BOH_DYN_ARRAY_CHECK_INDEX(index, pVec->size);                                                                   \
+                                                                                                                        \
+        return NAME##GetDataConst(pVec) + index;                                                                        \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline size_t NAME##GetSize(const NAME* pVec)                                                                \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        return pVec->size;                                                                                              \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline size_t NAME##GetCapacity(const NAME* pVec)                                                            \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        return pVec->capacity;                                                                                          \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline bool NAME##IsEmpty(const NAME* pVec)                                                                  \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        return pVec->size == 0;                                                                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    /* Heap memory only, inline elements are a part of the owner size */                                                \
+    static inline size_t NAME##GetMemorySize(const NAME* pVec)                                                          \
+    {                                                                                                                   \
+        BOH_ASSERT(pVec);                                                                                               \
+        return NAME##IsInline(pVec) ? 0 : pVec->capacity * sizeof(NAME##Elem);                                          \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME* NAME##Assign(NAME* pDst, const NAME* pSrc)                                                      \
+    {                                                                                                                   \
+        BOH_ASSERT(pDst);                                                                                               \
+        BOH_ASSERT(pSrc);                                                                                               \
+                                                                                                                        \
+        if (pDst == pSrc) {                                                                                             \
+            return pDst;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        NAME##Resize(pDst, pSrc->size);                                                                                 \
+                                                                                                                        \
+        if (pSrc->size > 0) {                                                                                           \
+            memcpy(NAME##GetData(pDst), NAME##GetDataConst(pSrc), pSrc->size * sizeof(NAME##Elem));                     \
+        }                                                                                                               \
+                                                                                                                        \
+        return pDst;                                                                                                    \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME* NAME##Move(NAME* pDst, NAME* pSrc)                                                              \
+    {                                                                                                                   \
+        BOH_ASSERT(pDst);                                                                                               \
+        BOH_ASSERT(pSrc);                                                                                               \
+                                                                                                                        \
+        if (pDst == pSrc) {                                                                                             \
+            return pDst;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        NAME##Destroy(pDst);                                                                                            \
+                                                                                                                        \
+        *pDst = *pSrc;                                                                                                  \
+        *pSrc = NAME##Create();                                                                                         \
+                                                                                                                        \
+        return pDst;                                                                                                    \
+    }
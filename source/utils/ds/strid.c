@@ -6,160 +6,138 @@
 
 #include "hash.h"
 
-#include "dyn_array.h"
+#include "typed_dyn_array.h"
 
 
 static const uint64_t BOH_AVERAGE_STR_SIZE = 32;
 static const uint64_t BOH_PREALLOCATED_STR_IDS_COUNT = 4096;
-static const uint64_t BOH_PREALLOCATED_STORAGE_SIZE = BOH_PREALLOCATED_STR_IDS_COUNT * BOH_AVERAGE_STR_SIZE;
-static const uint64_t BOH_INVALID_STR_ID_HASH = UINT64_MAX;
+static const uint64_t BOH_DATA_BLOCK_SIZE = BOH_PREALLOCATED_STR_IDS_COUNT * BOH_AVERAGE_STR_SIZE;
+static const uint64_t BOH_INVALID_STR_ID = UINT64_MAX;
 
 
-typedef struct HashToStrIDDataLoactionIdx
+typedef struct StrIDEntry
 {
+    const char* pData; // Null terminated, never moves until the engine termination
+    size_t size;
     uint64_t hash;
-    uint64_t index;
-} bohHashToLocationIdxMapping;
-
-static void bohHashToLocationIdxMappingDestroy(bohHashToLocationIdxMapping* pMapping);
-static void bohHashToLocationIdxMappingCreateInPlace(bohHashToLocationIdxMapping* pMapping, uint64_t hash, uint64_t index);
-
-static bohHashToLocationIdxMapping* bohHashToLocationIdxMappingAssign(bohHashToLocationIdxMapping* pDst, const bohHashToLocationIdxMapping* pSrc);
+} bohStrIDEntry;
 
 
-typedef struct StrIDDataLocation
-{
-    size_t offset;
-    size_t length;
-} bohStrIDDataLocation;
-
-static void bohStrIDDataLocationDestroy(bohStrIDDataLocation* pLocation);
-static void bohStrIDDataLocationCreateInPlace(bohStrIDDataLocation* pLocation, size_t offset, size_t length);
-static bohStrIDDataLocation* bohStrIDDataLocationAssign(bohStrIDDataLocation* pDst, const bohStrIDDataLocation* pSrc);
+BOH_DEFINE_DYN_ARRAY(bohStrIDEntry, bohStrIDEntryArray)
+BOH_DEFINE_DYN_ARRAY(uint64_t, bohStrIDSlotArray)
+BOH_DEFINE_DYN_ARRAY(char*, bohStrIDBlockArray)
 
 
-static void bohHashToLocationIdxMappingDestroy(bohHashToLocationIdxMapping* pMapping)
+// StrID is an index of the entry, so equal strings always get the same ID and the lookup by ID is O(1).
+// Hash lookups go through the open addressing table with linear probing, collisions are resolved by comparing the data
+typedef struct StrIDDataStorage
 {
-    BOH_ASSERT(pMapping);
+    bohStrIDEntryArray entries;
+    bohStrIDSlotArray slots;       // Entry index or BOH_INVALID_STR_ID, the count is a power of two
+    bohStrIDBlockArray dataBlocks; // Full blocks are never reallocated, so the entries data pointers stay valid
 
-    pMapping->hash = BOH_INVALID_STR_ID_HASH;
-    pMapping->index = UINT64_MAX;
-}
+    char* pBlockTop;
+    size_t blockFreeSize;
+    size_t blocksMemorySize;
 
+    size_t size;
+} bohStrIDDataStorage;
 
-static void bohHashToLocationIdxMappingCreateInPlace(bohHashToLocationIdxMapping* pMapping, uint64_t hash, uint64_t index)
-{
-    BOH_ASSERT(pMapping);
 
-    pMapping->hash = hash;
-    pMapping->index = index;
-}
+static bohStrIDDataStorage s_storage;
 
 
-static bohHashToLocationIdxMapping* bohHashToLocationIdxMappingAssign(bohHashToLocationIdxMapping* pDst, const bohHashToLocationIdxMapping* pSrc)
+static uint64_t* bohStrIDDataStorageGetSlots(bohStrIDDataStorage* pStorage)
 {
-    BOH_ASSERT(pDst);
-    BOH_ASSERT(pSrc);
-
-    pDst->hash = pSrc->hash;
-    pDst->index = pSrc->index;
-
-    return pDst;
+    return bohStrIDSlotArrayGetData(&pStorage->slots);
 }
 
 
-static void HashToStrIDDataLoactionIdxDefConst(void* pElement)
+static const bohStrIDEntry* bohStrIDDataStorageGetEntry(const bohStrIDDataStorage* pStorage, uint64_t id)
 {
-    bohHashToLocationIdxMappingCreateInPlace((bohHashToLocationIdxMapping*)pElement, BOH_INVALID_STR_ID_HASH, 0xffffffffffffffff);
+    return bohStrIDEntryArrayAtConst(&pStorage->entries, id);
 }
 
 
-static void HashToStrIDDataLoactionIdxDestr(void* pElement)
+// Returns the found entry index or BOH_INVALID_STR_ID, in the latter case pSlotIdx is the free slot to insert the string into
+static uint64_t bohStrIDDataStorageFind(bohStrIDDataStorage* pStorage, const char* pData, size_t size, uint64_t hash, size_t* pSlotIdx)
 {
-    bohHashToLocationIdxMappingDestroy((bohHashToLocationIdxMapping*)pElement);
-}
+    const uint64_t* pSlots = bohStrIDDataStorageGetSlots(pStorage);
+    const size_t mask = bohStrIDSlotArrayGetSize(&pStorage->slots) - 1;
 
+    for (size_t slotIdx = hash & mask; ; slotIdx = (slotIdx + 1) & mask) {
+        const uint64_t id = pSlots[slotIdx];
 
-static void HashToStrIDDataLoactionIdxCopy(void* pDst, const void* pSrc)
-{
-    bohHashToLocationIdxMappingAssign((bohHashToLocationIdxMapping*)pDst, (const bohHashToLocationIdxMapping*)pSrc);
-}
-
+        if (id == BOH_INVALID_STR_ID) {
+            *pSlotIdx = slotIdx;
+            return BOH_INVALID_STR_ID;
+        }
 
-static void bohStrIDDataLocationDestroy(bohStrIDDataLocation* pLocation)
-{
-    BOH_ASSERT(pLocation);
+        const bohStrIDEntry* pEntry = bohStrIDDataStorageGetEntry(pStorage, id);
 
-    pLocation->offset = 0;
-    pLocation->length = 0;
+        if (pEntry->hash == hash && pEntry->size == size && (size == 0 || memcmp(pEntry->pData, pData, size) == 0)) {
+            return id;
+        }
+    }
 }
 
 
-static void bohStrIDDataLocationCreateInPlace(bohStrIDDataLocation* pLocation, size_t offset, size_t length)
+static void bohStrIDDataStorageResizeSlots(bohStrIDDataStorage* pStorage, size_t newSlotsCount)
 {
-    BOH_ASSERT(pLocation);
+    BOH_ASSERT((newSlotsCount & (newSlotsCount - 1)) == 0);
 
-    pLocation->offset = offset;
-    pLocation->length = length;
-}
+    bohStrIDSlotArrayResize(&pStorage->slots, newSlotsCount);
 
+    uint64_t* pSlots = bohStrIDDataStorageGetSlots(pStorage);
+    const size_t mask = newSlotsCount - 1;
 
-static bohStrIDDataLocation* bohStrIDDataLocationAssign(bohStrIDDataLocation* pDst, const bohStrIDDataLocation* pSrc)
-{
-    BOH_ASSERT(pDst);
-    BOH_ASSERT(pSrc);
+    for (size_t i = 0; i < newSlotsCount; ++i) {
+        pSlots[i] = BOH_INVALID_STR_ID;
+    }
 
-    pDst->offset = pSrc->offset;
-    pDst->length = pSrc->length;
+    const size_t entriesCount = bohStrIDEntryArrayGetSize(&pStorage->entries);
 
-    return pDst;
-}
+    for (uint64_t id = 0; id < entriesCount; ++id) {
+        size_t slotIdx = bohStrIDDataStorageGetEntry(pStorage, id)->hash & mask;
 
+        while (pSlots[slotIdx] != BOH_INVALID_STR_ID) {
+            slotIdx = (slotIdx + 1) & mask;
+        }
 
-static void StrIDDataLocationDefConst(void* pElement)
-{
-    bohStrIDDataLocationCreateInPlace((bohStrIDDataLocation*)pElement, 0, 0);
+        pSlots[slotIdx] = id;
+    }
 }
 
 
-static void StrIDDataLocationDestr(void* pElement)
+static const char* bohStrIDDataStorageCopyData(bohStrIDDataStorage* pStorage, const char* pData, size_t size)
 {
-    bohStrIDDataLocationDestroy((bohStrIDDataLocation*)pElement);
-}
+    const size_t requiredSize = size + 1; // including null terminator
 
+    if (requiredSize > pStorage->blockFreeSize) {
+        const size_t blockSize = requiredSize > BOH_DATA_BLOCK_SIZE ? requiredSize : BOH_DATA_BLOCK_SIZE;
 
-static void StrIDDataLocationCopy(void* pDst, const void* pSrc)
-{
-    bohStrIDDataLocationAssign((bohStrIDDataLocation*)pDst, (const bohStrIDDataLocation*)pSrc);
-}
+        char* pBlock = (char*)bohMemAlloc(blockSize);
+        BOH_ASSERT(pBlock);
 
+        bohStrIDBlockArrayPushBack(&pStorage->dataBlocks, pBlock);
 
-typedef struct StrIDDataStorage
-{
-    bohDynArray hashToDataLocationIdx;
-    bohDynArray strDataLocations;
-    bohDynArray dataStorage;
-        
-    uint64_t lastAllocatedID;
-    size_t size;
-} bohStrIDDataStorage;
-
-
-static bohStrIDDataStorage s_storage;
+        pStorage->pBlockTop = pBlock;
+        pStorage->blockFreeSize = blockSize;
+        pStorage->blocksMemorySize += blockSize;
+    }
 
+    char* pCopy = pStorage->pBlockTop;
 
-static uint64_t bohStrIDDataStorageFindLocationIdx(const bohStrIDDataStorage* pStorage, uint64_t hash)
-{   
-    const size_t mappingsCount = bohDynArrayGetSize(&pStorage->hashToDataLocationIdx);
-    for (size_t i = 0; i < mappingsCount; ++i) {
-        const bohHashToLocationIdxMapping* pMapping = BOH_DYN_ARRAY_AT_CONST(bohHashToLocationIdxMapping, &pStorage->hashToDataLocationIdx, i);
-        
-        if (pMapping->hash == hash) {
-            return pMapping->index;
-        }
+    if (size > 0) {
+        memcpy(pCopy, pData, size);
     }
+    pCopy[size] = '\0';
 
-    return UINT64_MAX;
+    pStorage->pBlockTop += requiredSize;
+    pStorage->blockFreeSize -= requiredSize;
+    pStorage->size += requiredSize;
+
+    return pCopy;
 }
 
 
@@ -167,11 +145,19 @@ static void bohStrIDDataStorageDestroy(bohStrIDDataStorage* pStorage)
 {
     BOH_ASSERT(pStorage);
 
-    bohDynArrayDestroy(&pStorage->hashToDataLocationIdx);
-    bohDynArrayDestroy(&pStorage->strDataLocations);
-    bohDynArrayDestroy(&pStorage->dataStorage);
+    const size_t blocksCount = bohStrIDBlockArrayGetSize(&pStorage->dataBlocks);
 
-    pStorage->lastAllocatedID = BOH_INVALID_STR_ID_HASH;
+    for (size_t i = 0; i < blocksCount; ++i) {
+        bohMemFree(*bohStrIDBlockArrayAt(&pStorage->dataBlocks, i));
+    }
+
+    bohStrIDEntryArrayDestroy(&pStorage->entries);
+    bohStrIDSlotArrayDestroy(&pStorage->slots);
+    bohStrIDBlockArrayDestroy(&pStorage->dataBlocks);
+
+    pStorage->pBlockTop = NULL;
+    pStorage->blockFreeSize = 0;
+    pStorage->blocksMemorySize = 0;
     pStorage->size = 0;
 }
 
@@ -180,67 +166,60 @@ static void bohStrIDDataStorageCreateInPlace(bohStrIDDataStorage* pStorage)
 {
     BOH_ASSERT(pStorage);
 
-    pStorage->hashToDataLocationIdx = BOH_DYN_ARRAY_CREATE(bohHashToLocationIdxMapping, HashToStrIDDataLoactionIdxDefConst, 
-        HashToStrIDDataLoactionIdxDestr, HashToStrIDDataLoactionIdxCopy);
-    bohDynArrayReserve(&pStorage->hashToDataLocationIdx, BOH_PREALLOCATED_STR_IDS_COUNT);
+    pStorage->entries = bohStrIDEntryArrayCreate();
+    bohStrIDEntryArrayReserve(&pStorage->entries, BOH_PREALLOCATED_STR_IDS_COUNT);
 
-    pStorage->strDataLocations = BOH_DYN_ARRAY_CREATE(bohStrIDDataLocation, StrIDDataLocationDefConst, 
-        StrIDDataLocationDestr, StrIDDataLocationCopy);
-    bohDynArrayReserve(&pStorage->strDataLocations, BOH_PREALLOCATED_STR_IDS_COUNT);
+    pStorage->slots = bohStrIDSlotArrayCreate();
+    bohStrIDDataStorageResizeSlots(pStorage, BOH_PREALLOCATED_STR_IDS_COUNT * 2);
 
-    pStorage->dataStorage = BOH_DYN_ARRAY_CREATE(char, NULL, NULL, NULL);
-    bohDynArrayResize(&pStorage->dataStorage, BOH_PREALLOCATED_STORAGE_SIZE);
+    pStorage->dataBlocks = bohStrIDBlockArrayCreate();
 
-    pStorage->lastAllocatedID = BOH_INVALID_STR_ID_HASH;
+    pStorage->pBlockTop = NULL;
+    pStorage->blockFreeSize = 0;
+    pStorage->blocksMemorySize = 0;
     pStorage->size = 0;
 }
 
 
-static bool bohStrIDDataStorageIsExist(const bohStrIDDataStorage* pStorage, uint64_t id)
+static uint64_t bohStrIDDataStorageStoreSized(bohStrIDDataStorage* pStorage, const char* pData, size_t size, uint64_t hash)
 {
     BOH_ASSERT(pStorage);
-    return bohStrIDDataStorageFindLocationIdx(pStorage, id) != UINT64_MAX;
-}
+    BOH_ASSERT(pData || size == 0);
 
+    size_t slotIdx = 0;
+    const uint64_t foundID = bohStrIDDataStorageFind(pStorage, pData, size, hash, &slotIdx);
 
-static uint64_t bohStrIDDataStorageStoreStrViewPtr(bohStrIDDataStorage* pStorage, const bohStringView* pStrView)
-{
-    BOH_ASSERT(pStrView);
-
-    const uint64_t id = bohHashStringView(pStrView);
+    if (foundID != BOH_INVALID_STR_ID) {
+        return foundID;
+    }
 
-    if (!bohStrIDDataStorageIsExist(pStorage, id)) {
-        bohStrIDDataLocation* pNewLocation = bohDynArrayPushBackDummy(&pStorage->strDataLocations);
+    const uint64_t id = bohStrIDEntryArrayGetSize(&pStorage->entries);
 
-        bohHashToLocationIdxMapping* pHToI = bohDynArrayPushBackDummy(&pStorage->hashToDataLocationIdx);
-        bohHashToLocationIdxMappingCreateInPlace(pHToI, id, bohDynArrayGetSize(&pStorage->strDataLocations) - 1);
-            
-        pNewLocation->length = bohStringViewGetSize(pStrView) + 1; // including null terminator
+    bohStrIDEntry* pEntry = bohStrIDEntryArrayPushBackDummy(&pStorage->entries);
 
-        if (pStorage->lastAllocatedID != BOH_INVALID_STR_ID_HASH) {
-            const size_t idx = bohStrIDDataStorageFindLocationIdx(pStorage, pStorage->lastAllocatedID);
-            BOH_ASSERT(idx != UINT64_MAX);
+    pEntry->pData = bohStrIDDataStorageCopyData(pStorage, pData, size);
+    pEntry->size = size;
+    pEntry->hash = hash;
 
-            const bohStrIDDataLocation* pLastLocation = bohDynArrayAtConst(&pStorage->strDataLocations, idx);
+    // Load factor is kept under 1/2, so probe sequences stay short
+    const size_t slotsCount = bohStrIDSlotArrayGetSize(&pStorage->slots);
 
-            pNewLocation->offset = pLastLocation->offset + pLastLocation->length;
-        }
+    if ((id + 1) * 2 > slotsCount) {
+        bohStrIDDataStorageResizeSlots(pStorage, slotsCount * 2);
+    } else {
+        bohStrIDDataStorageGetSlots(pStorage)[slotIdx] = id;
+    }
 
-        const uint64_t newSize = pNewLocation->offset + pNewLocation->length;
-            
-        if (newSize > bohDynArrayGetSize(&pStorage->dataStorage)) {
-            BOH_ASSERT_FAIL("StrID global data overflow");
-            bohDynArrayResize(&pStorage->dataStorage, newSize * 2ull);
-        }
+    return id;
+}
 
-        memcpy_s(BOH_DYN_ARRAY_GET_DATA(char, &pStorage->dataStorage) + pNewLocation->offset, pNewLocation->length - 1, 
-            bohStringViewGetData(pStrView), pNewLocation->length - 1);
 
-        pStorage->size = newSize;
-        pStorage->lastAllocatedID = id;
-    }
+static uint64_t bohStrIDDataStorageStoreStrViewPtr(bohStrIDDataStorage* pStorage, const bohStringView* pStrView)
+{
+    BOH_ASSERT(pStrView);
 
-    return id;
+    return bohStrIDDataStorageStoreSized(pStorage, bohStringViewGetData(pStrView), bohStringViewGetSize(pStrView), 
+        bohHashStringView(pStrView));
 }
 
 
@@ -260,11 +239,8 @@ static uint64_t bohStrIDDataStorageStoreString(bohStrIDDataStorage* pStorage, co
 
 const char* bohStrIDDataStorageLoad(const bohStrIDDataStorage* pStorage, uint64_t id)
 {
-    const uint64_t index = bohStrIDDataStorageFindLocationIdx(pStorage, id);
-
-    if (index != UINT64_MAX) {
-        const bohStrIDDataLocation* pLocation = BOH_DYN_ARRAY_AT_CONST(bohStrIDDataLocation, &pStorage->strDataLocations, index);
-        return BOH_DYN_ARRAY_GET_DATA_CONST(char, &pStorage->dataStorage) + pLocation->offset;
+    if (id < bohStrIDEntryArrayGetSize(&pStorage->entries)) {
+        return bohStrIDDataStorageGetEntry(pStorage, id)->pData;
     }
 
     return "";
@@ -274,7 +250,7 @@ const char* bohStrIDDataStorageLoad(const bohStrIDDataStorage* pStorage, uint64_
 uint64_t bohStrIDDataStorageGetCapacity(const bohStrIDDataStorage* pStorage)
 {
     BOH_ASSERT(pStorage);
-    return bohDynArrayGetCapacity(&pStorage->dataStorage);
+    return pStorage->blocksMemorySize;
 }
 
 
@@ -299,8 +275,8 @@ void bohStrIDEngineTerminate(void)
 
 size_t bohStrIDEngineGetOccupiedMemorySize(void)
 {
-    return bohDynArrayGetMemorySize(&s_storage.dataStorage) + bohDynArrayGetMemorySize(&s_storage.hashToDataLocationIdx)
-        + bohDynArrayGetMemorySize(&s_storage.strDataLocations);
+    return s_storage.blocksMemorySize + bohStrIDBlockArrayGetMemorySize(&s_storage.dataBlocks) 
+        + bohStrIDSlotArrayGetMemorySize(&s_storage.slots) + bohStrIDEntryArrayGetMemorySize(&s_storage.entries);
 }
 
 
@@ -311,7 +287,7 @@ bohStrID bohStrIDCreate(void)
 #if defined(BOH_DEBUG)
     strID.pStr = "";
 #endif
-    strID.ID = BOH_INVALID_STR_ID_HASH;
+    strID.ID = BOH_INVALID_STR_ID;
 
     return strID;
 }
@@ -426,7 +402,7 @@ const char* bohStrIDGetCStr(const bohStrID* pStrID)
 {
     BOH_ASSERT(pStrID);
 
-#if defined(ENG_DEBUG)
+#if defined(BOH_DEBUG)
     return pStrID->pStr;
 #else
     return bohStrIDDataStorageLoad(&s_storage, pStrID->ID);
@@ -504,12 +480,22 @@ uint64_t bohStrIDGetID(const bohStrID* pStrID)
 uint64_t bohStrIDGetHash(const bohStrID* pStrID)
 {
     BOH_ASSERT(pStrID);
-    return pStrID->ID;
+    BOH_ASSERT(bohStrIDIsValid(pStrID));
+
+    return bohStrIDDataStorageGetEntry(&s_storage, pStrID->ID)->hash;
+}
+
+
+size_t bohStrIDGetSize(const bohStrID* pStrID)
+{
+    BOH_ASSERT(pStrID);
+
+    return bohStrIDIsValid(pStrID) ? bohStrIDDataStorageGetEntry(&s_storage, pStrID->ID)->size : 0;
 }
 
 
 bool bohStrIDIsValid(const bohStrID* pStrID)
 {
     BOH_ASSERT(pStrID);
-    return pStrID->ID != BOH_INVALID_STR_ID_HASH;
+    return pStrID->ID != BOH_INVALID_STR_ID;
 }
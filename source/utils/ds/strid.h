@@ -14,6 +14,8 @@ typedef struct StringView bohStringView;
 typedef struct String bohString;
 
 
+// Interned string handle. ID is unique per string content, so comparing IDs is comparing strings.
+// Data is stored until the engine termination, pointers to it stay valid the whole time
 typedef struct StrID
 {
 #if defined(BOH_DEBUG)
@@ -45,5 +47,6 @@ bool bohStrIDGreaterEqual(const bohStrID* pLeft, const bohStrID* pRight);
 
 uint64_t bohStrIDGetID(const bohStrID* pStrID);
 uint64_t bohStrIDGetHash(const bohStrID* pStrID);
+size_t bohStrIDGetSize(const bohStrID* pStrID);
 
 bool bohStrIDIsValid(const bohStrID* pStrID);
\ No newline at end of file
@@ -6,13 +6,47 @@
 #include "string_view.h"
 
 
+#define BOH_STRING_HEAP_FLAG ((size_t)1 << (sizeof(size_t) * 8 - 1))
+
+
+static bool strIsHeap(const bohString* pStr)
+{
+    return (pStr->capacity & BOH_STRING_HEAP_FLAG) != 0;
+}
+
+
+static void strSetHeapBuffer(bohString* pStr, char* pData, size_t size, size_t capacity)
+{
+    BOH_ASSERT(capacity > size);
+    BOH_ASSERT((capacity & BOH_STRING_HEAP_FLAG) == 0);
+
+    pStr->pData = pData;
+    pStr->size = size;
+    pStr->capacity = capacity | BOH_STRING_HEAP_FLAG;
+}
+
+
+// The caller is responsible for the size < capacity invariant
+static void strSetSize(bohString* pStr, size_t size)
+{
+    if (strIsHeap(pStr)) {
+        pStr->size = size;
+        pStr->pData[size] = '\0';
+    } else {
+        BOH_ASSERT(size <= BOH_STRING_SSO_MAX_SIZE);
+
+        pStr->inlineSize = (uint8_t)size;
+        pStr->inlineData[size] = '\0';
+    }
+}
+
+
 bohString bohStringCreate(void)
 {
     bohString str;
 
-    str.pData = NULL;
-    str.size = 0;
-    str.capacity = 0;
+    str.inlineData[0] = '\0';
+    str.inlineSize = 0;
 
     return str;
 }
@@ -37,19 +71,23 @@ bohString bohStringCreateFromTo(const char* pBegin, const char* pEnd)
 
     const size_t length = endAddr - beginAddr;
 
-    bohString str;
-
-    str.pData = NULL;
-    str.size = length;
-    str.capacity = str.size > 0 ? str.size + 1 : 0;
+    bohString str = bohStringCreate();
 
-    if (str.capacity > 0) {
-        str.pData = (char*)malloc(str.capacity);
+    if (length > BOH_STRING_SSO_MAX_SIZE) {
+        const size_t capacity = length + 1;
         
-        memcpy_s(str.pData, str.capacity, pBegin, length);
-        str.pData[length] = '\0';
+        char* pData = (char*)bohMemAlloc(capacity);
+        BOH_ASSERT(pData);
+
+        strSetHeapBuffer(&str, pData, 0, capacity);
+    }
+
+    if (length > 0) {
+        memcpy_s(bohStringGetData(&str), length, pBegin, length);
     }
 
+    strSetSize(&str, length);
+
     return str;
 }
 
@@ -75,7 +113,7 @@ bohString bohStringCreateString(const bohString* pString)
 {
     BOH_ASSERT(pString);
 
-    bohString string;
+    bohString string = bohStringCreate();
     bohStringAssign(&string, pString);
 
     return string;
@@ -86,11 +124,11 @@ void bohStringDestroy(bohString* pStr)
 {
     BOH_ASSERT(pStr);
 
-    free(pStr->pData);
+    if (strIsHeap(pStr)) {
+        bohMemFree(pStr->pData);
+    }
 
-    pStr->pData = NULL;
-    pStr->size = 0;
-    pStr->capacity = 0;
+    *pStr = bohStringCreate();
 }
 
 
@@ -99,20 +137,12 @@ bohString* bohStringAssign(bohString* pDst, const bohString* pSrc)
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
-    bohStringDestroy(pDst);
-
-    if (pSrc->capacity == 0) {
-        *pDst = bohStringCreate();
+    if (pDst == pSrc) {
         return pDst;
     }
 
-    pDst->size = pSrc->size;
-    pDst->capacity = pSrc->capacity;
-
-    pDst->pData = (char*)malloc(pDst->capacity);
-    memcpy_s(pDst->pData, pDst->capacity, pSrc->pData, pSrc->capacity);
-
-    return pDst;
+    // Spare capacity of the source isn't copied, it only matters for the appends to the source itself
+    return bohStringAssignSizedCStr(pDst, bohStringGetCStr(pSrc), bohStringGetSize(pSrc));
 }
 
 
@@ -121,25 +151,17 @@ bohString* bohStringAssignSizedCStr(bohString* pDst, const char* pCStr, size_t l
     BOH_ASSERT(pDst);
     BOH_ASSERT(pCStr);
 
-    const size_t cStrCapacity = length + 1;
-
-    if (pDst->capacity >= cStrCapacity) {
-        memcpy_s(pDst->pData, pDst->capacity, pCStr, length);
-        pDst->pData[length] = '\0';
-        pDst->size = length;
-
-        return pDst;
-    }
+    if (bohStringGetCapacity(pDst) > length) {
+        // Source may be a part of the destination itself
+        memmove(bohStringGetData(pDst), pCStr, length);
+        strSetSize(pDst, length);
 
-    bohStringDestroy(pDst);
-
-    if (length == 0) {
-        *pDst = bohStringCreate();
         return pDst;
     }
 
-    *pDst = bohStringCreateCStr(pCStr);
-    return pDst;
+    bohString newStr = bohStringCreateFromTo(pCStr, pCStr + length);
+    
+    return bohStringMove(pDst, &newStr);
 }
 
 
@@ -161,28 +183,74 @@ bohString* bohStringAssignStringViewPtr(bohString* pDst, const bohStringView* pS
 }
 
 
+bohString* bohStringAppendSizedCStr(bohString* pDst, const char* pCStr, size_t length)
+{
+    BOH_ASSERT(pDst);
+    BOH_ASSERT(pCStr || length == 0);
+
+    if (length == 0) {
+        return pDst;
+    }
+
+    const size_t oldSize = bohStringGetSize(pDst);
+    const size_t oldCapacity = bohStringGetCapacity(pDst);
+    const size_t newSize = oldSize + length;
+
+    if (newSize < oldCapacity) {
+        memcpy_s(bohStringGetData(pDst) + oldSize, oldCapacity - oldSize, pCStr, length);
+    } else {
+        const size_t grownCapacity = oldCapacity * 2;
+        const size_t newCapacity = grownCapacity > newSize ? grownCapacity : newSize + 1;
+
+        char* pNewBuff = (char*)bohMemAlloc(newCapacity);
+        BOH_ASSERT(pNewBuff);
+
+        if (oldSize > 0) {
+            memcpy_s(pNewBuff, newCapacity, bohStringGetCStr(pDst), oldSize);
+        }
+
+        // Source may point into the old buffer ("s += s"), so the buffer is freed after the copy only
+        memcpy_s(pNewBuff + oldSize, newCapacity - oldSize, pCStr, length);
+        
+        if (strIsHeap(pDst)) {
+            bohMemFree(pDst->pData);
+        }
+
+        strSetHeapBuffer(pDst, pNewBuff, oldSize, newCapacity);
+    }
+
+    strSetSize(pDst, newSize);
+
+    return pDst;
+}
+
+
+bohString* bohStringAppendStringViewPtr(bohString* pDst, const bohStringView* pStrView)
+{
+    BOH_ASSERT(pStrView);
+    return bohStringAppendSizedCStr(pDst, bohStringViewGetData(pStrView), bohStringViewGetSize(pStrView));
+}
+
+
 bohString* bohStringReserve(bohString* pStr, size_t newCapacity)
 {
     BOH_ASSERT(pStr);
 
-    const size_t strSize = pStr->size;
-    const size_t strCapacity = pStr->capacity;
+    const size_t strSize = bohStringGetSize(pStr);
+    const size_t strCapacity = bohStringGetCapacity(pStr);
 
     if (newCapacity <= strCapacity) {
         return pStr;
     }
 
-    char* pNewBuff = (char*)malloc(newCapacity);
+    char* pNewBuff = (char*)bohMemAlloc(newCapacity);
     BOH_ASSERT(pNewBuff);
 
-    memcpy_s(pNewBuff, newCapacity, pStr->pData, strSize);
+    memcpy_s(pNewBuff, newCapacity, bohStringGetCStr(pStr), strSize);
     pNewBuff[strSize] = '\0';
 
     bohStringDestroy(pStr);
-
-    pStr->pData = pNewBuff;
-    pStr->size = strSize;
-    pStr->capacity = newCapacity;
+    strSetHeapBuffer(pStr, pNewBuff, strSize, newCapacity);
 
     pNewBuff = NULL;
 
@@ -194,19 +262,16 @@ bohString* bohStringResize(bohString* pStr, size_t newLength)
 {
     BOH_ASSERT(pStr);
 
-    if (newLength == pStr->size) {
+    if (newLength == bohStringGetSize(pStr)) {
         return pStr;
     }
 
-    const size_t oldCapacity = pStr->capacity;
-
-    if (newLength >= oldCapacity) {
+    if (newLength >= bohStringGetCapacity(pStr)) {
         const size_t newCapacity = newLength + 1;
         bohStringReserve(pStr, newCapacity);
     }
 
-    pStr->size = newLength;
-    pStr->pData[newLength] = '\0';
+    strSetSize(pStr, newLength);
 
     return pStr;
 }
@@ -217,15 +282,15 @@ bohString* bohStringMove(bohString* pDst, bohString* pSrc)
     BOH_ASSERT(pDst);
     BOH_ASSERT(pSrc);
 
-    bohStringDestroy(pDst);
+    if (pDst == pSrc) {
+        return pDst;
+    }
 
-    pDst->pData = pSrc->pData;
-    pDst->size = pSrc->size;
-    pDst->capacity = pSrc->capacity;
+    bohStringDestroy(pDst);
 
-    pSrc->pData = NULL;
-    pSrc->size = 0;
-    pSrc->capacity = 0;
+    // Inline data is moved along with the struct
+    *pDst = *pSrc;
+    *pSrc = bohStringCreate();
 
     return pDst;
 }
@@ -234,48 +299,60 @@ bohString* bohStringMove(bohString* pDst, bohString* pSrc)
 const char* bohStringGetCStr(const bohString* pStr)
 {
     BOH_ASSERT(pStr);
-    return pStr->pData ? pStr->pData : "";
+    return strIsHeap(pStr) ? pStr->pData : pStr->inlineData;
+}
+
+
+char* bohStringGetData(bohString* pStr)
+{
+    BOH_ASSERT(pStr);
+    return strIsHeap(pStr) ? pStr->pData : pStr->inlineData;
 }
 
 
 size_t bohStringGetSize(const bohString* pStr)
 {
     BOH_ASSERT(pStr);
-    return pStr->size;
+    return strIsHeap(pStr) ? pStr->size : pStr->inlineSize;
 }
 
 
 size_t bohStringGetCapacity(const bohString* pStr)
 {
     BOH_ASSERT(pStr);
-    return pStr->capacity;
+    return strIsHeap(pStr) ? pStr->capacity & ~BOH_STRING_HEAP_FLAG : BOH_STRING_SSO_BUFFER_SIZE;
+}
+
+
+bool bohStringIsInline(const bohString* pStr)
+{
+    BOH_ASSERT(pStr);
+    return !strIsHeap(pStr);
 }
 
 
 char bohStringAt(const bohString* pStr, size_t index)
 {
     BOH_ASSERT(pStr);
-    BOH_ASSERT(pStr->pData);
-    BOH_ASSERT(index < pStr->size);
+    BOH_ASSERT(index < bohStringGetSize(pStr));
 
-    return pStr->pData[index];
+    return bohStringGetCStr(pStr)[index];
 }
 
 
 void bohStringSetAt(bohString *pStr, char ch, size_t index)
 {
     BOH_ASSERT(pStr);
-    BOH_ASSERT(pStr->pData);
-    BOH_ASSERT(index < pStr->size);
+    BOH_ASSERT(index < bohStringGetSize(pStr));
 
-    pStr->pData[index] = ch;
+    bohStringGetData(pStr)[index] = ch;
 }
 
 
 bool bohStringIsEmpty(const bohString* pStr)
 {
     BOH_ASSERT(pStr);
-    return pStr->size == 0;
+    return bohStringGetSize(pStr) == 0;
 }
 
 
@@ -376,19 +453,14 @@ bohString bohStringViewAddStringView(const bohStringView* pLStrView, const bohSt
     const size_t leftStringSize = bohStringViewGetSize(pLStrView);
     const size_t rightStringSize = bohStringViewGetSize(pRStrView);
     const size_t newStringSize = leftStringSize + rightStringSize;
-    const size_t newStringCapacity = newStringSize + 1;
 
     bohString newString = bohStringCreate();
-    
-    newString.pData = (char*)malloc(newStringCapacity);
-    memset(newString.pData, 0, newStringCapacity);
+    bohStringResize(&newString, newStringSize);
 
-    memcpy_s(newString.pData, newStringCapacity, bohStringViewGetData(pLStrView), leftStringSize);
-    memcpy_s(newString.pData + leftStringSize, newStringCapacity - leftStringSize, bohStringViewGetData(pRStrView), rightStringSize);
-    newString.pData[newStringSize] = '\0';
+    char* pNewStringData = bohStringGetData(&newString);
 
-    newString.size = newStringSize;
-    newString.capacity = newStringCapacity;
+    memcpy_s(pNewStringData, newStringSize, bohStringViewGetData(pLStrView), leftStringSize);
+    memcpy_s(pNewStringData + leftStringSize, newStringSize - leftStringSize, bohStringViewGetData(pRStrView), rightStringSize);
 
     return newString;
 }
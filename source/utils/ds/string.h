@@ -7,11 +7,28 @@
 typedef struct StringView bohStringView;
 
 
+// Inline buffer takes the whole struct but the last byte, which keeps the inline size
+#define BOH_STRING_SSO_BUFFER_SIZE (sizeof(char*) + 2 * sizeof(size_t) - 1)
+#define BOH_STRING_SSO_MAX_SIZE    (BOH_STRING_SSO_BUFFER_SIZE - 1)
+
+
+// Strings up to BOH_STRING_SSO_MAX_SIZE chars are stored inline, without heap allocation.
+// The highest capacity bit marks heap strings, it overlaps the highest bit of the inline size on little endian targets.
+// Fields must be accessed through the functions below only
 typedef struct String
 {
-    char* pData;    
-    size_t size;
-    size_t capacity;
+    union {
+        struct {
+            char* pData;    
+            size_t size;
+            size_t capacity;
+        };
+
+        struct {
+            char inlineData[BOH_STRING_SSO_BUFFER_SIZE];
+            uint8_t inlineSize;
+        };
+    };
 } bohString;
 
 
@@ -30,15 +47,23 @@ bohString* bohStringAssignCStr(bohString* pDst, const char* pCStr);
 bohString* bohStringAssignStringView(bohString* pDst, bohStringView strView);
 bohString* bohStringAssignStringViewPtr(bohString* pDst, const bohStringView* pStrView);
 
+// Capacity grows geometrically, so a sequence of appends costs amortized O(1) per appended char
+bohString* bohStringAppendSizedCStr(bohString* pDst, const char* pCStr, size_t length);
+bohString* bohStringAppendStringViewPtr(bohString* pDst, const bohStringView* pStrView);
+
 bohString* bohStringReserve(bohString* pStr, size_t newCapacity);
 bohString* bohStringResize(bohString* pStr, size_t newSize);
 
 bohString* bohStringMove(bohString* pDst, bohString* pSrc);
 
 const char* bohStringGetCStr(const bohString* pStr);
+// Pointer is invalidated by any string move if the string is inline
+char* bohStringGetData(bohString* pStr);
 size_t bohStringGetSize(const bohString* pStr);
 size_t bohStringGetCapacity(const bohString* pStr);
 
+bool bohStringIsInline(const bohString* pStr);
+
 char bohStringAt(const bohString* pStr, size_t index);
 void bohStringSetAt(bohString* pStr, char ch, size_t index);
 
@@ -189,10 +189,10 @@ bohStringView* bohStringViewAssignString(bohStringView* pDst, bohString* pStr)
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pStr);
-    BOH_ASSERT(pStr->size < BOH_STRING_VIEW_MAX_SIZE);
+    BOH_ASSERT(bohStringGetSize(pStr) < BOH_STRING_VIEW_MAX_SIZE);
 
-    pDst->pConstData = pStr->pData;
-    pDst->size = pStr->size;
+    pDst->pData = bohStringGetData(pStr);
+    pDst->size = bohStringGetSize(pStr);
     pDst->isConstantPtr = false;
 
     return pDst;
@@ -203,10 +203,10 @@ bohStringView* bohStringViewAssignConstString(bohStringView* pDst, const bohStri
 {
     BOH_ASSERT(pDst);
     BOH_ASSERT(pStr);
-    BOH_ASSERT(pStr->size < BOH_STRING_VIEW_MAX_SIZE);
+    BOH_ASSERT(bohStringGetSize(pStr) < BOH_STRING_VIEW_MAX_SIZE);
 
-    pDst->pConstData = pStr->pData;
-    pDst->size = pStr->size;
+    pDst->pConstData = bohStringGetCStr(pStr);
+    pDst->size = bohStringGetSize(pStr);
     pDst->isConstantPtr = true;
 
     return pDst;
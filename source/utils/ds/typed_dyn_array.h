@@ -0,0 +1,229 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "core.h"
+
+#include "utils/memory/memory.h"
+
+
+// Bounds checks are on in debug builds, define BOH_DYN_ARRAY_BOUNDS_CHECK to keep them in release ones
+#if defined(BOH_DEBUG) && !defined(BOH_DYN_ARRAY_BOUNDS_CHECK)
+    #define BOH_DYN_ARRAY_BOUNDS_CHECK
+#endif
+
+#if defined(BOH_DYN_ARRAY_BOUNDS_CHECK)
+    #define BOH_DYN_ARRAY_CHECK_INDEX(INDEX, SIZE)                                                                      \
+        if ((INDEX) >= (SIZE)) {                                                                                        \
+            fprintf_s(stderr, "%sdyn array index %zu is out of range with size %zu%s\n",                                \
+                BOH_OUTPUT_COLOR_RED, (size_t)(INDEX), (size_t)(SIZE), BOH_OUTPUT_COLOR_RESET);                         \
+            BOH_DEBUG_BREAK();                                                                                          \
+        }
+#else
+    #define BOH_DYN_ARRAY_CHECK_INDEX(INDEX, SIZE)
+#endif
+
+
+#define BOH_DYN_ARRAY_MIN_CAPACITY 8
+
+
+// Typed dynamic array for trivially copyable elements, the counterpart of bohDynArray without element callbacks.
+// Storage grows with realloc and is never zeroed, elements added by Resize or PushBackDummy are uninitialized.
+// BOH_DEFINE_DYN_ARRAY(bohToken, bohTokenStorage) defines bohTokenStorage type and bohTokenStorageCreate,
+// bohTokenStorageDestroy, bohTokenStoragePushBack, bohTokenStorageAt, etc. Functions are static inline,
+// so the array may be defined in several translation units
+#define BOH_DEFINE_DYN_ARRAY(ELEM_TYPE, NAME)                                                                           \
+    typedef ELEM_TYPE NAME##Elem;                                                                                       \
+                                                                                                                        \
+    typedef struct NAME                                                                                                 \
+    {                                                                                                                   \
+        NAME##Elem* pData;                                                                                              \
+        size_t size;                                                                                                    \
+        size_t capacity;                                                                                                \
+    } NAME;                                                                                                             \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME NAME##Create(void)                                                                               \
+    {                                                                                                                   \
+        NAME array;                                                                                                     \
+                                                                                                                        \
+        array.pData = NULL;                                                                                             \
+        array.size = 0;                                                                                                 \
+        array.capacity = 0;                                                                                             \
+                                                                                                                        \
+        return array;                                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##Destroy(NAME* pArray)                                                                      \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+                                                                                                                        \
+        bohMemFree(pArray->pData);                                                                                      \
+                                                                                                                        \
+        pArray->pData = NULL;                                                                                           \
+        pArray->size = 0;                                                                                               \
+        pArray->capacity = 0;                                                                                           \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##Reserve(NAME* pArray, size_t newCapacity)                                                  \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+                                                                                                                        \
+        if (newCapacity <= pArray->capacity) {                                                                          \
+            return;                                                                                                     \
+        }                                                                                                               \
+                                                                                                                        \
+        NAME##Elem* pNewData = (NAME##Elem*)bohMemRealloc(pArray->pData, newCapacity * sizeof(NAME##Elem));             \
+        BOH_ASSERT(pNewData);                                                                                           \
+                                                                                                                        \
+        pArray->pData = pNewData;                                                                                       \
+        pArray->capacity = newCapacity;                                                                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##Resize(NAME* pArray, size_t newSize)                                                       \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+                                                                                                                        \
+        NAME##Reserve(pArray, newSize);                                                                                 \
+        pArray->size = newSize;                                                                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##Clear(NAME* pArray)                                                                        \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        pArray->size = 0;                                                                                               \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME##Elem* NAME##PushBackDummy(NAME* pArray)                                                         \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+                                                                                                                        \
+        if (pArray->size == pArray->capacity) {                                                                         \
+            NAME##Reserve(pArray, pArray->capacity > 0 ? pArray->capacity * 2 : BOH_DYN_ARRAY_MIN_CAPACITY);            \
+        }                                                                                                               \
+                                                                                                                        \
+        return pArray->pData + pArray->size++;                                                                          \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME##Elem* NAME##PushBack(NAME* pArray, NAME##Elem element)                                          \
+    {                                                                                                                   \
+        NAME##Elem* pElement = NAME##PushBackDummy(pArray);                                                             \
+        *pElement = element;                                                                                            \
+                                                                                                                        \
+        return pElement;                                                                                                \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline void NAME##PopBack(NAME* pArray)                                                                      \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        BOH_DYN_ARRAY_CHECK_INDEX(0, pArray->size);                                                                     \
+                                                                                                                        \
+        --pArray->size;                                                                                                 \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME##Elem* NAME##At(NAME* pArray, size_t index)                                                      \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        BOH_DYN_ARRAY_CHECK_INDEX(index, pArray->size);                                                                 \
+                                                                                                                        \
+        return pArray->pData + index;                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline const NAME##Elem* NAME##AtConst(const NAME* pArray, size_t index)                                     \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        BOH_DYN_ARRAY_CHECK_INDEX(index, pArray->size);                                                                 \
+                                                                                                                        \
+        return pArray->pData + index;                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME##Elem* NAME##GetData(NAME* pArray)                                                               \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        return pArray->pData;                                                                                           \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline const NAME##Elem* NAME##GetDataConst(const NAME* pArray)                                              \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        return pArray->pData;                                                                                           \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline size_t NAME##GetSize(const NAME* pArray)                                                              \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        return pArray->size;                                                                                            \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline size_t NAME##GetCapacity(const NAME* pArray)                                                          \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        return pArray->capacity;                                                                                        \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline bool NAME##IsEmpty(const NAME* pArray)                                                                \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        return pArray->size == 0;                                                                                       \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline size_t NAME##GetMemorySize(const NAME* pArray)                                                        \
+    {                                                                                                                   \
+        BOH_ASSERT(pArray);                                                                                             \
+        return pArray->capacity * sizeof(NAME##Elem);                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME* NAME##Assign(NAME* pDst, const NAME* pSrc)                                                      \
+    {                                                                                                                   \
+        BOH_ASSERT(pDst);                                                                                               \
+        BOH_ASSERT(pSrc);                                                                                               \
+                                                                                                                        \
+        if (pDst == pSrc) {                                                                                             \
+            return pDst;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        NAME##Resize(pDst, pSrc->size);                                                                                 \
+                                                                                                                        \
+        if (pSrc->size > 0) {                                                                                           \
+            memcpy(pDst->pData, pSrc->pData, pSrc->size * sizeof(NAME##Elem));                                          \
+        }                                                                                                               \
+                                                                                                                        \
+        return pDst;                                                                                                    \
+    }                                                                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    static inline NAME* NAME##Move(NAME* pDst, NAME* pSrc)                                                              \
+    {                                                                                                                   \
+        BOH_ASSERT(pDst);                                                                                               \
+        BOH_ASSERT(pSrc);                                                                                               \
+                                                                                                                        \
+        if (pDst == pSrc) {                                                                                             \
+            return pDst;                                                                                                \
+        }                                                                                                               \
+                                                                                                                        \
+        NAME##Destroy(pDst);                                                                                            \
+                                                                                                                        \
+        *pDst = *pSrc;                                                                                                  \
+        *pSrc = NAME##Create();                                                                                         \
+                                                                                                                        \
+        return pDst;                                                                                                    \
+    }
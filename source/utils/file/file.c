@@ -4,6 +4,18 @@
 
 #include "file.h"
 
+#if defined(_WIN32)
+    #include <io.h>
+    #include <limits.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
 
 static bohFileContent ReadFile(const char* pPath, const char* pMode)
 {
@@ -25,22 +37,34 @@ static bohFileContent ReadFile(const char* pPath, const char* pMode)
         return content;
     }
 
-    fseek(pFile, 0, SEEK_END);
-    const uint64_t fileSizeInBytes = ftell(pFile);
-    fseek(pFile, 0, SEEK_SET);
+    // Pipes and FIFOs don't have size, they must be read with bohFileStream
+    const int64_t fileSize = fseek(pFile, 0, SEEK_END) == 0 ? (int64_t)ftell(pFile) : -1;
+
+    if (fileSize < 0 || fseek(pFile, 0, SEEK_SET) != 0) {
+        fclose(pFile);
+        content.error = BOH_FILE_CONTENT_ERROR_NOT_SEEKABLE;
+        return content;
+    }
+
+    const size_t fileSizeInBytes = (size_t)fileSize;
 
     if (fileSizeInBytes == 0) {
+        fclose(pFile);
         content.pData = "";
         return content;
     }
 
-    content.pData = malloc(fileSizeInBytes);
-    memset(content.pData, 0, fileSizeInBytes);
+    content.pData = bohMemAlloc(fileSizeInBytes);
+    BOH_ASSERT(content.pData);
 
-    fread_s(content.pData, fileSizeInBytes, sizeof(uint8_t), fileSizeInBytes, pFile);
+    // In text mode the number of read bytes can be less than the file size due to line endings conversion
+    content.dataSize = fread_s(content.pData, fileSizeInBytes, sizeof(uint8_t), fileSizeInBytes, pFile);
     fclose(pFile);
 
-    content.dataSize = fileSizeInBytes;
+    if (content.dataSize == 0) {
+        bohMemFree(content.pData);
+        content.pData = "";
+    }
 
     return content;
 }
@@ -70,7 +94,7 @@ void bohFileContentFree(bohFileContent *pContent)
     BOH_ASSERT(pContent);
 
     if (pContent->dataSize != 0) {
-        free(pContent->pData);
+        bohMemFree(pContent->pData);
 
         pContent->pData = NULL;
         pContent->dataSize = 0;
@@ -78,3 +102,116 @@ void bohFileContentFree(bohFileContent *pContent)
 
     pContent->error = BOH_FILE_CONTENT_ERROR_NONE;
 }
+
+
+bool bohFileIsRegular(const char* pPath)
+{
+    if (!pPath) {
+        return false;
+    }
+
+#if defined(_WIN32)
+    struct _stat64 fileStat;
+    return _stat64(pPath, &fileStat) == 0 && (fileStat.st_mode & _S_IFMT) == _S_IFREG;
+#else
+    struct stat fileStat;
+    return stat(pPath, &fileStat) == 0 && S_ISREG(fileStat.st_mode);
+#endif
+}
+
+
+bohFileStream bohFileStreamOpen(const char* pPath)
+{
+    bohFileStream stream;
+    stream.descriptor = -1;
+    stream.isOwner = false;
+    stream.isEnd = false;
+    stream.error = BOH_FILE_CONTENT_ERROR_NONE;
+
+    if (!pPath || strcmp(pPath, BOH_FILE_STREAM_STDIN_PATH) == 0) {
+    #if defined(_WIN32)
+        stream.descriptor = _fileno(stdin);
+        _setmode(stream.descriptor, _O_BINARY);
+    #else
+        stream.descriptor = STDIN_FILENO;
+    #endif
+        return stream;
+    }
+
+#if defined(_WIN32)
+    stream.descriptor = _open(pPath, _O_RDONLY | _O_BINARY);
+#else
+    stream.descriptor = open(pPath, O_RDONLY);
+#endif
+
+    if (stream.descriptor < 0) {
+        stream.error = BOH_FILE_CONTENT_ERROR_OPEN_FAILED;
+        stream.isEnd = true;
+        return stream;
+    }
+
+    stream.isOwner = true;
+
+    return stream;
+}
+
+
+void bohFileStreamClose(bohFileStream* pStream)
+{
+    BOH_ASSERT(pStream);
+
+    if (pStream->isOwner && pStream->descriptor >= 0) {
+    #if defined(_WIN32)
+        _close(pStream->descriptor);
+    #else
+        close(pStream->descriptor);
+    #endif
+    }
+
+    pStream->descriptor = -1;
+    pStream->isOwner = false;
+    pStream->isEnd = true;
+}
+
+
+size_t bohFileStreamRead(bohFileStream* pStream, void* pBuffer, size_t bufferSize)
+{
+    BOH_ASSERT(pStream);
+    BOH_ASSERT(pBuffer);
+
+    if (pStream->isEnd || bufferSize == 0) {
+        return 0;
+    }
+
+#if defined(_WIN32)
+    const unsigned int readSize = bufferSize > INT_MAX ? INT_MAX : (unsigned int)bufferSize;
+    const int result = _read(pStream->descriptor, pBuffer, readSize);
+#else
+    ssize_t result = 0;
+    do {
+        result = read(pStream->descriptor, pBuffer, bufferSize);
+    } while (result < 0 && errno == EINTR);
+#endif
+
+    if (result <= 0) {
+        pStream->isEnd = true;
+        pStream->error = result < 0 ? BOH_FILE_CONTENT_ERROR_READ_FAILED : pStream->error;
+        return 0;
+    }
+
+    return (size_t)result;
+}
+
+
+bool bohFileStreamIsEnd(const bohFileStream* pStream)
+{
+    BOH_ASSERT(pStream);
+    return pStream->isEnd;
+}
+
+
+bohFileContentErrorCode bohFileStreamGetErrorCode(const bohFileStream* pStream)
+{
+    BOH_ASSERT(pStream);
+    return pStream->error;
+}
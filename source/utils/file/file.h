@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 
 typedef enum FileContentErrorCode
@@ -8,6 +9,8 @@ typedef enum FileContentErrorCode
     BOH_FILE_CONTENT_ERROR_NONE,
     BOH_FILE_CONTENT_ERROR_NULL_FILEPATH,
     BOH_FILE_CONTENT_ERROR_OPEN_FAILED,
+    BOH_FILE_CONTENT_ERROR_NOT_SEEKABLE,
+    BOH_FILE_CONTENT_ERROR_READ_FAILED,
 } bohFileContentErrorCode;
 
 
@@ -26,3 +29,31 @@ bohFileContent bohReadBinaryFile(const char* pPath);
 
 bohFileContentErrorCode bohFileContentGetErrorCode(const bohFileContent* pContent);
 void bohFileContentFree(bohFileContent* pContent);
+
+// Returns true if pPath is a regular file, which size is known before reading (not a pipe, FIFO or device)
+bool bohFileIsRegular(const char* pPath);
+
+
+#define BOH_FILE_STREAM_STDIN_PATH "-"
+
+
+// Unbuffered sequential reader, works with stdin, pipes and FIFOs since it never seeks
+typedef struct FileStream
+{
+    int descriptor;
+    bool isOwner;
+    bool isEnd;
+
+    bohFileContentErrorCode error;
+} bohFileStream;
+
+
+// NULL or BOH_FILE_STREAM_STDIN_PATH opens stdin
+bohFileStream bohFileStreamOpen(const char* pPath);
+void bohFileStreamClose(bohFileStream* pStream);
+
+// Returns as many bytes as currently available (at most bufferSize), blocks only if there is nothing to read yet
+size_t bohFileStreamRead(bohFileStream* pStream, void* pBuffer, size_t bufferSize);
+
+bool bohFileStreamIsEnd(const bohFileStream* pStream);
+bohFileContentErrorCode bohFileStreamGetErrorCode(const bohFileStream* pStream);
@@ -0,0 +1,437 @@
+#include "pch.h"
+
+#include "core.h"
+
+#include "fmt.h"
+#include "fmt_f64_tables.h"
+
+#if !defined(__SIZEOF_INT128__) && defined(_M_X64)
+    #include <intrin.h>
+#endif
+
+
+static const char BOH_FMT_DIGIT_PAIRS[200] = 
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+
+#define BOH_FMT_F64_MANTISSA_BITS 52
+#define BOH_FMT_F64_EXPONENT_BITS 11
+#define BOH_FMT_F64_EXPONENT_BIAS 1023
+
+// Decimal point position limits of fixed notation, the same as Python repr uses
+#define BOH_FMT_F64_FIXED_MIN_POINT_POS -3
+#define BOH_FMT_F64_FIXED_MAX_POINT_POS 16
+
+
+static uint32_t fmtGetDecimalLength(uint64_t value)
+{
+    uint32_t length = 1;
+
+    for (; value >= 10000; value /= 10000) {
+        length += 4;
+    }
+
+    return length + (value >= 10) + (value >= 100) + (value >= 1000);
+}
+
+
+// Writes exactly length digits of value ending right before pEnd, pairs of digits are written per step
+static void fmtWriteDigitsBackward(char* pEnd, uint64_t value, uint32_t length)
+{
+    char* pCurr = pEnd;
+    
+    while (value >= 100) {
+        const uint32_t pairIdx = (uint32_t)(value % 100) * 2;
+        value /= 100;
+
+        pCurr -= 2;
+        memcpy(pCurr, BOH_FMT_DIGIT_PAIRS + pairIdx, 2);
+    }
+
+    if (value >= 10) {
+        pCurr -= 2;
+        memcpy(pCurr, BOH_FMT_DIGIT_PAIRS + value * 2, 2);
+    } else {
+        *--pCurr = (char)('0' + value);
+    }
+
+    BOH_ASSERT(pCurr == pEnd - length);
+}
+
+
+size_t bohFmtU64(char* pBuffer, uint64_t value)
+{
+    BOH_ASSERT(pBuffer);
+
+    const uint32_t length = fmtGetDecimalLength(value);
+    fmtWriteDigitsBackward(pBuffer + length, value, length);
+
+    return length;
+}
+
+
+size_t bohFmtI64(char* pBuffer, int64_t value)
+{
+    BOH_ASSERT(pBuffer);
+
+    if (value >= 0) {
+        return bohFmtU64(pBuffer, (uint64_t)value);
+    }
+
+    // Negation is done in unsigned to handle INT64_MIN
+    pBuffer[0] = '-';
+    return 1 + bohFmtU64(pBuffer + 1, 0ull - (uint64_t)value);
+}
+
+
+static uint64_t fmtUMul128(uint64_t a, uint64_t b, uint64_t* pHigh)
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = (unsigned __int128)a * b;
+    *pHigh = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#elif defined(_M_X64)
+    return _umul128(a, b, pHigh);
+#else
+    const uint64_t aLow = (uint32_t)a;
+    const uint64_t aHigh = a >> 32;
+    const uint64_t bLow = (uint32_t)b;
+    const uint64_t bHigh = b >> 32;
+
+    const uint64_t lowLow = aLow * bLow;
+    const uint64_t lowHigh = aLow * bHigh;
+    const uint64_t highLow = aHigh * bLow;
+    const uint64_t highHigh = aHigh * bHigh;
+
+    const uint64_t middle = (lowLow >> 32) + (uint32_t)lowHigh + (uint32_t)highLow;
+
+    *pHigh = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return (middle << 32) | (uint32_t)lowLow;
+#endif
+}
+
+
+// Returns (m * mul) >> shift, where mul is 128 bit and 64 < shift < 128
+static uint64_t fmtMulShift64(uint64_t m, const uint64_t* pMul, uint32_t shift)
+{
+    BOH_ASSERT(shift > 64 && shift < 128);
+
+    uint64_t high0 = 0;
+    fmtUMul128(m, pMul[0], &high0);
+
+    uint64_t high1 = 0;
+    const uint64_t low1 = fmtUMul128(m, pMul[1], &high1);
+
+    const uint64_t sum = high0 + low1;
+    high1 += sum < high0;
+
+    const uint32_t dist = shift - 64;
+    return (high1 << (64 - dist)) | (sum >> dist);
+}
+
+
+// floor(log2(5^e)) + 1 for 0 <= e <= 3528
+static uint32_t fmtPow5Bits(int32_t e)
+{
+    return (uint32_t)(((e * 1217359) >> 19) + 1);
+}
+
+
+// floor(log10(2^e)) for 0 <= e <= 1650
+static uint32_t fmtLog10Pow2(int32_t e)
+{
+    return (uint32_t)((e * 78913) >> 18);
+}
+
+
+// floor(log10(5^e)) for 0 <= e <= 2620
+static uint32_t fmtLog10Pow5(int32_t e)
+{
+    return (uint32_t)((e * 732923) >> 20);
+}
+
+
+static bool fmtIsMultipleOfPow5(uint64_t value, uint32_t power)
+{
+    uint32_t count = 0;
+    
+    for (; value % 5 == 0 && count < power; value /= 5) {
+        ++count;
+    }
+
+    return count >= power;
+}
+
+
+static bool fmtIsMultipleOfPow2(uint64_t value, uint32_t power)
+{
+    return (value & ((1ull << power) - 1)) == 0;
+}
+
+
+typedef struct DecimalF64
+{
+    uint64_t mantissa;
+    int32_t exponent;
+} bohDecimalF64;
+
+
+// Ryu algorithm (Ulf Adams, 2018): finds the shortest decimal in the rounding interval of a finite non zero double
+static bohDecimalF64 fmtF64ToDecimal(uint64_t ieeeMantissa, uint32_t ieeeExponent)
+{
+    int32_t e2 = 0;
+    uint64_t m2 = 0;
+
+    if (ieeeExponent == 0) {
+        e2 = 1 - BOH_FMT_F64_EXPONENT_BIAS - BOH_FMT_F64_MANTISSA_BITS - 2;
+        m2 = ieeeMantissa;
+    } else {
+        e2 = (int32_t)ieeeExponent - BOH_FMT_F64_EXPONENT_BIAS - BOH_FMT_F64_MANTISSA_BITS - 2;
+        m2 = (1ull << BOH_FMT_F64_MANTISSA_BITS) | ieeeMantissa;
+    }
+
+    const bool acceptBounds = (m2 & 1) == 0;
+
+    // Interval of values which round to the double is [mv - mmShift - 1, mv + 2] scaled by 2^e2
+    const uint64_t mv = 4 * m2;
+    const uint32_t mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+
+    uint64_t vr = 0;
+    uint64_t vp = 0;
+    uint64_t vm = 0;
+    int32_t e10 = 0;
+
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+
+    if (e2 >= 0) {
+        const uint32_t q = fmtLog10Pow2(e2) - (e2 > 3);
+        e10 = (int32_t)q;
+
+        const int32_t k = BOH_FMT_POW5_INV_BITCOUNT + (int32_t)fmtPow5Bits((int32_t)q) - 1;
+        const uint32_t shift = (uint32_t)(-e2 + (int32_t)q + k);
+
+        vr = fmtMulShift64(4 * m2, BOH_FMT_POW5_INV_SPLIT[q], shift);
+        vp = fmtMulShift64(4 * m2 + 2, BOH_FMT_POW5_INV_SPLIT[q], shift);
+        vm = fmtMulShift64(4 * m2 - 1 - mmShift, BOH_FMT_POW5_INV_SPLIT[q], shift);
+
+        if (q <= 21) {
+            if (mv % 5 == 0) {
+                vrIsTrailingZeros = fmtIsMultipleOfPow5(mv, q);
+            } else if (acceptBounds) {
+                vmIsTrailingZeros = fmtIsMultipleOfPow5(mv - 1 - mmShift, q);
+            } else {
+                vp -= fmtIsMultipleOfPow5(mv + 2, q);
+            }
+        }
+    } else {
+        const uint32_t q = fmtLog10Pow5(-e2) - (-e2 > 1);
+        e10 = (int32_t)q + e2;
+
+        const int32_t i = -e2 - (int32_t)q;
+        const int32_t k = (int32_t)fmtPow5Bits(i) - BOH_FMT_POW5_BITCOUNT;
+        const uint32_t shift = (uint32_t)((int32_t)q - k);
+
+        vr = fmtMulShift64(4 * m2, BOH_FMT_POW5_SPLIT[i], shift);
+        vp = fmtMulShift64(4 * m2 + 2, BOH_FMT_POW5_SPLIT[i], shift);
+        vm = fmtMulShift64(4 * m2 - 1 - mmShift, BOH_FMT_POW5_SPLIT[i], shift);
+
+        if (q <= 1) {
+            vrIsTrailingZeros = true;
+
+            if (acceptBounds) {
+                vmIsTrailingZeros = mmShift == 1;
+            } else {
+                --vp;
+            }
+        } else if (q < 63) {
+            vrIsTrailingZeros = fmtIsMultipleOfPow2(mv, q);
+        }
+    }
+
+    int32_t removedDigitsCount = 0;
+    uint32_t lastRemovedDigit = 0;
+    uint64_t output = 0;
+
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+        // Rare exact cases, digits are removed one by one with tracking of trailing zeros
+        while (vp / 10 > vm / 10) {
+            vmIsTrailingZeros &= vm % 10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = (uint32_t)(vr % 10);
+
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removedDigitsCount;
+        }
+
+        if (vmIsTrailingZeros) {
+            while (vm % 10 == 0) {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = (uint32_t)(vr % 10);
+
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removedDigitsCount;
+            }
+        }
+
+        // Round half to even
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+            lastRemovedDigit = 4;
+        }
+
+        output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    } else {
+        // Common case, two digits are removed at once if possible
+        bool roundUp = false;
+
+        if (vp / 100 > vm / 100) {
+            roundUp = vr % 100 >= 50;
+
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removedDigitsCount += 2;
+        }
+
+        while (vp / 10 > vm / 10) {
+            roundUp = vr % 10 >= 5;
+
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removedDigitsCount;
+        }
+
+        output = vr + (vr == vm || roundUp);
+    }
+
+    bohDecimalF64 decimal;
+    decimal.mantissa = output;
+    decimal.exponent = e10 + removedDigitsCount;
+
+    return decimal;
+}
+
+
+// Writes nan, inf or zero
+static size_t fmtWriteSpecialF64(char* pBuffer, bool isNegative, bool isMaxExponent, uint64_t ieeeMantissa)
+{
+    size_t size = 0;
+
+    if (isMaxExponent && ieeeMantissa != 0) {
+        memcpy(pBuffer, "nan", 3);
+        return 3;
+    }
+
+    if (isNegative) {
+        pBuffer[size++] = '-';
+    }
+
+    if (isMaxExponent) {
+        memcpy(pBuffer + size, "inf", 3);
+        return size + 3;
+    }
+
+    memcpy(pBuffer + size, "0.0", 3);
+    return size + 3;
+}
+
+
+size_t bohFmtF64(char* pBuffer, double value)
+{
+    BOH_ASSERT(pBuffer);
+
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const bool isNegative = (bits >> (BOH_FMT_F64_MANTISSA_BITS + BOH_FMT_F64_EXPONENT_BITS)) != 0;
+    const uint64_t ieeeMantissa = bits & ((1ull << BOH_FMT_F64_MANTISSA_BITS) - 1);
+    const uint32_t ieeeExponent = (uint32_t)((bits >> BOH_FMT_F64_MANTISSA_BITS) & ((1u << BOH_FMT_F64_EXPONENT_BITS) - 1));
+
+    const uint32_t maxExponent = (1u << BOH_FMT_F64_EXPONENT_BITS) - 1;
+
+    if (ieeeExponent == maxExponent || (ieeeExponent == 0 && ieeeMantissa == 0)) {
+        return fmtWriteSpecialF64(pBuffer, isNegative, ieeeExponent == maxExponent, ieeeMantissa);
+    }
+
+    const bohDecimalF64 decimal = fmtF64ToDecimal(ieeeMantissa, ieeeExponent);
+
+    const int32_t digitsCount = (int32_t)fmtGetDecimalLength(decimal.mantissa);
+    const int32_t pointPos = digitsCount + decimal.exponent; // Value is 0.DIGITS * 10^pointPos
+
+    char* pCurr = pBuffer;
+
+    if (isNegative) {
+        *pCurr++ = '-';
+    }
+
+    if (pointPos >= BOH_FMT_F64_FIXED_MIN_POINT_POS && pointPos <= BOH_FMT_F64_FIXED_MAX_POINT_POS) {
+        if (pointPos <= 0) {
+            // 0.000DIGITS
+            const size_t zerosCount = (size_t)(2 - pointPos);
+            memset(pCurr, '0', zerosCount);
+            pCurr[1] = '.';
+            pCurr += zerosCount;
+
+            fmtWriteDigitsBackward(pCurr + digitsCount, decimal.mantissa, (uint32_t)digitsCount);
+            pCurr += digitsCount;
+        } else if (pointPos >= digitsCount) {
+            // DIGITS000.0
+            fmtWriteDigitsBackward(pCurr + digitsCount, decimal.mantissa, (uint32_t)digitsCount);
+            pCurr += digitsCount;
+
+            memset(pCurr, '0', (size_t)(pointPos - digitsCount));
+            pCurr += pointPos - digitsCount;
+
+            memcpy(pCurr, ".0", 2);
+            pCurr += 2;
+        } else {
+            // DIG.ITS, digits are written shifted by one and the integral part is moved back in front of the point
+            fmtWriteDigitsBackward(pCurr + digitsCount + 1, decimal.mantissa, (uint32_t)digitsCount);
+            memmove(pCurr, pCurr + 1, (size_t)pointPos);
+            pCurr[pointPos] = '.';
+            pCurr += digitsCount + 1;
+        }
+
+        return (size_t)(pCurr - pBuffer);
+    }
+
+    // D.IGITSe+XX, digits are written shifted by one and the first one is moved back in front of the point
+    fmtWriteDigitsBackward(pCurr + digitsCount + 1, decimal.mantissa, (uint32_t)digitsCount);
+    pCurr[0] = pCurr[1];
+
+    if (digitsCount > 1) {
+        pCurr[1] = '.';
+        pCurr += digitsCount + 1;
+    } else {
+        pCurr += 1;
+    }
+
+    const int32_t exponent = pointPos - 1;
+    const uint32_t exponentAbs = (uint32_t)(exponent < 0 ? -exponent : exponent);
+
+    *pCurr++ = 'e';
+    *pCurr++ = exponent < 0 ? '-' : '+';
+
+    if (exponentAbs >= 100) {
+        *pCurr++ = (char)('0' + exponentAbs / 100);
+    }
+    
+    memcpy(pCurr, BOH_FMT_DIGIT_PAIRS + (exponentAbs % 100) * 2, 2);
+    pCurr += 2;
+
+    return (size_t)(pCurr - pBuffer);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+// Max sizes of formatted values, the terminating zero is never written
+#define BOH_FMT_U64_MAX_SIZE 20 // "18446744073709551615"
+#define BOH_FMT_I64_MAX_SIZE 20 // "-9223372036854775808"
+#define BOH_FMT_F64_MAX_SIZE 24 // "-2.2250738585072014e-308"
+
+#define BOH_FMT_NUMBER_MAX_SIZE BOH_FMT_F64_MAX_SIZE
+
+
+// All functions write into caller buffer, which must be at least of max size, and return the number of written chars
+
+size_t bohFmtU64(char* pBuffer, uint64_t value);
+size_t bohFmtI64(char* pBuffer, int64_t value);
+
+// Shortest representation which parses back to the same value. Uses fixed notation for 1e-4 <= |value| < 1e16 
+// and scientific one otherwise, e.g. "0.1", "2.0", "1e+16", "1.5e-05", "nan", "-inf"
+size_t bohFmtF64(char* pBuffer, double value);
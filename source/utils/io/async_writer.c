@@ -0,0 +1,190 @@
+#include "pch.h"
+
+#include "core.h"
+
+#include "async_writer.h"
+#include "output.h"
+
+
+// Returns false if the ring is still empty and the writer has to stop
+static bool asyncWaitForData(bohAsyncWriter* pWriter)
+{
+    BOH_ASSERT(pWriter);
+
+    bohMutexLock(&pWriter->mutex);
+
+    // Flag is published before the ring is checked again, and the producer publishes data before it checks the flag, 
+    // so at least one of the sides sees the other one and the wakeup is never lost
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pWriter->isWriterWaiting, 1);
+
+    while (bohRingBufferIsEmpty(&pWriter->ring) && !BOH_ATOMIC_LOAD_SEQ_CST_U64(&pWriter->isStopRequested)) {
+        bohCondVarWait(&pWriter->dataAvailableCondVar, &pWriter->mutex);
+    }
+
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pWriter->isWriterWaiting, 0);
+
+    const bool hasData = !bohRingBufferIsEmpty(&pWriter->ring);
+
+    bohMutexUnlock(&pWriter->mutex);
+
+    return hasData;
+}
+
+
+static void asyncWaitForSpace(bohAsyncWriter* pWriter)
+{
+    BOH_ASSERT(pWriter);
+
+    bohMutexLock(&pWriter->mutex);
+
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pWriter->isProducerWaiting, 1);
+
+    const size_t capacity = bohRingBufferGetCapacity(&pWriter->ring);
+
+    while (BOH_ATOMIC_LOAD_SEQ_CST_U64(&pWriter->ring.writePos) - BOH_ATOMIC_LOAD_SEQ_CST_U64(&pWriter->ring.readPos) == capacity) {
+        bohCondVarWait(&pWriter->spaceAvailableCondVar, &pWriter->mutex);
+    }
+
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pWriter->isProducerWaiting, 0);
+
+    bohMutexUnlock(&pWriter->mutex);
+}
+
+
+static void asyncWakeUp(bohAsyncWriter* pWriter, uint64_t* pIsWaitingFlag, bohCondVar* pCondVar)
+{
+    BOH_ASSERT(pWriter);
+
+    if (!BOH_ATOMIC_LOAD_SEQ_CST_U64(pIsWaitingFlag)) {
+        return;
+    }
+
+    bohMutexLock(&pWriter->mutex);
+    bohCondVarSignal(pCondVar);
+    bohMutexUnlock(&pWriter->mutex);
+}
+
+
+static int asyncWriterThreadFunc(void* pArg)
+{
+    bohAsyncWriter* pWriter = (bohAsyncWriter*)pArg;
+    BOH_ASSERT(pWriter);
+
+    bool isFailed = false;
+
+    for (;;) {
+        size_t size = 0;
+        const char* pData = bohRingBufferPeek(&pWriter->ring, &size);
+
+        if (size == 0) {
+            // Stop is requested only after the last write, so the ring is fully drained here
+            if (!asyncWaitForData(pWriter)) {
+                break;
+            }
+            continue;
+        }
+
+        // Data is still consumed after failure, otherwise the producer would block forever
+        if (!isFailed && !bohOutputWriteToDescriptor(pWriter->descriptor, pData, size)) {
+            isFailed = true;
+            BOH_ATOMIC_STORE_SEQ_CST_U64(&pWriter->isFailed, 1);
+        }
+
+        bohRingBufferConsume(&pWriter->ring, size);
+        asyncWakeUp(pWriter, &pWriter->isProducerWaiting, &pWriter->spaceAvailableCondVar);
+    }
+
+    return isFailed ? -1 : 0;
+}
+
+
+bool bohAsyncWriterCreateInPlace(bohAsyncWriter* pWriter, int descriptor, size_t capacity)
+{
+    BOH_ASSERT(pWriter);
+    BOH_ASSERT(descriptor >= 0);
+
+    memset(pWriter, 0, sizeof(bohAsyncWriter));
+
+    pWriter->ring = bohRingBufferCreate(capacity);
+    pWriter->descriptor = descriptor;
+
+    bohMutexCreateInPlace(&pWriter->mutex);
+    bohCondVarCreateInPlace(&pWriter->dataAvailableCondVar);
+    bohCondVarCreateInPlace(&pWriter->spaceAvailableCondVar);
+
+    if (!bohThreadCreateInPlace(&pWriter->thread, asyncWriterThreadFunc, pWriter)) {
+        bohCondVarDestroy(&pWriter->spaceAvailableCondVar);
+        bohCondVarDestroy(&pWriter->dataAvailableCondVar);
+        bohMutexDestroy(&pWriter->mutex);
+        bohRingBufferDestroy(&pWriter->ring);
+        return false;
+    }
+
+    return true;
+}
+
+
+void bohAsyncWriterDestroy(bohAsyncWriter* pWriter)
+{
+    BOH_ASSERT(pWriter);
+
+    bohMutexLock(&pWriter->mutex);
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pWriter->isStopRequested, 1);
+    bohCondVarSignal(&pWriter->dataAvailableCondVar);
+    bohMutexUnlock(&pWriter->mutex);
+
+    bohThreadJoin(&pWriter->thread);
+
+    bohCondVarDestroy(&pWriter->spaceAvailableCondVar);
+    bohCondVarDestroy(&pWriter->dataAvailableCondVar);
+    bohMutexDestroy(&pWriter->mutex);
+    bohRingBufferDestroy(&pWriter->ring);
+}
+
+
+void bohAsyncWriterWrite(bohAsyncWriter* pWriter, const char* pData, size_t size)
+{
+    BOH_ASSERT(pWriter);
+    BOH_ASSERT(pData || size == 0);
+
+    while (size > 0) {
+        const size_t writtenSize = bohRingBufferWrite(&pWriter->ring, pData, size);
+
+        if (writtenSize == 0) {
+            asyncWaitForSpace(pWriter);
+            continue;
+        }
+
+        pData += writtenSize;
+        size -= writtenSize;
+
+        asyncWakeUp(pWriter, &pWriter->isWriterWaiting, &pWriter->dataAvailableCondVar);
+    }
+}
+
+
+// Writer consumes data only after it is written, so the empty ring means that all of it has reached the descriptor.
+// Writer wakes the waiting producer after every consume, the same way as for the full ring
+void bohAsyncWriterDrain(bohAsyncWriter* pWriter)
+{
+    BOH_ASSERT(pWriter);
+
+    bohMutexLock(&pWriter->mutex);
+
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pWriter->isProducerWaiting, 1);
+
+    while (!bohRingBufferIsEmpty(&pWriter->ring)) {
+        bohCondVarWait(&pWriter->spaceAvailableCondVar, &pWriter->mutex);
+    }
+
+    BOH_ATOMIC_STORE_SEQ_CST_U64(&pWriter->isProducerWaiting, 0);
+
+    bohMutexUnlock(&pWriter->mutex);
+}
+
+
+bool bohAsyncWriterIsFailed(const bohAsyncWriter* pWriter)
+{
+    BOH_ASSERT(pWriter);
+    return BOH_ATOMIC_LOAD_SEQ_CST_U64(&pWriter->isFailed) != 0;
+}
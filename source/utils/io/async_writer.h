@@ -0,0 +1,44 @@
+#pragma once
+
+#include "utils/ds/ring_buffer.h"
+#include "utils/sys/thread.h"
+
+
+#define BOH_ASYNC_WRITER_DEFAULT_CAPACITY (4 * 1024 * 1024)
+
+
+// Background thread draining a ring buffer to a file descriptor. Producer (the only one) blocks only when the ring is full,
+// the writer thread sleeps only when the ring is empty. Both sides spin on the ring and use the condition variables
+// as a slow path, so a mutex is never taken while data flows
+typedef struct AsyncWriter
+{
+    bohRingBuffer ring;
+    int descriptor;
+
+    bohThread thread;
+    bohMutex mutex;
+    bohCondVar dataAvailableCondVar;
+    bohCondVar spaceAvailableCondVar;
+
+    // Accessed by both threads atomically
+    uint64_t isWriterWaiting;
+    uint64_t isProducerWaiting;
+    uint64_t isStopRequested;
+    uint64_t isFailed;
+} bohAsyncWriter;
+
+
+// NOTE: *CreateInPlace functions don't call destroy function
+// Returns false if the writer thread could not be started. The writer must not be moved until destroyed
+bool bohAsyncWriterCreateInPlace(bohAsyncWriter* pWriter, int descriptor, size_t capacity);
+
+// Writes all the data which is already in the ring and stops the writer thread
+void bohAsyncWriterDestroy(bohAsyncWriter* pWriter);
+
+// Producer only. Blocks while there is no space in the ring
+void bohAsyncWriterWrite(bohAsyncWriter* pWriter, const char* pData, size_t size);
+// Producer only. Blocks until everything written so far has been passed to the descriptor
+void bohAsyncWriterDrain(bohAsyncWriter* pWriter);
+
+// Set if any write to the descriptor has failed, the rest data is dropped
+bool bohAsyncWriterIsFailed(const bohAsyncWriter* pWriter);
@@ -0,0 +1,260 @@
+#include "pch.h"
+
+#include "core.h"
+
+#include "output.h"
+#include "async_writer.h"
+
+#if defined(_WIN32)
+    #include <io.h>
+    #include <limits.h>
+#else
+    #include <errno.h>
+    #include <unistd.h>
+#endif
+
+
+bool bohOutputWriteToDescriptor(int descriptor, const char* pData, size_t size)
+{
+    while (size > 0) {
+    #if defined(_WIN32)
+        const unsigned int writeSize = size > INT_MAX ? INT_MAX : (unsigned int)size;
+        const int result = _write(descriptor, pData, writeSize);
+    #else
+        const ssize_t result = write(descriptor, pData, size);
+
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+    #endif
+
+        if (result <= 0) {
+            return false;
+        }
+
+        pData += result;
+        size -= (size_t)result;
+    }
+
+    return true;
+}
+
+
+static void outWriteData(bohOutput* pOutput, const char* pData, size_t size)
+{
+    BOH_ASSERT(pOutput);
+
+    if (pOutput->pAsyncWriter) {
+        bohAsyncWriterWrite(pOutput->pAsyncWriter, pData, size);
+        pOutput->isFailed = pOutput->isFailed || bohAsyncWriterIsFailed(pOutput->pAsyncWriter);
+    } else {
+        pOutput->isFailed = !bohOutputWriteToDescriptor(pOutput->descriptor, pData, size) || pOutput->isFailed;
+    }
+}
+
+
+static void outGrowBuffer(bohOutput* pOutput, size_t requiredCapacity)
+{
+    BOH_ASSERT(pOutput);
+
+    size_t newCapacity = pOutput->capacity > 0 ? pOutput->capacity : BOH_OUTPUT_DEFAULT_BUFFER_SIZE;
+    while (newCapacity < requiredCapacity) {
+        newCapacity *= 2;
+    }
+
+    char* pNewBuffer = (char*)bohMemRealloc(pOutput->pBuffer, newCapacity);
+    BOH_ASSERT(pNewBuffer);
+
+    pOutput->pBuffer = pNewBuffer;
+    pOutput->capacity = newCapacity;
+}
+
+
+bohOutputFlushMode bohOutputGetDefaultFlushMode(int descriptor)
+{
+#if defined(_WIN32)
+    return _isatty(descriptor) ? BOH_OUTPUT_FLUSH_MODE_LINE : BOH_OUTPUT_FLUSH_MODE_FULL;
+#else
+    return isatty(descriptor) ? BOH_OUTPUT_FLUSH_MODE_LINE : BOH_OUTPUT_FLUSH_MODE_FULL;
+#endif
+}
+
+
+bohOutput bohOutputCreate(int descriptor, size_t bufferSize, bohOutputFlushMode flushMode)
+{
+    BOH_ASSERT(descriptor >= 0);
+    BOH_ASSERT(bufferSize > 0);
+
+    bohOutput output = {0};
+    
+    output.pBuffer = (char*)bohMemAlloc(bufferSize);
+    BOH_ASSERT(output.pBuffer);
+    
+    output.size = 0;
+    output.capacity = bufferSize;
+    output.descriptor = descriptor;
+    output.pAsyncWriter = NULL;
+    output.flushMode = flushMode;
+    output.isFailed = false;
+
+    return output;
+}
+
+
+bohOutput bohOutputCreateAsync(bohAsyncWriter* pAsyncWriter, size_t bufferSize, bohOutputFlushMode flushMode)
+{
+    BOH_ASSERT(pAsyncWriter);
+
+    bohOutput output = bohOutputCreate(pAsyncWriter->descriptor, bufferSize, flushMode);
+    output.pAsyncWriter = pAsyncWriter;
+
+    return output;
+}
+
+
+void bohOutputDestroy(bohOutput* pOutput)
+{
+    BOH_ASSERT(pOutput);
+
+    bohOutputFlush(pOutput);
+
+    bohMemFree(pOutput->pBuffer);
+    pOutput->pBuffer = NULL;
+    pOutput->size = 0;
+    pOutput->capacity = 0;
+    pOutput->descriptor = -1;
+    pOutput->pAsyncWriter = NULL;
+}
+
+
+void bohOutputWrite(bohOutput* pOutput, const char* pData, size_t size)
+{
+    BOH_ASSERT(pOutput);
+    BOH_ASSERT(pData || size == 0);
+
+    if (size > pOutput->capacity - pOutput->size) {
+        if (pOutput->flushMode == BOH_OUTPUT_FLUSH_MODE_EXPLICIT) {
+            outGrowBuffer(pOutput, pOutput->size + size);
+        } else {
+            bohOutputFlush(pOutput);
+
+            // Data which doesn't fit the whole buffer is not copied at all
+            if (size >= pOutput->capacity) {
+                outWriteData(pOutput, pData, size);
+                return;
+            }
+        }
+    }
+
+    memcpy(pOutput->pBuffer + pOutput->size, pData, size);
+    pOutput->size += size;
+
+    if (pOutput->flushMode == BOH_OUTPUT_FLUSH_MODE_LINE && memchr(pData, '\n', size) != NULL) {
+        bohOutputFlush(pOutput);
+    }
+}
+
+
+void bohOutputWriteChar(bohOutput* pOutput, char ch)
+{
+    BOH_ASSERT(pOutput);
+
+    if (pOutput->size == pOutput->capacity) {
+        bohOutputWrite(pOutput, &ch, 1);
+        return;
+    }
+
+    pOutput->pBuffer[pOutput->size++] = ch;
+
+    if (pOutput->flushMode == BOH_OUTPUT_FLUSH_MODE_LINE && ch == '\n') {
+        bohOutputFlush(pOutput);
+    }
+}
+
+
+void bohOutputWriteCStr(bohOutput* pOutput, const char* pCStr)
+{
+    BOH_ASSERT(pCStr);
+    bohOutputWrite(pOutput, pCStr, strlen(pCStr));
+}
+
+
+char* bohOutputReserve(bohOutput* pOutput, size_t size)
+{
+    BOH_ASSERT(pOutput);
+    BOH_ASSERT(size <= pOutput->capacity || pOutput->flushMode == BOH_OUTPUT_FLUSH_MODE_EXPLICIT);
+
+    if (size > pOutput->capacity - pOutput->size) {
+        if (pOutput->flushMode == BOH_OUTPUT_FLUSH_MODE_EXPLICIT) {
+            outGrowBuffer(pOutput, pOutput->size + size);
+        } else {
+            bohOutputFlush(pOutput);
+        }
+    }
+
+    return pOutput->pBuffer + pOutput->size;
+}
+
+
+void bohOutputCommit(bohOutput* pOutput, size_t size)
+{
+    BOH_ASSERT(pOutput);
+    BOH_ASSERT(size <= pOutput->capacity - pOutput->size);
+
+    const char* pCommitted = pOutput->pBuffer + pOutput->size;
+    pOutput->size += size;
+
+    if (pOutput->flushMode == BOH_OUTPUT_FLUSH_MODE_LINE && memchr(pCommitted, '\n', size) != NULL) {
+        bohOutputFlush(pOutput);
+    }
+}
+
+
+bool bohOutputFlush(bohOutput* pOutput)
+{
+    BOH_ASSERT(pOutput);
+
+    if (pOutput->size > 0) {
+        // Buffer is dropped on failure anyway, otherwise it would overflow on the next write
+        outWriteData(pOutput, pOutput->pBuffer, pOutput->size);
+        pOutput->size = 0;
+    }
+
+    return !bohOutputIsFailed(pOutput);
+}
+
+
+bool bohOutputSync(bohOutput* pOutput)
+{
+    BOH_ASSERT(pOutput);
+
+    bohOutputFlush(pOutput);
+
+    if (pOutput->pAsyncWriter) {
+        bohAsyncWriterDrain(pOutput->pAsyncWriter);
+        pOutput->isFailed = pOutput->isFailed || bohAsyncWriterIsFailed(pOutput->pAsyncWriter);
+    }
+
+    return !bohOutputIsFailed(pOutput);
+}
+
+
+bohOutputFlushMode bohOutputGetFlushMode(const bohOutput* pOutput)
+{
+    BOH_ASSERT(pOutput);
+    return pOutput->flushMode;
+}
+
+
+size_t bohOutputGetBufferedSize(const bohOutput* pOutput)
+{
+    BOH_ASSERT(pOutput);
+    return pOutput->size;
+}
+
+
+bool bohOutputIsFailed(const bohOutput* pOutput)
+{
+    BOH_ASSERT(pOutput);
+    return pOutput->isFailed || (pOutput->pAsyncWriter && bohAsyncWriterIsFailed(pOutput->pAsyncWriter));
+}
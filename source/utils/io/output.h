@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+
+// stdout descriptor is 1 both for POSIX and MSVC runtime
+#define BOH_OUTPUT_STDOUT_DESCRIPTOR 1
+#define BOH_OUTPUT_DEFAULT_BUFFER_SIZE (64 * 1024)
+
+
+typedef enum OutputFlushMode
+{
+    BOH_OUTPUT_FLUSH_MODE_FULL,     // Flushes when the buffer is full
+    BOH_OUTPUT_FLUSH_MODE_LINE,     // Flushes when the buffer is full or a new line is written
+    BOH_OUTPUT_FLUSH_MODE_EXPLICIT, // Flushes only on bohOutputFlush call, buffer grows to keep all the written data
+} bohOutputFlushMode;
+
+
+typedef struct AsyncWriter bohAsyncWriter;
+
+
+// Writes all the data with as few calls as possible, returns false on failure
+bool bohOutputWriteToDescriptor(int descriptor, const char* pData, size_t size);
+
+// Returns line mode for terminals and full mode for everything else, as C runtime does for stdout
+bohOutputFlushMode bohOutputGetDefaultFlushMode(int descriptor);
+
+
+// Buffered writer on top of a file descriptor. Data is passed to the OS with one write call per flush, 
+// bypassing stdio, so it must not be interleaved with stdio output to the same descriptor without flushing both
+typedef struct Output
+{
+    char* pBuffer;
+    size_t size;
+    size_t capacity;
+
+    int descriptor;
+    bohAsyncWriter* pAsyncWriter; // If set, flushed data is passed to the writer thread instead of the descriptor
+    bohOutputFlushMode flushMode;
+
+    bool isFailed; // Set if any write to the descriptor has failed, the rest data is dropped
+} bohOutput;
+
+
+bohOutput bohOutputCreate(int descriptor, size_t bufferSize, bohOutputFlushMode flushMode);
+// Async writer is not owned and must outlive the output
+bohOutput bohOutputCreateAsync(bohAsyncWriter* pAsyncWriter, size_t bufferSize, bohOutputFlushMode flushMode);
+
+// Flushes the rest buffered data
+void bohOutputDestroy(bohOutput* pOutput);
+
+void bohOutputWrite(bohOutput* pOutput, const char* pData, size_t size);
+void bohOutputWriteChar(bohOutput* pOutput, char ch);
+void bohOutputWriteCStr(bohOutput* pOutput, const char* pCStr);
+
+// Returns place for at most size chars to be formatted right into the buffer, size must not exceed the buffer capacity. 
+// bohOutputCommit must be called after that with the number of actually written chars
+char* bohOutputReserve(bohOutput* pOutput, size_t size);
+void bohOutputCommit(bohOutput* pOutput, size_t size);
+
+// Returns false if writing to the descriptor failed
+bool bohOutputFlush(bohOutput* pOutput);
+// Flushes and waits until the data reaches the descriptor, even with the async writer, so writes to the other
+// descriptors (example: diagnostics to stderr) keep their order with it. Returns false if writing to the descriptor failed
+bool bohOutputSync(bohOutput* pOutput);
+
+bohOutputFlushMode bohOutputGetFlushMode(const bohOutput* pOutput);
+size_t bohOutputGetBufferedSize(const bohOutput* pOutput);
+bool bohOutputIsFailed(const bohOutput* pOutput);
@@ -15,15 +15,52 @@ static size_t bohAlignForward(size_t ptr, size_t alignment)
 }
 
 
-bohArenaAllocator bohArenaAllocatorCreate(size_t capacity)
+static bohArenaBlock* bohArenaBlockCreate(size_t capacity)
 {
-    bohArenaAllocator arena = {0};
+    // Header size keeps the block memory aligned as the heap memory is
+    bohArenaBlock* pBlock = (bohArenaBlock*)bohMemAlloc(sizeof(bohArenaBlock) + capacity);
+    BOH_ASSERT(pBlock);
+
+    pBlock->pNext = NULL;
+    pBlock->pMemory = (uint8_t*)(pBlock + 1);
+    pBlock->offset = 0;
+    pBlock->capacity = capacity;
+
+    memset(pBlock->pMemory, 0, capacity);
+
+    return pBlock;
+}
+
+
+// Returns NULL if the block doesn't have enough space
+static void* bohArenaBlockAlloc(bohArenaBlock* pBlock, size_t size, size_t alignment)
+{
+    if (!pBlock) {
+        return NULL;
+    }
+
+    const size_t current = bohAlignForward((size_t)(pBlock->pMemory + pBlock->offset), alignment);
+    const size_t newOffset = current + size - (size_t)pBlock->pMemory;
+
+    if (newOffset > pBlock->capacity) {
+        return NULL;
+    }
+
+    pBlock->offset = newOffset;
+
+    return pBlock->pMemory + (current - (size_t)pBlock->pMemory);
+}
+
+
+bohArenaAllocator bohArenaAllocatorCreate(size_t blockCapacity)
+{
+    BOH_ASSERT(blockCapacity > 0);
 
-    arena.pMemory = malloc(capacity);
-    memset(arena.pMemory, 0, capacity);
+    bohArenaAllocator arena = {0};
 
-    arena.offset = 0;
-    arena.capacity = capacity;
+    arena.pFirstBlock = NULL;
+    arena.pCurrBlock = NULL;
+    arena.blockCapacity = blockCapacity;
 
     return arena;
 }
@@ -33,10 +70,17 @@ void bohArenaAllocatorDestroy(bohArenaAllocator* pArena)
 {
     BOH_ASSERT(pArena);
 
-    free(pArena->pMemory);
-    pArena->pMemory = NULL;
-    pArena->offset = 0;
-    pArena->capacity = 0;
+    bohArenaBlock* pBlock = pArena->pFirstBlock;
+
+    while (pBlock) {
+        bohArenaBlock* pNextBlock = pBlock->pNext;
+        bohMemFree(pBlock);
+        pBlock = pNextBlock;
+    }
+
+    pArena->pFirstBlock = NULL;
+    pArena->pCurrBlock = NULL;
+    pArena->blockCapacity = 0;
 }
 
 
@@ -44,26 +88,53 @@ void* bohArenaAllocatorAlloc(bohArenaAllocator* pArena, size_t size, size_t alig
 {
     BOH_ASSERT(pArena);
 
-    const size_t current = bohAlignForward((size_t)(pArena->pMemory + pArena->offset), alignment);
-    const size_t newOffset = current + size - (size_t)pArena->pMemory;
+    void* pAllocation = bohArenaBlockAlloc(pArena->pCurrBlock, size, alignment);
 
-    BOH_ASSERT(newOffset <= pArena->capacity);
-    
-    pArena->offset = newOffset;
+    if (pAllocation) {
+        return pAllocation;
+    }
+
+    const size_t requiredCapacity = size + alignment - 1;
+    bohArenaBlock* pBlock = bohArenaBlockCreate(requiredCapacity > pArena->blockCapacity ? requiredCapacity : pArena->blockCapacity);
+
+    if (pArena->pCurrBlock) {
+        pArena->pCurrBlock->pNext = pBlock;
+    } else {
+        pArena->pFirstBlock = pBlock;
+    }
+
+    pArena->pCurrBlock = pBlock;
+
+    pAllocation = bohArenaBlockAlloc(pBlock, size, alignment);
+    BOH_ASSERT(pAllocation);
     
-    return pArena->pMemory + (current - (size_t)pArena->pMemory);
+    return pAllocation;
 }
 
 
 size_t bohArenaAllocatorGetOffset(const bohArenaAllocator* pArena)
 {
     BOH_ASSERT(pArena);
-    return pArena->offset;
+
+    size_t offset = 0;
+
+    for (const bohArenaBlock* pBlock = pArena->pFirstBlock; pBlock; pBlock = pBlock->pNext) {
+        offset += pBlock->offset;
+    }
+
+    return offset;
 }
 
 
 size_t bohArenaAllocatorGetCapacity(const bohArenaAllocator* pArena)
 {
     BOH_ASSERT(pArena);
-    return pArena->capacity;
+
+    size_t capacity = 0;
+
+    for (const bohArenaBlock* pBlock = pArena->pFirstBlock; pBlock; pBlock = pBlock->pNext) {
+        capacity += pBlock->capacity;
+    }
+
+    return capacity;
 }
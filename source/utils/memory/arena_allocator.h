@@ -1,15 +1,28 @@
 #pragma once
 
 
-typedef struct ArenaAllocator
+// Memory of the block follows its header
+typedef struct ArenaBlock
 {
+    struct ArenaBlock* pNext;
     uint8_t* pMemory;
     size_t offset;
     size_t capacity;
+} bohArenaBlock;
+
+
+// Full block is chained with a new one, so allocations never move and the arena never overflows.
+// Blocks are allocated on demand, allocation bigger than the block capacity gets a block of its own
+typedef struct ArenaAllocator
+{
+    bohArenaBlock* pFirstBlock;
+    bohArenaBlock* pCurrBlock;
+
+    size_t blockCapacity;
 } bohArenaAllocator;
 
 
-bohArenaAllocator bohArenaAllocatorCreate(size_t capacity);
+bohArenaAllocator bohArenaAllocatorCreate(size_t blockCapacity);
 void bohArenaAllocatorDestroy(bohArenaAllocator* pArena);
 
 void* bohArenaAllocatorAlloc(bohArenaAllocator* pArena, size_t size, size_t alignment);
@@ -0,0 +1,76 @@
+#include "pch.h"
+
+#include "counting_allocator.h"
+
+#include "core.h"
+
+
+static void* countingAlloc(void* pUserData, size_t size)
+{
+    bohCountingAllocator* pAllocator = (bohCountingAllocator*)pUserData;
+    const bohAllocator* pParent = pAllocator->pParentAllocator;
+
+    ++pAllocator->allocationsCount;
+    return pParent->pAllocFunc(pParent->pUserData, size);
+}
+
+
+static void* countingRealloc(void* pUserData, void* pMemory, size_t oldSize, size_t newSize)
+{
+    bohCountingAllocator* pAllocator = (bohCountingAllocator*)pUserData;
+    const bohAllocator* pParent = pAllocator->pParentAllocator;
+
+    ++pAllocator->allocationsCount;
+    return pParent->pReallocFunc(pParent->pUserData, pMemory, oldSize, newSize);
+}
+
+
+static void countingFree(void* pUserData, void* pMemory, size_t size)
+{
+    bohCountingAllocator* pAllocator = (bohCountingAllocator*)pUserData;
+    const bohAllocator* pParent = pAllocator->pParentAllocator;
+
+    ++pAllocator->freesCount;
+    pParent->pFreeFunc(pParent->pUserData, pMemory, size);
+}
+
+
+bohCountingAllocator bohCountingAllocatorCreate(void)
+{
+    bohCountingAllocator allocator;
+
+    allocator.pParentAllocator = bohMemGetAllocator();
+    allocator.allocationsCount = 0;
+    allocator.freesCount = 0;
+
+    return allocator;
+}
+
+
+bohAllocator bohCountingAllocatorGetInterface(bohCountingAllocator* pAllocator)
+{
+    BOH_ASSERT(pAllocator);
+
+    bohAllocator allocatorInterface;
+
+    allocatorInterface.pAllocFunc = countingAlloc;
+    allocatorInterface.pReallocFunc = countingRealloc;
+    allocatorInterface.pFreeFunc = countingFree;
+    allocatorInterface.pUserData = pAllocator;
+
+    return allocatorInterface;
+}
+
+
+uint64_t bohCountingAllocatorGetAllocationsCount(const bohCountingAllocator* pAllocator)
+{
+    BOH_ASSERT(pAllocator);
+    return pAllocator->allocationsCount;
+}
+
+
+uint64_t bohCountingAllocatorGetFreesCount(const bohCountingAllocator* pAllocator)
+{
+    BOH_ASSERT(pAllocator);
+    return pAllocator->freesCount;
+}
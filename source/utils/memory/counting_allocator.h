@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "utils/memory/memory.h"
+
+
+// Forwards every call to the parent allocator and counts them. Unlike bohMemoryStats, which counts bohMem* calls,
+// it sees only the allocations which actually reach the parent, the ones served by pools and scratch memory are not counted
+typedef struct CountingAllocator
+{
+    const bohAllocator* pParentAllocator; // Current one at the creation
+    
+    uint64_t allocationsCount; // Includes reallocations
+    uint64_t freesCount;
+} bohCountingAllocator;
+
+
+bohCountingAllocator bohCountingAllocatorCreate(void);
+
+// Interface is bound to pAllocator address, so the allocator mustn't move while the interface is in use
+bohAllocator bohCountingAllocatorGetInterface(bohCountingAllocator* pAllocator);
+
+uint64_t bohCountingAllocatorGetAllocationsCount(const bohCountingAllocator* pAllocator);
+uint64_t bohCountingAllocatorGetFreesCount(const bohCountingAllocator* pAllocator);
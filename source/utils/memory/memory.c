@@ -0,0 +1,168 @@
+#include "pch.h"
+
+#include "core.h"
+
+#include "memory.h"
+
+
+// Every block is prefixed with its size and allocator, so frees can be tracked and routed without a lookup.
+// Header size keeps the user pointer aligned as malloc does
+#define BOH_MEM_HEADER_SIZE 16
+
+
+typedef struct MemHeader
+{
+    size_t size;
+    const bohAllocator* pAllocator;
+} bohMemHeader;
+
+
+static void* memDefaultAlloc(void* pUserData, size_t size)
+{
+    (void)pUserData;
+    return malloc(size);
+}
+
+
+static void* memDefaultRealloc(void* pUserData, void* pMemory, size_t oldSize, size_t newSize)
+{
+    (void)pUserData;
+    (void)oldSize;
+
+    return realloc(pMemory, newSize);
+}
+
+
+static void memDefaultFree(void* pUserData, void* pMemory, size_t size)
+{
+    (void)pUserData;
+    (void)size;
+
+    free(pMemory);
+}
+
+
+static const bohAllocator s_defaultAllocator = { memDefaultAlloc, memDefaultRealloc, memDefaultFree, NULL };
+
+// Per thread, so interpreters on different threads can switch their allocators without racing
+static BOH_THREAD_LOCAL const bohAllocator* s_pCurrAllocator = &s_defaultAllocator;
+static BOH_THREAD_LOCAL bohMemoryStats s_memStats = {0};
+
+
+static void* memGetUserPtr(void* pBlock)
+{
+    return (uint8_t*)pBlock + BOH_MEM_HEADER_SIZE;
+}
+
+
+static void* memGetBlockPtr(void* pMemory)
+{
+    return (uint8_t*)pMemory - BOH_MEM_HEADER_SIZE;
+}
+
+
+static void memOnSizeIncreased(size_t size)
+{
+    s_memStats.currentSize += size;
+    s_memStats.peakSize = s_memStats.currentSize > s_memStats.peakSize ? s_memStats.currentSize : s_memStats.peakSize;
+}
+
+
+const bohAllocator* bohMemGetDefaultAllocator(void)
+{
+    return &s_defaultAllocator;
+}
+
+
+const bohAllocator* bohMemGetAllocator(void)
+{
+    return s_pCurrAllocator;
+}
+
+
+const bohAllocator* bohMemSetAllocator(const bohAllocator* pAllocator)
+{
+    BOH_ASSERT(!pAllocator || (pAllocator->pAllocFunc && pAllocator->pReallocFunc && pAllocator->pFreeFunc));
+
+    const bohAllocator* pPrevAllocator = s_pCurrAllocator;
+    s_pCurrAllocator = pAllocator ? pAllocator : &s_defaultAllocator;
+
+    return pPrevAllocator;
+}
+
+
+void* bohMemAlloc(size_t size)
+{
+    const bohAllocator* pAllocator = s_pCurrAllocator;
+
+    void* pBlock = pAllocator->pAllocFunc(pAllocator->pUserData, BOH_MEM_HEADER_SIZE + size);
+    if (!pBlock) {
+        return NULL;
+    }
+
+    bohMemHeader* pHeader = (bohMemHeader*)pBlock;
+    pHeader->size = size;
+    pHeader->pAllocator = pAllocator;
+
+    ++s_memStats.allocationsCount;
+    memOnSizeIncreased(size);
+
+    return memGetUserPtr(pBlock);
+}
+
+
+void* bohMemRealloc(void* pMemory, size_t newSize)
+{
+    if (!pMemory) {
+        return bohMemAlloc(newSize);
+    }
+
+    void* pOldBlock = memGetBlockPtr(pMemory);
+
+    const size_t oldSize = ((bohMemHeader*)pOldBlock)->size;
+    const bohAllocator* pAllocator = ((bohMemHeader*)pOldBlock)->pAllocator;
+
+    void* pNewBlock = pAllocator->pReallocFunc(pAllocator->pUserData, pOldBlock, 
+        BOH_MEM_HEADER_SIZE + oldSize, BOH_MEM_HEADER_SIZE + newSize);
+    if (!pNewBlock) {
+        return NULL;
+    }
+
+    ((bohMemHeader*)pNewBlock)->size = newSize;
+
+    ++s_memStats.allocationsCount;
+    s_memStats.currentSize -= oldSize;
+    memOnSizeIncreased(newSize);
+
+    return memGetUserPtr(pNewBlock);
+}
+
+
+void bohMemFree(void* pMemory)
+{
+    if (!pMemory) {
+        return;
+    }
+
+    void* pBlock = memGetBlockPtr(pMemory);
+
+    const size_t size = ((bohMemHeader*)pBlock)->size;
+    const bohAllocator* pAllocator = ((bohMemHeader*)pBlock)->pAllocator;
+
+    ++s_memStats.freesCount;
+    s_memStats.currentSize -= size;
+
+    pAllocator->pFreeFunc(pAllocator->pUserData, pBlock, BOH_MEM_HEADER_SIZE + size);
+}
+
+
+bohMemoryStats bohMemGetStats(void)
+{
+    return s_memStats;
+}
+
+
+void bohMemResetPeakSize(void)
+{
+    s_memStats.peakSize = s_memStats.currentSize;
+}
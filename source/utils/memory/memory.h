@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+typedef struct MemoryStats
+{
+    uint64_t allocationsCount; // Includes reallocations
+    uint64_t freesCount;
+    size_t currentSize;
+    size_t peakSize;
+} bohMemoryStats;
+
+
+// Sizes are passed back on realloc and free, so allocators don't need to track them
+typedef void* (*bohAllocFunc)(void* pUserData, size_t size);
+typedef void* (*bohReallocFunc)(void* pUserData, void* pMemory, size_t oldSize, size_t newSize);
+typedef void (*bohFreeFunc)(void* pUserData, void* pMemory, size_t size);
+
+
+// All bohMem* calls, and so every container and subsystem, allocate through the current allocator.
+// Each block remembers the allocator it came from and is returned to it, so the current allocator may be
+// switched at any time (example: a tracking or an arena-backed allocator around a single script run).
+// The current allocator is per thread, a new thread starts with the default one.
+// The allocator instance must outlive all of its blocks, and it must be thread safe if its blocks are freed on other threads
+typedef struct Allocator
+{
+    bohAllocFunc pAllocFunc;
+    bohReallocFunc pReallocFunc;
+    bohFreeFunc pFreeFunc; // May be a no-op for allocators which release everything at once
+
+    void* pUserData;
+} bohAllocator;
+
+
+// malloc based allocator, it is the current one until another is set
+const bohAllocator* bohMemGetDefaultAllocator(void);
+
+const bohAllocator* bohMemGetAllocator(void);
+// NULL restores the default allocator. Returns the previous one, so the switch may be scoped
+const bohAllocator* bohMemSetAllocator(const bohAllocator* pAllocator);
+
+
+void* bohMemAlloc(size_t size);
+void* bohMemRealloc(void* pMemory, size_t newSize);
+void bohMemFree(void* pMemory);
+
+// Stats cover all allocators and are per thread. A block freed on another thread is counted by that thread
+bohMemoryStats bohMemGetStats(void);
+
+// Drops peak size to the current size, so the next peak is measured from now on
+void bohMemResetPeakSize(void);
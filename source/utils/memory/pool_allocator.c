@@ -0,0 +1,184 @@
+#include "pch.h"
+
+#include "pool_allocator.h"
+
+#include "core.h"
+
+
+// Odd value can't be a free list link since the element headers are at least pointer aligned
+#define BOH_POOL_ALLOCATED_TAG ((uintptr_t)1)
+
+
+static size_t poolAlignForward(size_t value, size_t alignment)
+{
+    const size_t modulo = value % alignment;
+    return modulo == 0 ? value : value + (alignment - modulo);
+}
+
+
+static bohPoolSlab* poolSlabCreate(const bohAllocator* pAllocator, size_t capacity, size_t stride, size_t alignment)
+{
+    const bohAllocator* pPrevAllocator = bohMemSetAllocator(pAllocator);
+
+    // Extra space covers the alignment of the first element header if it is stricter than the heap one
+    bohPoolSlab* pSlab = (bohPoolSlab*)bohMemAlloc(sizeof(bohPoolSlab) + alignment - 1 + capacity * stride);
+    BOH_ASSERT(pSlab);
+
+    bohMemSetAllocator(pPrevAllocator);
+
+    pSlab->pNext = NULL;
+    pSlab->pMemory = (uint8_t*)poolAlignForward((size_t)(pSlab + 1), alignment);
+    pSlab->usedCount = 0;
+    pSlab->capacity = capacity;
+
+    return pSlab;
+}
+
+
+static uintptr_t* poolGetHeader(const bohPoolAllocator* pPool, void* pElement)
+{
+    return (uintptr_t*)((uint8_t*)pElement - pPool->headerSize);
+}
+
+
+static void* poolGetElement(const bohPoolAllocator* pPool, uintptr_t* pHeader)
+{
+    return (uint8_t*)pHeader + pPool->headerSize;
+}
+
+
+bohPoolAllocator bohPoolAllocatorCreate(size_t elementSize, size_t alignment, size_t slabCapacity)
+{
+    BOH_ASSERT(elementSize > 0);
+    BOH_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    BOH_ASSERT(slabCapacity > 0);
+
+    bohPoolAllocator pool = {0};
+
+    pool.pFirstSlab = NULL;
+    pool.pCurrSlab = NULL;
+    pool.pFreeList = NULL;
+
+    pool.elementSize = elementSize;
+    pool.headerSize = alignment > sizeof(uintptr_t) ? alignment : sizeof(uintptr_t);
+    pool.stride = pool.headerSize + poolAlignForward(elementSize, pool.headerSize);
+    pool.slabCapacity = slabCapacity;
+
+    pool.allocatedCount = 0;
+
+    pool.pSlabAllocator = bohMemGetAllocator();
+
+    return pool;
+}
+
+
+void bohPoolAllocatorDestroy(bohPoolAllocator* pPool)
+{
+    BOH_ASSERT(pPool);
+
+    bohPoolSlab* pSlab = pPool->pFirstSlab;
+
+    while (pSlab) {
+        bohPoolSlab* pNextSlab = pSlab->pNext;
+        bohMemFree(pSlab);
+        pSlab = pNextSlab;
+    }
+
+    pPool->pFirstSlab = NULL;
+    pPool->pCurrSlab = NULL;
+    pPool->pFreeList = NULL;
+    pPool->allocatedCount = 0;
+}
+
+
+void* bohPoolAllocatorAlloc(bohPoolAllocator* pPool)
+{
+    BOH_ASSERT(pPool);
+    BOH_ASSERT(pPool->elementSize > 0);
+
+    uintptr_t* pHeader = pPool->pFreeList;
+
+    if (pHeader) {
+        pPool->pFreeList = (uintptr_t*)*pHeader;
+    } else {
+        bohPoolSlab* pSlab = pPool->pCurrSlab;
+
+        if (!pSlab || pSlab->usedCount == pSlab->capacity) {
+            bohPoolSlab* pNewSlab = poolSlabCreate(pPool->pSlabAllocator, pPool->slabCapacity, pPool->stride, pPool->headerSize);
+
+            if (pSlab) {
+                pSlab->pNext = pNewSlab;
+            } else {
+                pPool->pFirstSlab = pNewSlab;
+            }
+
+            pPool->pCurrSlab = pNewSlab;
+            pSlab = pNewSlab;
+        }
+
+        pHeader = (uintptr_t*)(pSlab->pMemory + pSlab->usedCount * pPool->stride);
+        ++pSlab->usedCount;
+    }
+
+    *pHeader = BOH_POOL_ALLOCATED_TAG;
+    ++pPool->allocatedCount;
+
+    return poolGetElement(pPool, pHeader);
+}
+
+
+void bohPoolAllocatorFree(bohPoolAllocator* pPool, void* pElement)
+{
+    BOH_ASSERT(pPool);
+
+    if (!pElement) {
+        return;
+    }
+
+    uintptr_t* pHeader = poolGetHeader(pPool, pElement);
+    BOH_ASSERT_MSG(*pHeader == BOH_POOL_ALLOCATED_TAG, "Pool element is freed twice or doesn't belong to the pool");
+
+    *pHeader = (uintptr_t)pPool->pFreeList;
+    pPool->pFreeList = pHeader;
+
+    BOH_ASSERT(pPool->allocatedCount > 0);
+    --pPool->allocatedCount;
+}
+
+
+void bohPoolAllocatorForEach(const bohPoolAllocator* pPool, bohPoolElementFunc pFunc)
+{
+    BOH_ASSERT(pPool);
+    BOH_ASSERT(pFunc);
+
+    for (const bohPoolSlab* pSlab = pPool->pFirstSlab; pSlab; pSlab = pSlab->pNext) {
+        for (size_t i = 0; i < pSlab->usedCount; ++i) {
+            uintptr_t* pHeader = (uintptr_t*)(pSlab->pMemory + i * pPool->stride);
+
+            if (*pHeader == BOH_POOL_ALLOCATED_TAG) {
+                pFunc(poolGetElement(pPool, pHeader));
+            }
+        }
+    }
+}
+
+
+size_t bohPoolAllocatorGetAllocatedCount(const bohPoolAllocator* pPool)
+{
+    BOH_ASSERT(pPool);
+    return pPool->allocatedCount;
+}
+
+
+size_t bohPoolAllocatorGetCapacity(const bohPoolAllocator* pPool)
+{
+    BOH_ASSERT(pPool);
+
+    size_t capacity = 0;
+
+    for (const bohPoolSlab* pSlab = pPool->pFirstSlab; pSlab; pSlab = pSlab->pNext) {
+        capacity += pSlab->capacity * pPool->stride;
+    }
+
+    return capacity;
+}
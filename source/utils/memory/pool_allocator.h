@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "utils/memory/memory.h"
+
+
+// Elements of the slab follow its header
+typedef struct PoolSlab
+{
+    struct PoolSlab* pNext;
+    uint8_t* pMemory;
+    size_t usedCount; // Elements handed out at least once, the rest of the slab was never touched
+    size_t capacity;
+} bohPoolSlab;
+
+
+typedef void (*bohPoolElementFunc)(void* pElement);
+
+
+// Fixed-size objects allocator. Freed elements are pushed to the intrusive free list and reused first,
+// new slabs are allocated only when the list is empty, so both allocation and free are O(1).
+// Every element is prefixed with a word which is the free list link while the element is free and
+// an odd tag while it is allocated, so the allocated elements can be walked. Slabs are released on destroy only.
+// The pool is not thread safe, every owner is expected to be used from one thread
+typedef struct PoolAllocator
+{
+    bohPoolSlab* pFirstSlab;
+    bohPoolSlab* pCurrSlab;
+
+    uintptr_t* pFreeList; // Header of the first free element
+
+    size_t elementSize;
+    size_t headerSize;    // Keeps the element aligned
+    size_t stride;
+    size_t slabCapacity;  // Elements count
+
+    size_t allocatedCount;
+
+    // Current one at the pool creation. Slabs outlive any allocator scoped around a single allocation
+    const bohAllocator* pSlabAllocator;
+} bohPoolAllocator;
+
+
+bohPoolAllocator bohPoolAllocatorCreate(size_t elementSize, size_t alignment, size_t slabCapacity);
+void bohPoolAllocatorDestroy(bohPoolAllocator* pPool);
+
+// Returned memory is uninitialized
+void* bohPoolAllocatorAlloc(bohPoolAllocator* pPool);
+void bohPoolAllocatorFree(bohPoolAllocator* pPool, void* pElement);
+
+// Calls pFunc for every allocated element, the order is unspecified
+void bohPoolAllocatorForEach(const bohPoolAllocator* pPool, bohPoolElementFunc pFunc);
+
+size_t bohPoolAllocatorGetAllocatedCount(const bohPoolAllocator* pPool);
+size_t bohPoolAllocatorGetCapacity(const bohPoolAllocator* pPool);
+
+
+#define BOH_POOL_ALLOCATOR_CREATE(TYPE, SLAB_CAPACITY) bohPoolAllocatorCreate(sizeof(TYPE), _Alignof(TYPE), SLAB_CAPACITY)
+#define BOH_POOL_ALLOCATOR_ALLOC(POOL_PTR, TYPE) (TYPE*)bohPoolAllocatorAlloc(POOL_PTR)
@@ -0,0 +1,169 @@
+#include "pch.h"
+
+#include "size_class_allocator.h"
+
+#include "core.h"
+
+
+// BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT if the size doesn't fit any class
+static size_t sizeClassGetIndex(size_t size)
+{
+    size_t classSize = BOH_SIZE_CLASS_ALLOCATOR_MIN_SIZE;
+    size_t index = 0;
+
+    while (index < BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT && size > classSize) {
+        classSize <<= 1;
+        ++index;
+    }
+
+    return index;
+}
+
+
+static void* sizeClassInterfaceAlloc(void* pUserData, size_t size)
+{
+    return bohSizeClassAllocatorAlloc((bohSizeClassAllocator*)pUserData, size);
+}
+
+
+static void* sizeClassInterfaceRealloc(void* pUserData, void* pMemory, size_t oldSize, size_t newSize)
+{
+    return bohSizeClassAllocatorRealloc((bohSizeClassAllocator*)pUserData, pMemory, oldSize, newSize);
+}
+
+
+static void sizeClassInterfaceFree(void* pUserData, void* pMemory, size_t size)
+{
+    bohSizeClassAllocatorFree((bohSizeClassAllocator*)pUserData, pMemory, size);
+}
+
+
+bohSizeClassAllocator bohSizeClassAllocatorCreate(size_t slabCapacity)
+{
+    bohSizeClassAllocator allocator = {0};
+
+    for (size_t i = 0; i < BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT; ++i) {
+        allocator.pools[i] = bohPoolAllocatorCreate((size_t)BOH_SIZE_CLASS_ALLOCATOR_MIN_SIZE << i, 
+            BOH_SIZE_CLASS_ALLOCATOR_ALIGNMENT, slabCapacity);
+    }
+
+    allocator.pFallbackAllocator = bohMemGetAllocator();
+
+    return allocator;
+}
+
+
+void bohSizeClassAllocatorDestroy(bohSizeClassAllocator* pAllocator)
+{
+    BOH_ASSERT(pAllocator);
+
+    for (size_t i = 0; i < BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT; ++i) {
+        bohPoolAllocatorDestroy(&pAllocator->pools[i]);
+    }
+}
+
+
+void* bohSizeClassAllocatorAlloc(bohSizeClassAllocator* pAllocator, size_t size)
+{
+    BOH_ASSERT(pAllocator);
+
+    const size_t classIdx = sizeClassGetIndex(size);
+
+    if (classIdx < BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT) {
+        return bohPoolAllocatorAlloc(&pAllocator->pools[classIdx]);
+    }
+
+    const bohAllocator* pFallback = pAllocator->pFallbackAllocator;
+    return pFallback->pAllocFunc(pFallback->pUserData, size);
+}
+
+
+void* bohSizeClassAllocatorRealloc(bohSizeClassAllocator* pAllocator, void* pMemory, size_t oldSize, size_t newSize)
+{
+    BOH_ASSERT(pAllocator);
+
+    const size_t oldClassIdx = sizeClassGetIndex(oldSize);
+    const size_t newClassIdx = sizeClassGetIndex(newSize);
+
+    if (oldClassIdx == newClassIdx) {
+        if (oldClassIdx < BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT) {
+            return pMemory;
+        }
+
+        const bohAllocator* pFallback = pAllocator->pFallbackAllocator;
+        return pFallback->pReallocFunc(pFallback->pUserData, pMemory, oldSize, newSize);
+    }
+
+    void* pNewMemory = bohSizeClassAllocatorAlloc(pAllocator, newSize);
+    if (!pNewMemory) {
+        return NULL;
+    }
+
+    memcpy(pNewMemory, pMemory, oldSize < newSize ? oldSize : newSize);
+    bohSizeClassAllocatorFree(pAllocator, pMemory, oldSize);
+
+    return pNewMemory;
+}
+
+
+void bohSizeClassAllocatorFree(bohSizeClassAllocator* pAllocator, void* pMemory, size_t size)
+{
+    BOH_ASSERT(pAllocator);
+
+    if (!pMemory) {
+        return;
+    }
+
+    const size_t classIdx = sizeClassGetIndex(size);
+
+    if (classIdx < BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT) {
+        bohPoolAllocatorFree(&pAllocator->pools[classIdx], pMemory);
+        return;
+    }
+
+    const bohAllocator* pFallback = pAllocator->pFallbackAllocator;
+    pFallback->pFreeFunc(pFallback->pUserData, pMemory, size);
+}
+
+
+bohAllocator bohSizeClassAllocatorGetInterface(bohSizeClassAllocator* pAllocator)
+{
+    BOH_ASSERT(pAllocator);
+
+    bohAllocator allocatorInterface;
+
+    allocatorInterface.pAllocFunc = sizeClassInterfaceAlloc;
+    allocatorInterface.pReallocFunc = sizeClassInterfaceRealloc;
+    allocatorInterface.pFreeFunc = sizeClassInterfaceFree;
+    allocatorInterface.pUserData = pAllocator;
+
+    return allocatorInterface;
+}
+
+
+size_t bohSizeClassAllocatorGetAllocatedCount(const bohSizeClassAllocator* pAllocator)
+{
+    BOH_ASSERT(pAllocator);
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT; ++i) {
+        count += bohPoolAllocatorGetAllocatedCount(&pAllocator->pools[i]);
+    }
+
+    return count;
+}
+
+
+size_t bohSizeClassAllocatorGetCapacity(const bohSizeClassAllocator* pAllocator)
+{
+    BOH_ASSERT(pAllocator);
+
+    size_t capacity = 0;
+
+    for (size_t i = 0; i < BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT; ++i) {
+        capacity += bohPoolAllocatorGetCapacity(&pAllocator->pools[i]);
+    }
+
+    return capacity;
+}
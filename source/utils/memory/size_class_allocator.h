@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "utils/memory/memory.h"
+#include "utils/memory/pool_allocator.h"
+
+
+// Block sizes of the classes are BOH_SIZE_CLASS_ALLOCATOR_MIN_SIZE doubled per class: 32, 64, 128, 256
+#define BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT 4
+#define BOH_SIZE_CLASS_ALLOCATOR_MIN_SIZE      32
+#define BOH_SIZE_CLASS_ALLOCATOR_MAX_SIZE      (BOH_SIZE_CLASS_ALLOCATOR_MIN_SIZE << (BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT - 1))
+
+// Blocks are aligned as malloc ones, so the allocator may back bohMem* calls
+#define BOH_SIZE_CLASS_ALLOCATOR_ALIGNMENT 16
+
+
+// Small blocks allocator on top of a pool per size class: allocation pops a free list or bumps a slab offset,
+// free pushes the block back to its class list. Blocks larger than the biggest class go to the fallback allocator.
+// Sizes are required on realloc and free, it is what bohAllocator interface provides
+typedef struct SizeClassAllocator
+{
+    bohPoolAllocator pools[BOH_SIZE_CLASS_ALLOCATOR_CLASSES_COUNT];
+    const bohAllocator* pFallbackAllocator; // Current one at the creation
+} bohSizeClassAllocator;
+
+
+// Slab capacity is the elements count of every class slab, it is the heap growth step
+bohSizeClassAllocator bohSizeClassAllocatorCreate(size_t slabCapacity);
+void bohSizeClassAllocatorDestroy(bohSizeClassAllocator* pAllocator);
+
+void* bohSizeClassAllocatorAlloc(bohSizeClassAllocator* pAllocator, size_t size);
+void* bohSizeClassAllocatorRealloc(bohSizeClassAllocator* pAllocator, void* pMemory, size_t oldSize, size_t newSize);
+void bohSizeClassAllocatorFree(bohSizeClassAllocator* pAllocator, void* pMemory, size_t size);
+
+// Interface is bound to pAllocator address, so the allocator mustn't move while the interface is in use
+bohAllocator bohSizeClassAllocatorGetInterface(bohSizeClassAllocator* pAllocator);
+
+size_t bohSizeClassAllocatorGetAllocatedCount(const bohSizeClassAllocator* pAllocator);
+size_t bohSizeClassAllocatorGetCapacity(const bohSizeClassAllocator* pAllocator);
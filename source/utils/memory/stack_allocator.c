@@ -13,7 +13,7 @@ void bohStackAllocatorDestroy(bohStackAllocator* pAllocator)
 {
     BOH_ASSERT(pAllocator);    
 
-    free(pAllocator->pMemory);
+    bohMemFree(pAllocator->pMemory);
     pAllocator->pMemory = NULL;
     pAllocator->topOffset = 0;
     pAllocator->capacity = 0;
@@ -24,7 +24,7 @@ bohStackAllocator bohStackAllocatorCreate(size_t capacity, bohStackAllocatorType
 {
     bohStackAllocator allocator = {0};
     
-    allocator.pMemory = (uint8_t*)malloc(capacity);
+    allocator.pMemory = (uint8_t*)bohMemAlloc(capacity);
     BOH_ASSERT(allocator.pMemory);
 
     memset(allocator.pMemory, 0, capacity);
@@ -92,6 +92,49 @@ void bohStackAllocatorFree(bohStackAllocator* pAllocator, size_t size, size_t al
 }
 
 
+bool bohStackAllocatorCanAlloc(const bohStackAllocator* pAllocator, size_t size, size_t alignment)
+{
+    BOH_ASSERT(pAllocator);
+    BOH_ASSERT(pAllocator->pMemory);
+    BOH_ASSERT(alignment > 0);
+
+    const uintptr_t base = (uintptr_t)pAllocator->pMemory;
+
+    if (pAllocator->type == BOH_STACK_ALLOCATOR_TYPE_FORWARD) {
+        const uintptr_t aligned = (uintptr_t)BOH_ALIGN_UP(base + pAllocator->topOffset, alignment);
+        return aligned - base <= pAllocator->capacity && size <= pAllocator->capacity - (aligned - base);
+    } else {
+        if (size > pAllocator->topOffset) {
+            return false;
+        }
+
+        return (uintptr_t)BOH_ALIGN_DOWN(base + pAllocator->topOffset - size, alignment) >= base;
+    }
+}
+
+
+size_t bohStackAllocatorGetMarker(const bohStackAllocator* pAllocator)
+{
+    BOH_ASSERT(pAllocator);
+    return pAllocator->topOffset;
+}
+
+
+void bohStackAllocatorFreeToMarker(bohStackAllocator* pAllocator, size_t marker)
+{
+    BOH_ASSERT(pAllocator);
+    BOH_ASSERT(marker <= pAllocator->capacity);
+
+    if (pAllocator->type == BOH_STACK_ALLOCATOR_TYPE_FORWARD) {
+        BOH_ASSERT_MSG(marker <= pAllocator->topOffset, "Marker is above the stack top");
+    } else {
+        BOH_ASSERT_MSG(marker >= pAllocator->topOffset, "Marker is below the stack top");
+    }
+
+    pAllocator->topOffset = marker;
+}
+
+
 size_t bohStackAllocatorGetCapacity(const bohStackAllocator* pAllocator)
 {
     BOH_ASSERT(pAllocator);
@@ -28,6 +28,12 @@ bohStackAllocator bohStackAllocatorCreate(size_t capacity, bohStackAllocatorType
 void* bohStackAllocatorAlloc(bohStackAllocator* allocator, size_t size, size_t alignment);
 void bohStackAllocatorFree(bohStackAllocator* allocator, size_t size, size_t alignment);
 
+bool bohStackAllocatorCanAlloc(const bohStackAllocator* pAllocator, size_t size, size_t alignment);
+
+// Marker is the current top, freeing to it releases everything allocated after the marker was taken
+size_t bohStackAllocatorGetMarker(const bohStackAllocator* pAllocator);
+void bohStackAllocatorFreeToMarker(bohStackAllocator* pAllocator, size_t marker);
+
 size_t bohStackAllocatorGetCapacity(const bohStackAllocator* pAllocator);
 
 bool bohStackAllocatorIsForward(const bohStackAllocator* pAllocator);
@@ -35,3 +41,6 @@ bool bohStackAllocatorIsForward(const bohStackAllocator* pAllocator);
 
 #define BOH_STACK_ALLOCATOR_ALLOC(STACK_ALLOC_PTR, TYPE) (TYPE*)bohStackAllocatorAlloc(STACK_ALLOC_PTR, sizeof(TYPE), _Alignof(TYPE))
 #define BOH_STACK_ALLOCATOR_FREE(STACK_ALLOC_PTR, TYPE) bohStackAllocatorFree(STACK_ALLOC_PTR, sizeof(TYPE), _Alignof(TYPE))
+
+#define BOH_STACK_ALLOCATOR_ALLOC_ARRAY(STACK_ALLOC_PTR, TYPE, COUNT) (TYPE*)bohStackAllocatorAlloc(STACK_ALLOC_PTR, sizeof(TYPE) * (COUNT), _Alignof(TYPE))
+#define BOH_STACK_ALLOCATOR_CAN_ALLOC_ARRAY(STACK_ALLOC_PTR, TYPE, COUNT) bohStackAllocatorCanAlloc(STACK_ALLOC_PTR, sizeof(TYPE) * (COUNT), _Alignof(TYPE))
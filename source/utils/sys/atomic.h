@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+
+
+// Minimal set of atomic operations on 64 bit values. MSVC C compiler has no usable <stdatomic.h>, 
+// so interlocked intrinsics are used there (they are full barriers, which is stronger than required)
+
+#define BOH_CACHE_LINE_SIZE 64
+
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+
+    #define BOH_ATOMIC_LOAD_ACQUIRE_U64(PTR)            ((uint64_t)_InterlockedOr64((volatile long long*)(PTR), 0))
+    #define BOH_ATOMIC_STORE_RELEASE_U64(PTR, VALUE)    ((void)_InterlockedExchange64((volatile long long*)(PTR), (long long)(VALUE)))
+    #define BOH_ATOMIC_LOAD_SEQ_CST_U64(PTR)            BOH_ATOMIC_LOAD_ACQUIRE_U64(PTR)
+    #define BOH_ATOMIC_STORE_SEQ_CST_U64(PTR, VALUE)    BOH_ATOMIC_STORE_RELEASE_U64(PTR, VALUE)
+#else
+    #define BOH_ATOMIC_LOAD_ACQUIRE_U64(PTR)            __atomic_load_n((PTR), __ATOMIC_ACQUIRE)
+    #define BOH_ATOMIC_STORE_RELEASE_U64(PTR, VALUE)    __atomic_store_n((PTR), (uint64_t)(VALUE), __ATOMIC_RELEASE)
+    #define BOH_ATOMIC_LOAD_SEQ_CST_U64(PTR)            __atomic_load_n((PTR), __ATOMIC_SEQ_CST)
+    #define BOH_ATOMIC_STORE_SEQ_CST_U64(PTR, VALUE)    __atomic_store_n((PTR), (uint64_t)(VALUE), __ATOMIC_SEQ_CST)
+#endif
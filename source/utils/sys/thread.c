@@ -0,0 +1,200 @@
+#include "pch.h"
+
+#include "core.h"
+
+#include "thread.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <process.h>
+#else
+    #include <pthread.h>
+#endif
+
+
+#if defined(_WIN32)
+static unsigned int __stdcall threadStart(void* pThreadObject)
+#else
+static void* threadStart(void* pThreadObject)
+#endif
+{
+    // Nothing is allocated here, since memory stats are not thread safe
+    const bohThread* pThread = (const bohThread*)pThreadObject;
+    const int result = pThread->pFunc(pThread->pArg);
+
+#if defined(_WIN32)
+    return (unsigned int)result;
+#else
+    return (void*)(intptr_t)result;
+#endif
+}
+
+
+bool bohThreadCreateInPlace(bohThread* pThread, bohThreadFunc pFunc, void* pArg)
+{
+    BOH_ASSERT(pThread);
+    BOH_ASSERT(pFunc);
+
+    pThread->pHandle = NULL;
+    pThread->pFunc = pFunc;
+    pThread->pArg = pArg;
+
+#if defined(_WIN32)
+    const uintptr_t handle = _beginthreadex(NULL, 0, threadStart, pThread, 0, NULL);
+    
+    if (handle == 0) {
+        return false;
+    }
+
+    pThread->pHandle = (void*)handle;
+#else
+    pthread_t* pHandle = (pthread_t*)bohMemAlloc(sizeof(pthread_t));
+    BOH_ASSERT(pHandle);
+
+    if (pthread_create(pHandle, NULL, threadStart, pThread) != 0) {
+        bohMemFree(pHandle);
+        return false;
+    }
+
+    pThread->pHandle = pHandle;
+#endif
+
+    return true;
+}
+
+
+void bohThreadJoin(bohThread* pThread)
+{
+    BOH_ASSERT(pThread);
+    BOH_ASSERT(pThread->pHandle);
+
+#if defined(_WIN32)
+    WaitForSingleObject((HANDLE)pThread->pHandle, INFINITE);
+    CloseHandle((HANDLE)pThread->pHandle);
+#else
+    pthread_join(*(pthread_t*)pThread->pHandle, NULL);
+    bohMemFree(pThread->pHandle);
+#endif
+
+    pThread->pHandle = NULL;
+}
+
+
+void bohMutexCreateInPlace(bohMutex* pMutex)
+{
+    BOH_ASSERT(pMutex);
+
+#if defined(_WIN32)
+    pMutex->pHandle = bohMemAlloc(sizeof(SRWLOCK));
+    BOH_ASSERT(pMutex->pHandle);
+
+    InitializeSRWLock((PSRWLOCK)pMutex->pHandle);
+#else
+    pMutex->pHandle = bohMemAlloc(sizeof(pthread_mutex_t));
+    BOH_ASSERT(pMutex->pHandle);
+
+    pthread_mutex_init((pthread_mutex_t*)pMutex->pHandle, NULL);
+#endif
+}
+
+
+void bohMutexDestroy(bohMutex* pMutex)
+{
+    BOH_ASSERT(pMutex);
+
+    if (!pMutex->pHandle) {
+        return;
+    }
+
+#if !defined(_WIN32)
+    pthread_mutex_destroy((pthread_mutex_t*)pMutex->pHandle);
+#endif
+
+    bohMemFree(pMutex->pHandle);
+    pMutex->pHandle = NULL;
+}
+
+
+void bohMutexLock(bohMutex* pMutex)
+{
+    BOH_ASSERT(pMutex && pMutex->pHandle);
+
+#if defined(_WIN32)
+    AcquireSRWLockExclusive((PSRWLOCK)pMutex->pHandle);
+#else
+    pthread_mutex_lock((pthread_mutex_t*)pMutex->pHandle);
+#endif
+}
+
+
+void bohMutexUnlock(bohMutex* pMutex)
+{
+    BOH_ASSERT(pMutex && pMutex->pHandle);
+
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive((PSRWLOCK)pMutex->pHandle);
+#else
+    pthread_mutex_unlock((pthread_mutex_t*)pMutex->pHandle);
+#endif
+}
+
+
+void bohCondVarCreateInPlace(bohCondVar* pCondVar)
+{
+    BOH_ASSERT(pCondVar);
+
+#if defined(_WIN32)
+    pCondVar->pHandle = bohMemAlloc(sizeof(CONDITION_VARIABLE));
+    BOH_ASSERT(pCondVar->pHandle);
+
+    InitializeConditionVariable((PCONDITION_VARIABLE)pCondVar->pHandle);
+#else
+    pCondVar->pHandle = bohMemAlloc(sizeof(pthread_cond_t));
+    BOH_ASSERT(pCondVar->pHandle);
+
+    pthread_cond_init((pthread_cond_t*)pCondVar->pHandle, NULL);
+#endif
+}
+
+
+void bohCondVarDestroy(bohCondVar* pCondVar)
+{
+    BOH_ASSERT(pCondVar);
+
+    if (!pCondVar->pHandle) {
+        return;
+    }
+
+#if !defined(_WIN32)
+    pthread_cond_destroy((pthread_cond_t*)pCondVar->pHandle);
+#endif
+
+    bohMemFree(pCondVar->pHandle);
+    pCondVar->pHandle = NULL;
+}
+
+
+void bohCondVarWait(bohCondVar* pCondVar, bohMutex* pMutex)
+{
+    BOH_ASSERT(pCondVar && pCondVar->pHandle);
+    BOH_ASSERT(pMutex && pMutex->pHandle);
+
+#if defined(_WIN32)
+    SleepConditionVariableSRW((PCONDITION_VARIABLE)pCondVar->pHandle, (PSRWLOCK)pMutex->pHandle, INFINITE, 0);
+#else
+    pthread_cond_wait((pthread_cond_t*)pCondVar->pHandle, (pthread_mutex_t*)pMutex->pHandle);
+#endif
+}
+
+
+void bohCondVarSignal(bohCondVar* pCondVar)
+{
+    BOH_ASSERT(pCondVar && pCondVar->pHandle);
+
+#if defined(_WIN32)
+    WakeConditionVariable((PCONDITION_VARIABLE)pCondVar->pHandle);
+#else
+    pthread_cond_signal((pthread_cond_t*)pCondVar->pHandle);
+#endif
+}
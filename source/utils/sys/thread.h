@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdbool.h>
+
+
+// Thin wrappers over Win32 and pthreads primitives. Handles are stored as opaque storage, 
+// so platform headers don't leak into the rest of the code
+
+typedef int (*bohThreadFunc)(void* pArg);
+
+
+// Thread object is passed to the started thread, so it must not be moved until joined
+typedef struct Thread
+{
+    void* pHandle;
+
+    bohThreadFunc pFunc;
+    void* pArg;
+} bohThread;
+
+
+// Returns false if the thread could not be started
+bool bohThreadCreateInPlace(bohThread* pThread, bohThreadFunc pFunc, void* pArg);
+void bohThreadJoin(bohThread* pThread);
+
+
+typedef struct Mutex
+{
+    void* pHandle;
+} bohMutex;
+
+
+void bohMutexCreateInPlace(bohMutex* pMutex);
+void bohMutexDestroy(bohMutex* pMutex);
+
+void bohMutexLock(bohMutex* pMutex);
+void bohMutexUnlock(bohMutex* pMutex);
+
+
+typedef struct CondVar
+{
+    void* pHandle;
+} bohCondVar;
+
+
+void bohCondVarCreateInPlace(bohCondVar* pCondVar);
+void bohCondVarDestroy(bohCondVar* pCondVar);
+
+// Mutex must be locked by the caller. Spurious wakeups are possible
+void bohCondVarWait(bohCondVar* pCondVar, bohMutex* pMutex);
+void bohCondVarSignal(bohCondVar* pCondVar);
@@ -0,0 +1,63 @@
+#include "pch.h"
+
+#include "core.h"
+
+#include "timer.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+
+#if defined(_WIN32)
+static uint64_t timeFileTimeToNs(const FILETIME* pFileTime)
+{
+    const uint64_t ticks = ((uint64_t)pFileTime->dwHighDateTime << 32) | pFileTime->dwLowDateTime;
+    return ticks * 100; // FILETIME is measured in 100 ns intervals
+}
+#endif
+
+
+uint64_t bohTimeGetWallNs(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency = {0};
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    const uint64_t seconds = (uint64_t)(counter.QuadPart / frequency.QuadPart);
+    const uint64_t remainder = (uint64_t)(counter.QuadPart % frequency.QuadPart);
+
+    return seconds * 1000000000ull + remainder * 1000000000ull / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+#endif
+}
+
+
+uint64_t bohTimeGetCpuNs(void)
+{
+#if defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+
+    return timeFileTimeToNs(&kernelTime) + timeFileTimeToNs(&userTime);
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+    
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+#endif
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdint.h>
+
+
+// Monotonic wall clock time in nanoseconds
+uint64_t bohTimeGetWallNs(void);
+
+// CPU time consumed by the process in nanoseconds
+uint64_t bohTimeGetCpuNs(void);
@@ -0,0 +1,77 @@
+# Runs a script with the interpreter and checks the exit code and the output, used by CTest in script mode:
+# cmake -DBOHARES=<interpreter> -DSCRIPT=<script.boh> [-DARGS=<options list>] -P run_script.cmake
+#
+# Expected exit code is the one main returns, it is set by a "# exit code: <n>" first line of the script, 0 by default.
+# Extra interpreter options for a single script are set by a "# args: <options>" line in its leading comments.
+# Expected stdout is <script name>.out next to the script, stdout isn't checked if there is no such file.
+# Expected combined stdout and stderr in write order is <script name>.log next to the script, checked when the file exists
+
+if (NOT BOHARES OR NOT SCRIPT)
+    message(FATAL_ERROR "BOHARES and SCRIPT must be set")
+endif()
+
+set(EXPECTED_EXIT_CODE 0)
+file(STRINGS ${SCRIPT} FIRST_LINE LIMIT_COUNT 1)
+
+if (FIRST_LINE MATCHES "^# exit code: (-?[0-9]+)")
+    set(EXPECTED_EXIT_CODE ${CMAKE_MATCH_1})
+endif()
+
+file(STRINGS ${SCRIPT} HEADER_LINES LIMIT_COUNT 8 REGEX "^# args: ")
+
+foreach (HEADER_LINE IN LISTS HEADER_LINES)
+    string(REGEX REPLACE "^# args: " "" SCRIPT_ARGS "${HEADER_LINE}")
+    separate_arguments(SCRIPT_ARGS)
+    list(APPEND ARGS ${SCRIPT_ARGS})
+endforeach()
+
+get_filename_component(SCRIPT_DIR ${SCRIPT} DIRECTORY)
+get_filename_component(SCRIPT_FILE_NAME ${SCRIPT} NAME)
+get_filename_component(SCRIPT_NAME ${SCRIPT} NAME_WE)
+set(EXPECTED_OUTPUT_FILE ${SCRIPT_DIR}/${SCRIPT_NAME}.out)
+set(EXPECTED_LOG_FILE ${SCRIPT_DIR}/${SCRIPT_NAME}.log)
+
+# The script is passed by its file name, so diagnostics don't depend on where the tree is checked out
+execute_process(
+    COMMAND ${BOHARES} ${ARGS} ${SCRIPT_FILE_NAME}
+    WORKING_DIRECTORY ${SCRIPT_DIR}
+    RESULT_VARIABLE EXIT_CODE
+    OUTPUT_VARIABLE OUTPUT
+    ERROR_VARIABLE ERROR_OUTPUT)
+
+# Negative codes of main come back as 8-bit unsigned ones on POSIX
+if (EXIT_CODE MATCHES "^[0-9]+$" AND EXIT_CODE GREATER 127)
+    math(EXPR EXIT_CODE "${EXIT_CODE} - 256")
+endif()
+
+if (NOT EXIT_CODE STREQUAL EXPECTED_EXIT_CODE)
+    message(FATAL_ERROR "${SCRIPT}: exit code ${EXIT_CODE}, expected ${EXPECTED_EXIT_CODE}\n${ERROR_OUTPUT}")
+endif()
+
+if (EXISTS ${EXPECTED_OUTPUT_FILE})
+    file(READ ${EXPECTED_OUTPUT_FILE} EXPECTED_OUTPUT)
+
+    if (NOT OUTPUT STREQUAL EXPECTED_OUTPUT)
+        message(FATAL_ERROR "${SCRIPT}: output mismatch\n--- expected:\n${EXPECTED_OUTPUT}\n--- actual:\n${OUTPUT}")
+    endif()
+endif()
+
+if (EXISTS ${EXPECTED_LOG_FILE})
+    # Both streams share one file, so it keeps the order the interpreter wrote them in
+    string(MAKE_C_IDENTIFIER "${SCRIPT}" LOG_ID)
+    set(ACTUAL_LOG_FILE ${CMAKE_CURRENT_BINARY_DIR}/${LOG_ID}.log)
+
+    execute_process(
+        COMMAND ${BOHARES} ${ARGS} ${SCRIPT_FILE_NAME}
+        WORKING_DIRECTORY ${SCRIPT_DIR}
+        OUTPUT_FILE ${ACTUAL_LOG_FILE}
+        ERROR_FILE ${ACTUAL_LOG_FILE})
+
+    file(READ ${EXPECTED_LOG_FILE} EXPECTED_LOG)
+    file(READ ${ACTUAL_LOG_FILE} ACTUAL_LOG)
+    file(REMOVE ${ACTUAL_LOG_FILE})
+
+    if (NOT ACTUAL_LOG STREQUAL EXPECTED_LOG)
+        message(FATAL_ERROR "${SCRIPT}: combined output mismatch\n--- expected:\n${EXPECTED_LOG}\n--- actual:\n${ACTUAL_LOG}")
+    endif()
+endif()